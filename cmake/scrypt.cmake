@@ -1,7 +1,9 @@
 set(TARGET_NAME scrypt)
 
 file(GLOB SOURCE_CODE
-    "${PROJECT_SOURCE_DIR}/deps/scrypt/crypto_scrypt-ref.cpp"
+    "${PROJECT_SOURCE_DIR}/deps/scrypt/crypto_scrypt.cpp"
+	"${PROJECT_SOURCE_DIR}/deps/scrypt/crypto_scrypt-ref.cpp"
+	"${PROJECT_SOURCE_DIR}/deps/scrypt/crypto_scrypt_smix_sse2.cpp"
 	"${PROJECT_SOURCE_DIR}/deps/scrypt/sha256.cpp"
 )
 
@@ -36,14 +36,13 @@
 #include "sha256.h"
 #include "sysendian.h"
 
-#include "crypto_scrypt.h"
+#include "crypto_scrypt_smix.h"
 
 static void blkcpy(uint8_t *, uint8_t *, size_t);
 static void blkxor(uint8_t *, uint8_t *, size_t);
 static void salsa20_8(uint8_t[64]);
 static void blockmix_salsa8(uint8_t *, uint8_t *, size_t);
 static uint64_t integerify(uint8_t *, size_t);
-static void smix(uint8_t *, size_t, uint64_t, uint8_t *, uint8_t *);
 
 static void
 blkcpy(uint8_t * dest, uint8_t * src, size_t len)
@@ -164,13 +163,13 @@ integerify(uint8_t * B, size_t r)
 }
 
 /**
-* smix(B, r, N, V, XY):
+* crypto_scrypt_smix(B, r, N, V, XY):
 * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length; the
 * temporary storage V must be 128rN bytes in length; the temporary storage
 * XY must be 256r bytes in length.  The value N must be a power of 2.
 */
-static void
-smix(uint8_t * B, size_t r, uint64_t N, uint8_t * V, uint8_t * XY)
+void
+crypto_scrypt_smix(uint8_t * B, size_t r, uint64_t N, uint8_t * V, uint8_t * XY)
 {
 	uint8_t * X = XY;
 	uint8_t * Y = &XY[128 * r];
@@ -202,83 +201,3 @@ smix(uint8_t * B, size_t r, uint64_t N, uint8_t * V, uint8_t * XY)
 	/* 10: B' <-- X */
 	blkcpy(B, X, 128 * r);
 }
-
-/**
-* crypto_scrypt(passwd, passwdlen, salt, saltlen, N, r, p, buf, buflen):
-* Compute scrypt(passwd[0 .. passwdlen - 1], salt[0 .. saltlen - 1], N, r,
-* p, buflen) and write the result into buf.  The parameters r, p, and buflen
-* must satisfy r * p < 2^30 and buflen <= (2^32 - 1) * 32.  The parameter N
-* must be a power of 2.
-*
-* Return 0 on success; or -1 on error.
-*/
-int
-crypto_scrypt(const uint8_t * passwd, size_t passwdlen,
-	const uint8_t * salt, size_t saltlen, uint64_t N, uint32_t r, uint32_t p,
-	uint8_t * buf, size_t buflen)
-{
-	uint8_t * B;
-	uint8_t * V;
-	uint8_t * XY;
-	uint32_t i;
-
-	/* Sanity-check parameters. */
-#if SIZE_MAX > UINT32_MAX
-	if (buflen > (((uint64_t)(1) << 32) - 1) * 32) {
-		errno = EFBIG;
-		goto err0;
-	}
-#endif
-	if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
-		errno = EFBIG;
-		goto err0;
-	}
-	if (((N & (N - 1)) != 0) || (N == 0)) {
-		errno = EINVAL;
-		goto err0;
-	}
-	if ((r > SIZE_MAX / 128 / p) ||
-#if SIZE_MAX / 256 <= UINT32_MAX
-	(r > SIZE_MAX / 256) ||
-#endif
-		(N > SIZE_MAX / 128 / r)) {
-		errno = ENOMEM;
-		goto err0;
-	}
-
-	/* Allocate memory. */
-	if ((B = (uint8_t*)malloc(128 * r * p)) == NULL)
-		goto err0;
-	if ((XY = (uint8_t*)malloc(256 * r)) == NULL)
-		goto err1;
-	if ((V = (uint8_t*)malloc(128 * r * N)) == NULL)
-		goto err2;
-
-	/* 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen) */
-	PBKDF2_SHA256(passwd, passwdlen, salt, saltlen, 1, B, p * 128 * r);
-
-	/* 2: for i = 0 to p - 1 do */
-	for (i = 0; i < p; i++) {
-		/* 3: B_i <-- MF(B_i, N) */
-		smix(&B[i * 128 * r], r, N, V, XY);
-	}
-
-	/* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
-	PBKDF2_SHA256(passwd, passwdlen, B, p * 128 * r, 1, buf, buflen);
-
-	/* Free memory. */
-	free(V);
-	free(XY);
-	free(B);
-
-	/* Success! */
-	return (0);
-
-err2:
-	free(XY);
-err1:
-	free(B);
-err0:
-	/* Failure! */
-	return (-1);
-}
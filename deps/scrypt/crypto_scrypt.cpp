@@ -0,0 +1,189 @@
+/*-
+* Copyright 2009 Colin Percival
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+* 1. Redistributions of source code must retain the above copyright
+*    notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright
+*    notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+* SUCH DAMAGE.
+*
+* This file was originally written by Colin Percival as part of the Tarsnap
+* online backup system.
+*/
+#include "scrypt_platform.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "sha256.h"
+
+#include "crypto_scrypt_smix.h"
+#include "crypto_scrypt.h"
+
+/**
+* smix_lanes(B, r, N, p, first, step, use_sse2):
+* Compute B_i = MF(B_i, N) for i = first, first + step, ... up to p - 1,
+* using one set of temporary storage for all of them.
+*
+* Return 0 on success; or -1 on error.
+*/
+static int
+smix_lanes(uint8_t * B, size_t r, uint64_t N, uint32_t p, uint32_t first,
+	uint32_t step, int use_sse2)
+{
+	void * V0;
+	void * XY0;
+	uint8_t * V;
+	uint8_t * XY;
+	uint32_t i;
+
+	/* Allocate memory, aligned to 64 bytes for the SSE2 implementation. */
+	if ((XY0 = malloc(256 * r + 63)) == NULL)
+		goto err0;
+	XY = (uint8_t *)(((uintptr_t)(XY0) + 63) & ~(uintptr_t)(63));
+	if ((V0 = malloc(128 * r * N + 63)) == NULL)
+		goto err1;
+	V = (uint8_t *)(((uintptr_t)(V0) + 63) & ~(uintptr_t)(63));
+
+	/* 2: for i = 0 to p - 1 do */
+	for (i = first; i < p; i += step) {
+		/* 3: B_i <-- MF(B_i, N) */
+		if (use_sse2)
+			crypto_scrypt_smix_sse2(&B[i * 128 * r], r, N, V, XY);
+		else
+			crypto_scrypt_smix(&B[i * 128 * r], r, N, V, XY);
+	}
+
+	/* Free memory. */
+	free(V0);
+	free(XY0);
+
+	/* Success! */
+	return (0);
+
+err1:
+	free(XY0);
+err0:
+	/* Failure! */
+	return (-1);
+}
+
+/**
+* crypto_scrypt(passwd, passwdlen, salt, saltlen, N, r, p, buf, buflen):
+* Compute scrypt(passwd[0 .. passwdlen - 1], salt[0 .. saltlen - 1], N, r,
+* p, buflen) and write the result into buf.  The parameters r, p, and buflen
+* must satisfy r * p < 2^30 and buflen <= (2^32 - 1) * 32.  The parameter N
+* must be a power of 2.
+*
+* The SSE2 implementation of SMix is used when the CPU supports it, and the
+* p independent SMix lanes are split across threads, each with its own 128rN
+* bytes of temporary storage.
+*
+* Return 0 on success; or -1 on error.
+*/
+int
+crypto_scrypt(const uint8_t * passwd, size_t passwdlen,
+	const uint8_t * salt, size_t saltlen, uint64_t N, uint32_t r, uint32_t p,
+	uint8_t * buf, size_t buflen)
+{
+	uint8_t * B;
+	int use_sse2;
+	uint32_t num_threads;
+	uint32_t i;
+	int result;
+
+	/* Sanity-check parameters. */
+#if SIZE_MAX > UINT32_MAX
+	if (buflen > (((uint64_t)(1) << 32) - 1) * 32) {
+		errno = EFBIG;
+		goto err0;
+	}
+#endif
+	if ((uint64_t)(r) * (uint64_t)(p) >= (1 << 30)) {
+		errno = EFBIG;
+		goto err0;
+	}
+	if (((N & (N - 1)) != 0) || (N == 0)) {
+		errno = EINVAL;
+		goto err0;
+	}
+	if ((r > SIZE_MAX / 128 / p) ||
+#if SIZE_MAX / 256 <= UINT32_MAX
+	(r > SIZE_MAX / 256) ||
+#endif
+		(N > SIZE_MAX / 128 / r)) {
+		errno = ENOMEM;
+		goto err0;
+	}
+
+	/* The SSE2 implementation handles two iterations at a time. */
+	use_sse2 = (N >= 2) && crypto_scrypt_smix_sse2_supported();
+
+	/* Allocate memory. */
+	if ((B = (uint8_t*)malloc(128 * r * p)) == NULL)
+		goto err0;
+
+	/* 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen) */
+	PBKDF2_SHA256(passwd, passwdlen, salt, saltlen, 1, B, p * 128 * r);
+
+	/* 2: for i = 0 to p - 1 do */
+	num_threads = (std::min)(p, (std::max)(std::thread::hardware_concurrency(), 1u));
+	if (num_threads > 1) {
+		std::vector<int> results(num_threads, 0);
+		std::vector<std::thread> threads;
+		for (i = 1; i < num_threads; i++) {
+			threads.push_back(std::thread([&results, B, r, N, p, i, num_threads, use_sse2] {
+				results[i] = smix_lanes(B, r, N, p, i, num_threads, use_sse2);
+			}));
+		}
+
+		results[0] = smix_lanes(B, r, N, p, 0, num_threads, use_sse2);
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		result = *std::min_element(results.begin(), results.end());
+	} else {
+		result = smix_lanes(B, r, N, p, 0, 1, use_sse2);
+	}
+
+	if (result != 0)
+		goto err1;
+
+	/* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
+	PBKDF2_SHA256(passwd, passwdlen, B, p * 128 * r, 1, buf, buflen);
+
+	/* Free memory. */
+	free(B);
+
+	/* Success! */
+	return (0);
+
+err1:
+	free(B);
+err0:
+	/* Failure! */
+	return (-1);
+}
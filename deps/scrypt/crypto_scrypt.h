@@ -29,6 +29,7 @@
 #ifndef _CRYPTO_SCRYPT_H_
 #define _CRYPTO_SCRYPT_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -0,0 +1,34 @@
+#ifndef _CRYPTO_SCRYPT_SMIX_H_
+#define _CRYPTO_SCRYPT_SMIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* crypto_scrypt_smix(B, r, N, V, XY):
+* Compute B = SMix_r(B, N).  The input B must be 128r bytes in length; the
+* temporary storage V must be 128rN bytes in length; the temporary storage
+* XY must be 256r bytes in length.  The value N must be a power of 2.
+* This is the portable reference implementation.
+*/
+void crypto_scrypt_smix(uint8_t *, size_t, uint64_t, uint8_t *, uint8_t *);
+
+/**
+* crypto_scrypt_smix_sse2(B, r, N, V, XY):
+* Compute B = SMix_r(B, N), using SSE2.  The input B must be 128r bytes in
+* length; the temporary storage V must be 128rN bytes in length; the
+* temporary storage XY must be 256r bytes in length.  The value N must be
+* a power of 2 greater than 1.  The arrays V and XY must be aligned to a
+* multiple of 64 bytes.
+*
+* Only call this if crypto_scrypt_smix_sse2_supported() returns nonzero.
+*/
+void crypto_scrypt_smix_sse2(uint8_t *, size_t, uint64_t, void *, void *);
+
+/**
+* crypto_scrypt_smix_sse2_supported():
+* Return nonzero if this build and CPU can run crypto_scrypt_smix_sse2.
+*/
+int crypto_scrypt_smix_sse2_supported(void);
+
+#endif /* !_CRYPTO_SCRYPT_SMIX_H_ */
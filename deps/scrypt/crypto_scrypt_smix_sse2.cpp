@@ -0,0 +1,339 @@
+/*-
+* Copyright 2009 Colin Percival
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+* 1. Redistributions of source code must retain the above copyright
+*    notice, this list of conditions and the following disclaimer.
+* 2. Redistributions in binary form must reproduce the above copyright
+*    notice, this list of conditions and the following disclaimer in the
+*    documentation and/or other materials provided with the distribution.
+*
+* THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+* OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+* OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+* SUCH DAMAGE.
+*
+* This file was originally written by Colin Percival as part of the Tarsnap
+* online backup system.
+*/
+#include "scrypt_platform.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sysendian.h"
+
+#include "crypto_scrypt_smix.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SCRYPT_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(SCRYPT_SSE2)
+
+/* 32-bit x86 builds don't enable SSE2 by default, so the functions using it are marked instead. */
+#if defined(__GNUC__) && !defined(__SSE2__)
+#define SCRYPT_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SCRYPT_TARGET_SSE2
+#endif
+
+SCRYPT_TARGET_SSE2 static void blkcpy(void *, const void *, size_t);
+SCRYPT_TARGET_SSE2 static void salsa20_8(__m128i &, __m128i &, __m128i &, __m128i &);
+SCRYPT_TARGET_SSE2 static void blockmix_salsa8(const __m128i *, __m128i *, size_t);
+SCRYPT_TARGET_SSE2 static void blockmix_salsa8_xor(const __m128i *, const __m128i *, __m128i *, size_t);
+static uint64_t integerify(const void *, size_t);
+
+SCRYPT_TARGET_SSE2 static void
+blkcpy(void * dest, const void * src, size_t len)
+{
+	__m128i * D = (__m128i *)dest;
+	const __m128i * S = (const __m128i *)src;
+	size_t L = len / 16;
+	size_t i;
+
+	for (i = 0; i < L; i++)
+		D[i] = S[i];
+}
+
+/**
+* salsa20_8(B0, B1, B2, B3):
+* Apply the salsa20/8 core to the provided block.  The block is stored in
+* the shuffled order used by crypto_scrypt_smix_sse2, so that each 128-bit
+* register holds one diagonal of the 4x4 matrix.
+*/
+SCRYPT_TARGET_SSE2 static inline void
+salsa20_8(__m128i & B0, __m128i & B1, __m128i & B2, __m128i & B3)
+{
+	__m128i X0, X1, X2, X3;
+	__m128i T;
+	size_t i;
+
+	X0 = B0;
+	X1 = B1;
+	X2 = B2;
+	X3 = B3;
+
+	for (i = 0; i < 8; i += 2) {
+		/* Operate on "columns". */
+		T = _mm_add_epi32(X0, X3);
+		X1 = _mm_xor_si128(X1, _mm_slli_epi32(T, 7));
+		X1 = _mm_xor_si128(X1, _mm_srli_epi32(T, 25));
+		T = _mm_add_epi32(X1, X0);
+		X2 = _mm_xor_si128(X2, _mm_slli_epi32(T, 9));
+		X2 = _mm_xor_si128(X2, _mm_srli_epi32(T, 23));
+		T = _mm_add_epi32(X2, X1);
+		X3 = _mm_xor_si128(X3, _mm_slli_epi32(T, 13));
+		X3 = _mm_xor_si128(X3, _mm_srli_epi32(T, 19));
+		T = _mm_add_epi32(X3, X2);
+		X0 = _mm_xor_si128(X0, _mm_slli_epi32(T, 18));
+		X0 = _mm_xor_si128(X0, _mm_srli_epi32(T, 14));
+
+		/* Rearrange data. */
+		X1 = _mm_shuffle_epi32(X1, 0x93);
+		X2 = _mm_shuffle_epi32(X2, 0x4E);
+		X3 = _mm_shuffle_epi32(X3, 0x39);
+
+		/* Operate on "rows". */
+		T = _mm_add_epi32(X0, X1);
+		X3 = _mm_xor_si128(X3, _mm_slli_epi32(T, 7));
+		X3 = _mm_xor_si128(X3, _mm_srli_epi32(T, 25));
+		T = _mm_add_epi32(X3, X0);
+		X2 = _mm_xor_si128(X2, _mm_slli_epi32(T, 9));
+		X2 = _mm_xor_si128(X2, _mm_srli_epi32(T, 23));
+		T = _mm_add_epi32(X2, X3);
+		X1 = _mm_xor_si128(X1, _mm_slli_epi32(T, 13));
+		X1 = _mm_xor_si128(X1, _mm_srli_epi32(T, 19));
+		T = _mm_add_epi32(X1, X2);
+		X0 = _mm_xor_si128(X0, _mm_slli_epi32(T, 18));
+		X0 = _mm_xor_si128(X0, _mm_srli_epi32(T, 14));
+
+		/* Rearrange data. */
+		X1 = _mm_shuffle_epi32(X1, 0x39);
+		X2 = _mm_shuffle_epi32(X2, 0x4E);
+		X3 = _mm_shuffle_epi32(X3, 0x93);
+	}
+
+	B0 = _mm_add_epi32(B0, X0);
+	B1 = _mm_add_epi32(B1, X1);
+	B2 = _mm_add_epi32(B2, X2);
+	B3 = _mm_add_epi32(B3, X3);
+}
+
+/**
+* blockmix_salsa8(Bin, Bout, r):
+* Compute Bout = BlockMix_{salsa20/8, r}(Bin).  The input Bin must be 128r
+* bytes in length; the output Bout must also be the same size.  The running
+* block X is kept in registers.
+*/
+SCRYPT_TARGET_SSE2 static void
+blockmix_salsa8(const __m128i * Bin, __m128i * Bout, size_t r)
+{
+	__m128i X0, X1, X2, X3;
+	size_t i;
+
+	/* 1: X <-- B_{2r - 1} */
+	X0 = Bin[8 * r - 4];
+	X1 = Bin[8 * r - 3];
+	X2 = Bin[8 * r - 2];
+	X3 = Bin[8 * r - 1];
+
+	/* 2: for i = 0 to 2r - 1 do */
+	for (i = 0; i < r; i++) {
+		/* 3: X <-- H(X \xor B_i) */
+		X0 = _mm_xor_si128(X0, Bin[i * 8 + 0]);
+		X1 = _mm_xor_si128(X1, Bin[i * 8 + 1]);
+		X2 = _mm_xor_si128(X2, Bin[i * 8 + 2]);
+		X3 = _mm_xor_si128(X3, Bin[i * 8 + 3]);
+		salsa20_8(X0, X1, X2, X3);
+
+		/* 4: Y_i <-- X */
+		/* 6: B'_{i/2} <-- X */
+		Bout[i * 4 + 0] = X0;
+		Bout[i * 4 + 1] = X1;
+		Bout[i * 4 + 2] = X2;
+		Bout[i * 4 + 3] = X3;
+
+		/* 3: X <-- H(X \xor B_i) */
+		X0 = _mm_xor_si128(X0, Bin[i * 8 + 4]);
+		X1 = _mm_xor_si128(X1, Bin[i * 8 + 5]);
+		X2 = _mm_xor_si128(X2, Bin[i * 8 + 6]);
+		X3 = _mm_xor_si128(X3, Bin[i * 8 + 7]);
+		salsa20_8(X0, X1, X2, X3);
+
+		/* 4: Y_i <-- X */
+		/* 6: B'_{r + (i - 1)/2} <-- X */
+		Bout[(r + i) * 4 + 0] = X0;
+		Bout[(r + i) * 4 + 1] = X1;
+		Bout[(r + i) * 4 + 2] = X2;
+		Bout[(r + i) * 4 + 3] = X3;
+	}
+}
+
+/**
+* blockmix_salsa8_xor(Bin1, Bin2, Bout, r):
+* Compute Bout = BlockMix_{salsa20/8, r}(Bin1 \xor Bin2), without writing
+* out Bin1 \xor Bin2 first.  The inputs and the output must be 128r bytes in
+* length.
+*/
+SCRYPT_TARGET_SSE2 static void
+blockmix_salsa8_xor(const __m128i * Bin1, const __m128i * Bin2, __m128i * Bout,
+	size_t r)
+{
+	__m128i X0, X1, X2, X3;
+	size_t i;
+
+	/* 1: X <-- B_{2r - 1} */
+	X0 = _mm_xor_si128(Bin1[8 * r - 4], Bin2[8 * r - 4]);
+	X1 = _mm_xor_si128(Bin1[8 * r - 3], Bin2[8 * r - 3]);
+	X2 = _mm_xor_si128(Bin1[8 * r - 2], Bin2[8 * r - 2]);
+	X3 = _mm_xor_si128(Bin1[8 * r - 1], Bin2[8 * r - 1]);
+
+	/* 2: for i = 0 to 2r - 1 do */
+	for (i = 0; i < r; i++) {
+		/* 3: X <-- H(X \xor B_i) */
+		X0 = _mm_xor_si128(X0, _mm_xor_si128(Bin1[i * 8 + 0], Bin2[i * 8 + 0]));
+		X1 = _mm_xor_si128(X1, _mm_xor_si128(Bin1[i * 8 + 1], Bin2[i * 8 + 1]));
+		X2 = _mm_xor_si128(X2, _mm_xor_si128(Bin1[i * 8 + 2], Bin2[i * 8 + 2]));
+		X3 = _mm_xor_si128(X3, _mm_xor_si128(Bin1[i * 8 + 3], Bin2[i * 8 + 3]));
+		salsa20_8(X0, X1, X2, X3);
+
+		/* 4: Y_i <-- X */
+		/* 6: B'_{i/2} <-- X */
+		Bout[i * 4 + 0] = X0;
+		Bout[i * 4 + 1] = X1;
+		Bout[i * 4 + 2] = X2;
+		Bout[i * 4 + 3] = X3;
+
+		/* 3: X <-- H(X \xor B_i) */
+		X0 = _mm_xor_si128(X0, _mm_xor_si128(Bin1[i * 8 + 4], Bin2[i * 8 + 4]));
+		X1 = _mm_xor_si128(X1, _mm_xor_si128(Bin1[i * 8 + 5], Bin2[i * 8 + 5]));
+		X2 = _mm_xor_si128(X2, _mm_xor_si128(Bin1[i * 8 + 6], Bin2[i * 8 + 6]));
+		X3 = _mm_xor_si128(X3, _mm_xor_si128(Bin1[i * 8 + 7], Bin2[i * 8 + 7]));
+		salsa20_8(X0, X1, X2, X3);
+
+		/* 4: Y_i <-- X */
+		/* 6: B'_{r + (i - 1)/2} <-- X */
+		Bout[(r + i) * 4 + 0] = X0;
+		Bout[(r + i) * 4 + 1] = X1;
+		Bout[(r + i) * 4 + 2] = X2;
+		Bout[(r + i) * 4 + 3] = X3;
+	}
+}
+
+/**
+* integerify(B, r):
+* Return the result of parsing B_{2r-1} as a little-endian integer.
+* Word 1 of each block is stored at position 13 in the shuffled order.
+*/
+static uint64_t
+integerify(const void * B, size_t r)
+{
+	const uint32_t * X = (const uint32_t *)((uintptr_t)(B) + (2 * r - 1) * 64);
+
+	return (((uint64_t)(X[13]) << 32) + X[0]);
+}
+
+SCRYPT_TARGET_SSE2 void
+crypto_scrypt_smix_sse2(uint8_t * B, size_t r, uint64_t N, void * V, void * XY)
+{
+	__m128i * X = (__m128i *)XY;
+	__m128i * Y = (__m128i *)((uintptr_t)(XY) + 128 * r);
+	uint32_t * X32 = (uint32_t *)X;
+	uint64_t i, j;
+	size_t k;
+
+	/* 1: X <-- B */
+	for (k = 0; k < 2 * r; k++) {
+		for (i = 0; i < 16; i++) {
+			X32[k * 16 + i] =
+				le32dec(&B[(k * 16 + (i * 5 % 16)) * 4]);
+		}
+	}
+
+	/* 2: for i = 0 to N - 1 do */
+	for (i = 0; i < N; i += 2) {
+		/* 3: V_i <-- X */
+		blkcpy((void *)((uintptr_t)(V) + i * 128 * r), X, 128 * r);
+
+		/* 4: X <-- H(X) */
+		blockmix_salsa8(X, Y, r);
+
+		/* 3: V_i <-- X */
+		blkcpy((void *)((uintptr_t)(V) + (i + 1) * 128 * r),
+			Y, 128 * r);
+
+		/* 4: X <-- H(X) */
+		blockmix_salsa8(Y, X, r);
+	}
+
+	/* 6: for i = 0 to N - 1 do */
+	for (i = 0; i < N; i += 2) {
+		/* 7: j <-- Integerify(X) mod N */
+		j = integerify(X, r) & (N - 1);
+
+		/* 8: X <-- H(X \xor V_j) */
+		blockmix_salsa8_xor(X,
+			(const __m128i *)((uintptr_t)(V) + j * 128 * r), Y, r);
+
+		/* 7: j <-- Integerify(X) mod N */
+		j = integerify(Y, r) & (N - 1);
+
+		/* 8: X <-- H(X \xor V_j) */
+		blockmix_salsa8_xor(Y,
+			(const __m128i *)((uintptr_t)(V) + j * 128 * r), X, r);
+	}
+
+	/* 10: B' <-- X */
+	for (k = 0; k < 2 * r; k++) {
+		for (i = 0; i < 16; i++) {
+			le32enc(&B[(k * 16 + (i * 5 % 16)) * 4],
+				X32[k * 16 + i]);
+		}
+	}
+}
+
+int
+crypto_scrypt_smix_sse2_supported(void)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	/* SSE2 is part of the x86-64 baseline. */
+	return (1);
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return ((info[3] & (1 << 26)) != 0);
+#else
+	__builtin_cpu_init();
+	return (__builtin_cpu_supports("sse2"));
+#endif
+}
+
+#else
+
+void
+crypto_scrypt_smix_sse2(uint8_t *, size_t, uint64_t, void *, void *)
+{
+}
+
+int
+crypto_scrypt_smix_sse2_supported(void)
+{
+	return (0);
+}
+
+#endif
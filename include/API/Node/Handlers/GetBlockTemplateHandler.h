@@ -0,0 +1,53 @@
+#pragma once
+
+#include <TxPool/TransactionPool.h>
+#include <Core/Util/FeeUtil.h>
+#include <Consensus/BlockWeight.h>
+#include <Net/Clients/RPC/RPC.h>
+#include <Net/Servers/RPC/RPCMethod.h>
+
+//
+// Returns the mempool transactions a miner should include in the next block, ordered by fee rate.
+// Room is left for the coinbase output and kernel.
+//
+class GetBlockTemplateHandler : public RPCMethod
+{
+public:
+	GetBlockTemplateHandler(const ITransactionPool::Ptr& pTransactionPool)
+		: m_pTransactionPool(pTransactionPool) { }
+	~GetBlockTemplateHandler() = default;
+
+	RPC::Response Handle(const RPC::Request& request) const final
+	{
+		const uint64_t maxWeight = Consensus::MAX_BLOCK_WEIGHT - Consensus::CalculateWeight(0, 1, 1);
+		const std::vector<TransactionPtr> transactions = m_pTransactionPool->GetBlockTemplate(maxWeight);
+
+		uint64_t fees = 0;
+		uint64_t weight = 0;
+		Json::Value transactionsJson(Json::arrayValue);
+		for (const TransactionPtr& pTransaction : transactions)
+		{
+			fees += FeeUtil::CalculateActualFee(*pTransaction);
+			weight += Consensus::CalculateWeight(
+				pTransaction->GetInputs().size(),
+				pTransaction->GetOutputs().size(),
+				pTransaction->GetKernels().size()
+			);
+			transactionsJson.append(pTransaction->ToJSON());
+		}
+
+		Json::Value templateJson;
+		templateJson["fees"] = fees;
+		templateJson["weight"] = weight;
+		templateJson["transactions"] = transactionsJson;
+
+		Json::Value result;
+		result["Ok"] = templateJson;
+		return request.BuildResult(result);
+	}
+
+	bool ContainsSecrets() const noexcept final { return false; }
+
+private:
+	ITransactionPool::Ptr m_pTransactionPool;
+};
@@ -41,7 +41,11 @@ public:
 		);
 
 		if (status == EBlockChainStatus::SUCCESS) {
-			m_pP2PServer->BroadcastTransaction(pTransaction);
+			if (fluff) {
+				m_pP2PServer->BroadcastTransaction(pTransaction);
+			} else {
+				m_pP2PServer->StemTransaction(pTransaction);
+			}
 
 			Json::Value result;
 			result["Ok"] = Json::Value(Json::nullValue);
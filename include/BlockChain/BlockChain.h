@@ -58,6 +58,12 @@ public:
 	virtual fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) = 0;
 	virtual EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) = 0;
 	virtual EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) = 0;
+
+	//
+	// Validates and adds the transactions to the given pool, returning the status of each.
+	// The rangeproofs and kernel signatures of all of the transactions are batch verified.
+	//
+	virtual std::vector<EBlockChainStatus> AddTransactions(const std::vector<TransactionPtr>& transactions, const EPoolType poolType) = 0;
 	virtual TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const = 0;
 
 	virtual EBlockChainStatus AddBlockHeader(BlockHeaderPtr pBlockHeader) = 0;
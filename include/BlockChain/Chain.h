@@ -6,10 +6,11 @@
 #include <Core/Traits/Lockable.h>
 #include <Core/File/DataFile.h>
 
-// Forward Declarations
-class BlockIndexAllocator;
-class ChainStore;
-
+//
+// A chain of block hashes, indexed by height.
+// The hashes are read on demand from the memory-mapped chain file, so loading is O(1)
+// and BlockIndex objects are only created for the heights that are actually requested.
+//
 class Chain : public Traits::IBatchable
 {
 public:
@@ -17,25 +18,27 @@ public:
 	using CPtr = std::shared_ptr<const Chain>;
 
 	static Chain::Ptr Load(
-		std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
 		const EChainType chainType,
 		const fs::path& path,
 		std::shared_ptr<const BlockIndex> pGenesisIndex
 	);
 
+	//
+	// Creates a new BlockIndex on every call, so loops over heights should use GetHash or IsOnChain instead.
+	//
 	std::shared_ptr<const BlockIndex> GetByHeight(const uint64_t height) const;
 
-	const Hash& GetHash(const uint64_t height) const { return m_indices[height]->GetHash(); }
-	std::shared_ptr<const BlockIndex> GetTip() const { return m_indices[m_height]; }
-	const Hash& GetTipHash() const { return m_indices[m_height]->GetHash(); }
+	Hash GetHash(const uint64_t height) const { return m_pDataFile->GetAt(height); }
+	std::shared_ptr<const BlockIndex> GetTip() const { return GetByHeight(m_height); }
+	Hash GetTipHash() const { return GetHash(m_height); }
 	uint64_t GetHeight() const { return m_height; }
 
-	bool IsOnChain(const uint64_t height, const Hash& hash) const noexcept
+	bool IsOnChain(const uint64_t height, const Hash& hash) const
 	{
-		return height <= m_height && m_indices[height]->GetHash() == hash;
+		return height <= m_height && GetHash(height) == hash;
 	}
 
-	bool IsOnChain(const BlockHeaderPtr& pHeader) const noexcept
+	bool IsOnChain(const BlockHeaderPtr& pHeader) const
 	{
 		return IsOnChain(pHeader->GetHeight(), pHeader->GetHash());
 	}
@@ -53,48 +56,15 @@ public:
 private:
 	Chain(
 		const EChainType chainType,
-		std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
-		std::shared_ptr<DataFile<32>> pDataFile,
-		std::vector<std::shared_ptr<const BlockIndex>>&& indices
+		std::shared_ptr<DataFile<32>> pDataFile
 	);
 
 	const EChainType m_chainType;
-	std::shared_ptr<BlockIndexAllocator> m_pBlockIndexAllocator;
-	std::vector<std::shared_ptr<const BlockIndex>> m_indices;
-	size_t m_height;
+	uint64_t m_height;
+
+	// Chain is always accessed through its owner's lock, so reads go straight to the file.
+	// Writes still go through m_dataFileWriter so that batches can be rolled back.
+	std::shared_ptr<DataFile<32>> m_pDataFile;
 	Locked<DataFile<32>> m_dataFile;
 	Writer<DataFile<32>> m_dataFileWriter;
 };
-
-class BlockIndexAllocator
-{
-public:
-	BlockIndexAllocator() = default;
-
-	void AddChain(const std::weak_ptr<const Chain>& pChain)
-	{
-		m_chains.push_back(pChain);
-	}
-
-	std::shared_ptr<const BlockIndex> GetOrCreateIndex(const Hash& hash, const uint64_t height) const
-	{
-		return GetOrCreateIndex(Hash(hash), height);
-	}
-
-	std::shared_ptr<const BlockIndex> GetOrCreateIndex(Hash&& hash, const uint64_t height) const
-	{
-		for (std::weak_ptr<const Chain> pChain : m_chains)
-		{
-			std::shared_ptr<const BlockIndex> pIndex = pChain.lock()->GetByHeight(height);
-			if (pIndex != nullptr && pIndex->GetHash() == hash)
-			{
-				return pIndex;
-			}
-		}
-
-		return std::make_shared<const BlockIndex>(BlockIndex(std::move(hash), height));
-	}
-
-private:
-	std::vector<std::weak_ptr<const Chain>> m_chains;
-};
\ No newline at end of file
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// A bounded, lock-free, multi-producer multi-consumer queue.
+//
+// Each slot has a sequence number that tells producers and consumers whose turn it is,
+// so pushing and popping only take a single compare-and-swap on the shared position.
+// Slots and positions are padded out to separate cache lines, so producers and consumers don't contend on them.
+//
+// Consumers can either poll with try_pop, or block in wait_pop until an item arrives.
+// Producers only touch the mutex when a consumer is waiting.
+//
+template <typename T>
+class MPMCQueue
+{
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+
+public:
+	//
+	// The capacity is rounded up to the next power of 2.
+	//
+	explicit MPMCQueue(const size_t capacity)
+		: m_mask(RoundUpToPowerOf2(capacity) - 1),
+		m_pCells(new Cell[m_mask + 1]),
+		m_enqueuePos(0),
+		m_dequeuePos(0),
+		m_numWaiting(0)
+	{
+		for (size_t i = 0; i <= m_mask; i++)
+		{
+			m_pCells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	~MPMCQueue()
+	{
+		while (Pop([](T&&) { })) { }
+
+		delete[] m_pCells;
+	}
+
+	MPMCQueue(const MPMCQueue&) = delete;
+	MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+	size_t capacity() const noexcept { return m_mask + 1; }
+
+	//
+	// Returns the number of items in the queue. This is only a snapshot, since other threads may be pushing or popping.
+	// It's an upper bound: it includes items that producers are still constructing, which can't be popped yet.
+	//
+	size_t size() const noexcept
+	{
+		const size_t dequeuePos = m_dequeuePos.value.load(std::memory_order_acquire);
+		const size_t enqueuePos = m_enqueuePos.value.load(std::memory_order_acquire);
+		return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+	}
+
+	bool empty() const noexcept { return size() == 0; }
+
+	//
+	// Returns false if the queue is full.
+	//
+	template <typename... Args>
+	bool try_emplace(Args&&... args)
+	{
+		size_t pos = m_enqueuePos.value.load(std::memory_order_relaxed);
+		Cell* pCell = nullptr;
+		while (true)
+		{
+			pCell = &m_pCells[pos & m_mask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+			if (diff == 0)
+			{
+				if (m_enqueuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_enqueuePos.value.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (&pCell->storage) T(std::forward<Args>(args)...);
+		pCell->sequence.store(pos + 1, std::memory_order_release);
+
+		NotifyWaiting();
+		return true;
+	}
+
+	bool try_push(const T& item) { return try_emplace(item); }
+	bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+	//
+	// Moves the item at the front of the queue into item. Returns false if the queue is empty.
+	//
+	bool try_pop(T& item)
+	{
+		return Pop([&item](T&& front) { item = std::move(front); });
+	}
+
+	//
+	// Moves up to maxItems from the front of the queue onto the end of items. Returns the number of items popped.
+	//
+	size_t try_pop_batch(std::vector<T>& items, const size_t maxItems)
+	{
+		size_t numPopped = 0;
+		while (numPopped < maxItems && Pop([&items](T&& front) { items.push_back(std::move(front)); }))
+		{
+			++numPopped;
+		}
+
+		return numPopped;
+	}
+
+	//
+	// Waits up to the timeout for an item to arrive. Returns false if none did.
+	//
+	bool wait_pop(T& item, const std::chrono::milliseconds& timeout)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		while (!try_pop(item))
+		{
+			if (!WaitUntil(deadline))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	//
+	// Waits up to the timeout for items to arrive, and then moves up to maxItems of them onto the end of items.
+	//
+	size_t wait_pop_batch(std::vector<T>& items, const size_t maxItems, const std::chrono::milliseconds& timeout)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		size_t numPopped = 0;
+		while ((numPopped = try_pop_batch(items, maxItems)) == 0)
+		{
+			if (maxItems == 0 || !WaitUntil(deadline))
+			{
+				return 0;
+			}
+		}
+
+		return numPopped;
+	}
+
+	//
+	// Wakes up all waiting consumers, eg. when shutting down.
+	//
+	void notify_all()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+		}
+
+		m_condition.notify_all();
+	}
+
+private:
+	struct alignas(CACHE_LINE_SIZE) Cell
+	{
+		std::atomic<size_t> sequence;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+	};
+
+	struct alignas(CACHE_LINE_SIZE) Position
+	{
+		Position(const size_t initial) : value(initial) { }
+
+		std::atomic<size_t> value;
+	};
+
+	static size_t RoundUpToPowerOf2(const size_t value)
+	{
+		size_t result = 1;
+		while (result < value)
+		{
+			result <<= 1;
+		}
+
+		return result;
+	}
+
+	// Passes the item at the front of the queue to consume, and then removes it. Returns false if the queue is empty.
+	template <typename F>
+	bool Pop(const F& consume)
+	{
+		size_t pos = m_dequeuePos.value.load(std::memory_order_relaxed);
+		Cell* pCell = nullptr;
+		while (true)
+		{
+			pCell = &m_pCells[pos & m_mask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+			if (diff == 0)
+			{
+				if (m_dequeuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = m_dequeuePos.value.load(std::memory_order_relaxed);
+			}
+		}
+
+		T* pItem = std::launder(reinterpret_cast<T*>(&pCell->storage));
+		consume(std::move(*pItem));
+		pItem->~T();
+		pCell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Returns true if the item at the front of the queue has been published, so it's ready to be popped.
+	bool IsFrontReady() const noexcept
+	{
+		const size_t pos = m_dequeuePos.value.load(std::memory_order_acquire);
+		return m_pCells[pos & m_mask].sequence.load(std::memory_order_acquire) == pos + 1;
+	}
+
+	// Waits until the front item is ready, or the deadline passes. Another consumer may still pop the item first,
+	// so callers retry until the deadline.
+	bool WaitUntil(const std::chrono::steady_clock::time_point& deadline)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_numWaiting.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		const bool ready = m_condition.wait_until(lock, deadline, [this] { return IsFrontReady(); });
+
+		m_numWaiting.fetch_sub(1, std::memory_order_relaxed);
+		return ready;
+	}
+
+	void NotifyWaiting()
+	{
+		// Pairs with the fence in Wait(), so either the consumer sees the new item, or this sees the consumer waiting.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_numWaiting.load(std::memory_order_relaxed) > 0)
+		{
+			// Taking the mutex makes sure a consumer that just checked the queue is actually waiting before it's notified.
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+			}
+
+			m_condition.notify_one();
+		}
+	}
+
+	const size_t m_mask;
+	Cell* m_pCells;
+
+	Position m_enqueuePos;
+	Position m_dequeuePos;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_numWaiting;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+//
+// A hashed timer wheel, for scheduling lots of timers without keeping them sorted.
+//
+// Time is split into fixed-length ticks, and each timer goes in the slot for the tick its deadline falls in.
+// Scheduling is O(1), and advancing only looks at the slots for the ticks that passed.
+// Deadlines further out than one turn of the wheel just stay in their slot until the wheel comes around to their tick.
+//
+// Not thread-safe. It's meant to be owned by the thread that fires the timers.
+//
+template <typename T>
+class TimerWheel
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	TimerWheel(const size_t numSlots, const Clock::duration& tickDuration, const Clock::time_point& start = Clock::now())
+		: m_slots(numSlots), m_tickDuration(tickDuration), m_start(start), m_lastTick(0), m_size(0)
+	{
+
+	}
+
+	size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+
+	//
+	// Schedules the item to be returned by the first call to Advance() at or after the deadline.
+	// Deadlines are rounded up to the next tick, and deadlines that already passed fire on the next tick.
+	//
+	void Schedule(const Clock::time_point& deadline, T&& item)
+	{
+		uint64_t tick = m_lastTick + 1;
+		if (deadline > m_start)
+		{
+			const Clock::duration elapsed = deadline - m_start;
+			tick = (std::max)(tick, (uint64_t)((elapsed + m_tickDuration - Clock::duration(1)) / m_tickDuration));
+		}
+
+		m_slots[tick % m_slots.size()].push_back(Timer{ tick, std::move(item) });
+		++m_size;
+	}
+
+	void Schedule(const Clock::duration& delay, T&& item)
+	{
+		Schedule(Clock::now() + delay, std::move(item));
+	}
+
+	//
+	// Returns the items whose deadlines are at or before now.
+	// Items from different ticks come out in tick order, unless more than a full turn of the wheel passed since the last call.
+	//
+	std::vector<T> Advance(const Clock::time_point& now = Clock::now())
+	{
+		std::vector<T> expired;
+		if (now < m_start)
+		{
+			return expired;
+		}
+
+		const uint64_t nowTick = (uint64_t)((now - m_start) / m_tickDuration);
+
+		// Every slot only needs to be visited once, no matter how many turns of the wheel passed.
+		const uint64_t numTicks = (std::min)(nowTick - (std::min)(nowTick, m_lastTick), (uint64_t)m_slots.size());
+		for (uint64_t tick = nowTick - numTicks + 1; tick <= nowTick && numTicks > 0; tick++)
+		{
+			std::vector<Timer>& slot = m_slots[tick % m_slots.size()];
+
+			auto firstPending = slot.begin();
+			for (auto iter = slot.begin(); iter != slot.end(); iter++)
+			{
+				if (iter->tick <= nowTick)
+				{
+					expired.push_back(std::move(iter->item));
+				}
+				else
+				{
+					if (firstPending != iter)
+					{
+						*firstPending = std::move(*iter);
+					}
+
+					++firstPending;
+				}
+			}
+
+			m_size -= std::distance(firstPending, slot.end());
+			slot.erase(firstPending, slot.end());
+		}
+
+		m_lastTick = (std::max)(m_lastTick, nowTick);
+		return expired;
+	}
+
+	//
+	// Returns the time the next tick starts, which is when Advance() should next be called.
+	//
+	Clock::time_point GetNextTick() const noexcept
+	{
+		return m_start + (m_tickDuration * (m_lastTick + 1));
+	}
+
+private:
+	struct Timer
+	{
+		uint64_t tick;
+		T item;
+	};
+
+	std::vector<std::vector<Timer>> m_slots;
+	Clock::duration m_tickDuration;
+	Clock::time_point m_start;
+
+	// The last tick that Advance() fired timers for.
+	uint64_t m_lastTick;
+	size_t m_size;
+};
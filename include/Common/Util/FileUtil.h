@@ -15,6 +15,7 @@ public:
 	static void WriteTextToFile(const fs::path& filePath, const std::string& text);
 	static bool RemoveFile(const fs::path& filePath) noexcept;
 	static bool TruncateFile(const fs::path& filePath, const uint64_t size);
+	static bool SyncFile(const fs::path& filePath);
 	static size_t GetFileSize(const fs::path& file);
 
 	static void CopyDirectory(const fs::path& sourceDir, const fs::path& destDir);
@@ -1,8 +1,15 @@
 #pragma once
 
 #include <Common/Util/TimeUtil.h>
+#include <scheduler/ctpl_stl.h>
+#include <algorithm>
 #include <chrono>
 #include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -72,4 +79,94 @@ public:
 			thread.detach();
 		}
 	}
+
+	//
+	// Splits [0, numItems) into at most one chunk per core, each with at least minChunkSize items,
+	// and calls func(begin, end) for every chunk, using a shared pool of long-lived workers.
+	//
+	// The calling thread works through the chunks too, so it never waits on a chunk that hasn't been started,
+	// even when every worker is busy with other callers. If func throws, the first exception is rethrown
+	// once all of the chunks have finished.
+	//
+	static void ParallelFor(const size_t numItems, const size_t minChunkSize, const std::function<void(const size_t begin, const size_t end)>& func)
+	{
+		const size_t maxChunks = (std::max)(std::thread::hardware_concurrency(), 1u);
+		const size_t numChunks = (std::max)((std::min)(maxChunks, numItems / (std::max)(minChunkSize, (size_t)1)), (size_t)1);
+		if (numChunks == 1)
+		{
+			func(0, numItems);
+			return;
+		}
+
+		struct State
+		{
+			std::atomic<size_t> nextChunk{ 0 };
+			size_t chunksFinished{ 0 };
+			std::exception_ptr pException{ nullptr };
+			std::mutex mutex;
+			std::condition_variable finished;
+		};
+
+		// Workers can pick up their task after every chunk was already claimed, and even after this returns,
+		// so they share ownership of the state, and only call func for chunks they claimed.
+		auto pState = std::make_shared<State>();
+		const size_t chunkSize = (numItems + numChunks - 1) / numChunks;
+		auto runChunks = [pState, numItems, numChunks, chunkSize, &func]()
+		{
+			size_t chunk;
+			while ((chunk = pState->nextChunk++) < numChunks)
+			{
+				std::exception_ptr pException = nullptr;
+				try
+				{
+					const size_t begin = (std::min)(chunk * chunkSize, numItems);
+					func(begin, (std::min)(begin + chunkSize, numItems));
+				}
+				catch (...)
+				{
+					pException = std::current_exception();
+				}
+
+				std::unique_lock<std::mutex> lock(pState->mutex);
+				if (pException != nullptr && pState->pException == nullptr)
+				{
+					pState->pException = pException;
+				}
+
+				if (++pState->chunksFinished == numChunks)
+				{
+					pState->finished.notify_all();
+				}
+			}
+		};
+
+		try
+		{
+			ctpl::thread_pool& pool = GetThreadPool();
+			for (size_t i = 1; i < numChunks; i++)
+			{
+				pool.push([runChunks](int) { runChunks(); });
+			}
+		}
+		catch (...)
+		{
+			// Any chunks that couldn't be handed off are run below.
+		}
+
+		runChunks();
+
+		std::unique_lock<std::mutex> lock(pState->mutex);
+		pState->finished.wait(lock, [&pState, numChunks] { return pState->chunksFinished == numChunks; });
+		if (pState->pException != nullptr)
+		{
+			std::rethrow_exception(pState->pException);
+		}
+	}
+
+private:
+	static ctpl::thread_pool& GetThreadPool()
+	{
+		static ctpl::thread_pool pool((int)(std::max)(std::thread::hardware_concurrency(), 1u));
+		return pool;
+	}
 };
\ No newline at end of file
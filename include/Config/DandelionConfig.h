@@ -7,17 +7,16 @@
 class DandelionConfig
 {
 public:
-	// Choose new Dandelion relay peer every n secs.
+	// Start a new Dandelion epoch, with new relay peers, every n secs.
 	uint16_t GetRelaySeconds() const { return m_relaySeconds; }
 
 	// Dandelion embargo, fluff and broadcast tx if not seen on network before embargo expires.
 	uint16_t GetEmbargoSeconds() const { return m_embargoSeconds; }
 
-	// Dandelion patience timer, fluff/stem processing runs every n secs.
-	// Tx aggregation happens on stem txs received within this window.
+	// Dandelion patience timer, txs to fluff are aggregated for n secs before being broadcast.
 	uint8_t GetPatienceSeconds() const { return m_patienceSeconds; }
 
-	// Dandelion stem probability (stem 90% of the time, fluff 10%).
+	// Dandelion stem probability (stem during 90% of epochs, fluff during 10%).
 	uint8_t GetStemProbability() const { return m_stemProbability; }
 
 	//
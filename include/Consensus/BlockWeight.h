@@ -32,4 +32,10 @@ namespace Consensus
 	// `40_000 / 47 = 851` (txs per block)
 	//
 	static const uint32_t MAX_BLOCK_WEIGHT = 40000;
+
+	// Weight of a transaction body when counted against the max block weight capacity
+	static uint64_t CalculateWeight(const uint64_t numInputs, const uint64_t numOutputs, const uint64_t numKernels)
+	{
+		return (numInputs * BLOCK_INPUT_WEIGHT) + (numOutputs * BLOCK_OUTPUT_WEIGHT) + (numKernels * BLOCK_KERNEL_WEIGHT);
+	}
 }
\ No newline at end of file
@@ -1,18 +1,31 @@
 #pragma once
 
 #include <Core/File/MappedFile.h>
+#include <Core/File/WriteAheadLog.h>
 #include <filesystem.h>
 #include <cstdint>
+#include <mutex>
 #include <string>
 #include <vector>
 
+//
+// An append-only file with support for rewinding.
+//
+// Changes go through up to 3 in-memory layers before reaching disk:
+// 1. Working changes (m_buffer) that can still be discarded.
+// 2. Committed changes that have been written to a WriteAheadLog, but not yet to the file.
+// 3. Changes that are currently being written to the file by a background flusher.
+//
 class AppendOnlyFile
 {
 public:
 	AppendOnlyFile(const fs::path& path)
 		: m_path(path),
-		m_bufferIndex(0),
 		m_fileSize(0),
+		m_flushingIndex(0),
+		m_isFlushing(false),
+		m_committedIndex(0),
+		m_bufferIndex(0),
 		m_pMappedFile(nullptr) { }
 
 	AppendOnlyFile(const AppendOnlyFile& file) = delete;
@@ -22,13 +35,35 @@ public:
 	virtual ~AppendOnlyFile() = default;
 
 	void Load();
+
+	//
+	// Commits the working changes and synchronously writes everything to disk.
+	//
 	bool Flush();
 
+	//
+	// Commits the working changes without writing them to disk, and adds an entry describing them to the log batch.
+	// The changes are written later via BeginFlush() and EndFlush().
+	//
+	void Commit(std::vector<WriteAheadLog::Entry>& entries);
+
+	//
+	// Snapshots the committed changes so they can be written by EndFlush() while new changes continue to be committed.
+	//
+	void BeginFlush();
+
+	//
+	// Writes the changes snapshotted by BeginFlush() to disk.
+	// When sync is true, also waits for the OS to persist them, so any log entries covering them can be removed.
+	//
+	bool EndFlush(const bool sync);
+
 	void Append(const std::vector<unsigned char>& data);
 	bool Rewind(const uint64_t nextPosition);
 
 	void Discard() noexcept;
 	uint64_t GetSize() const noexcept;
+	const fs::path& GetPath() const noexcept { return m_path; }
 
 	bool Read(
 		const uint64_t position,
@@ -36,10 +71,33 @@ public:
 		std::vector<unsigned char>& data
 	) const;
 
+	bool Read(
+		const uint64_t position,
+		const uint64_t numBytes,
+		uint8_t* pData
+	) const;
+
 private:
+	void CommitBuffer();
+
 	fs::path m_path;
-	uint64_t m_bufferIndex;
+	mutable std::mutex m_mutex;
+
+	// Size of the file on disk.
 	uint64_t m_fileSize;
+
+	// Changes being written to disk by EndFlush().
+	uint64_t m_flushingIndex;
+	std::vector<unsigned char> m_flushing;
+	bool m_isFlushing;
+
+	// Changes that are committed, but not yet being written.
+	uint64_t m_committedIndex;
+	std::vector<unsigned char> m_committed;
+
+	// Working changes.
+	uint64_t m_bufferIndex;
 	std::vector<unsigned char> m_buffer;
+
 	IMappedFile::UPtr m_pMappedFile;
-};
\ No newline at end of file
+};
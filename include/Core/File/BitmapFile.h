@@ -1,14 +1,9 @@
 #pragma once
 
-#pragma warning(push)
-#pragma warning(disable:4244)
-#pragma warning(disable:4267)
-#pragma warning(disable:4334)
-#pragma warning(disable:4018)
-#include <mio/mmap.hpp>
-#pragma warning(pop)
-
 #include <Core/Traits/Batchable.h>
+#include <Core/File/MappedFile.h>
+#include <Core/File/WriteAheadLog.h>
+#include <Core/Exceptions/FileException.h>
 #include <Roaring.h>
 #include <Common/Util/BitUtil.h>
 #include <Common/Util/FileUtil.h>
@@ -16,19 +11,30 @@
 #include <fstream>
 #include <functional>
 #include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
-
-#ifdef _WIN32
-#define MPATH_STR m_path.wstring()
-#else
-#define MPATH_STR m_path.string()
-#endif
+#include <mutex>
 
 // NOTE: Uses bit positions numbered from 0-7, starting at the left.
 // For example, 65 (01000001) has bit positions 1 and 7 set.
+//
+// In memory, the bitmap is handled as 64-bit words, grouped into pages.
+// Word i holds bits (i * 64) through (i * 64) + 63, with the first bit as the most-significant,
+// so serializing the words as big-endian produces the same bytes as the file.
+//
+// Modified pages are copied into memory, and flow through the same layers as AppendOnlyFile:
+// working pages, which can be rolled back, then committed pages, then pages being flushed to disk.
+//
 class BitmapFile : public Traits::IBatchable
 {
+	static constexpr uint64_t BYTES_PER_PAGE = 4096;
+	static constexpr uint64_t WORDS_PER_PAGE = BYTES_PER_PAGE / 8;
+	static constexpr uint64_t BITS_PER_PAGE = BYTES_PER_PAGE * 8;
+
+	using Page = std::array<uint64_t, WORDS_PER_PAGE>;
+	using PageMap = std::map<uint64_t, std::unique_ptr<Page>>;
+
 public:
 	virtual ~BitmapFile() = default;
 
@@ -50,73 +56,136 @@ public:
 
 	void Commit() final
 	{
-		if (!m_modifiedBytes.empty())
+		std::vector<WriteAheadLog::Entry> entries;
+		Commit(entries);
+		BeginFlush();
+		EndFlush(false);
+	}
+
+	//
+	// Commits the modified pages to memory and adds entries for them to the log batch.
+	// They're written to disk later by BeginFlush()/EndFlush().
+	//
+	void Commit(std::vector<WriteAheadLog::Entry>& entries)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		// Contiguous runs of modified pages are logged as a single entry.
+		for (auto iter = m_modifiedPages.begin(); iter != m_modifiedPages.end(); iter++)
 		{
-			m_mmap.unmap();
+			const uint64_t offset = iter->first * BYTES_PER_PAGE;
+			if (entries.empty() || entries.back().path != m_path || entries.back().offset + entries.back().data.size() != offset)
+			{
+				entries.push_back({ WriteAheadLog::EType::OVERWRITE, m_path, offset, {} });
+			}
+
+			SerializePage(iter->first, *iter->second, m_size, entries.back().data);
+			m_committedPages[iter->first] = std::move(iter->second);
+		}
 
-			std::ofstream file(m_path.c_str(), std::ios_base::binary | std::ios_base::out | std::ios_base::in);
+		m_modifiedPages.clear();
+		m_committedSize = m_size;
+		SetDirty(false);
+	}
 
-			for (auto iter : m_modifiedBytes)
+	void BeginFlush()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_isFlushing && !m_committedPages.empty())
+		{
+			m_flushingPages = std::move(m_committedPages);
+			m_committedPages.clear();
+			m_flushingSize = m_committedSize;
+			m_isFlushing = true;
+		}
+	}
+
+	void EndFlush(const bool sync)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			if (!m_isFlushing)
 			{
-				file.seekp(iter.first);
-				file.write((const char*)&iter.second, 1);
+				return;
 			}
+		}
 
-			file.close();
+		// m_flushingPages can't change until m_isFlushing is cleared, so it's safe to write it without holding the lock.
+		// Readers always find these pages in memory, so they never see a partially written page.
+		auto iter = m_flushingPages.cbegin();
+		while (iter != m_flushingPages.cend())
+		{
+			const uint64_t firstPage = iter->first;
 
-			std::error_code error;
-			m_mmap = mio::make_mmap_source(MPATH_STR, error);
-			if (error.value() != 0)
+			std::vector<uint8_t> bytes;
+			for (uint64_t pageIndex = firstPage; iter != m_flushingPages.cend() && iter->first == pageIndex; iter++, pageIndex++)
 			{
-				// TODO: Handle this
+				SerializePage(pageIndex, *iter->second, m_flushingSize, bytes);
 			}
 
-			m_modifiedBytes.clear();
-			SetDirty(false);
+			if (!bytes.empty() && !m_pMappedFile->Overwrite(firstPage * BYTES_PER_PAGE, bytes))
+			{
+				throw FILE_EXCEPTION_F("Failed to write {}", m_path);
+			}
+		}
+
+		if (sync && !FileUtil::SyncFile(m_path))
+		{
+			throw FILE_EXCEPTION_F("Failed to sync {}", m_path);
 		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_fileSize = (std::max)(m_fileSize, m_flushingSize);
+		m_flushingPages.clear();
+		m_isFlushing = false;
 	}
 
 	void Rollback() noexcept final
 	{
-		m_modifiedBytes.clear();
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_modifiedPages.clear();
+		m_size = m_committedSize;
 		SetDirty(false);
 	}
 
 	bool IsSet(const uint64_t leafIndex) const
 	{
-		return GetByte(leafIndex / 8) & BitToByte(leafIndex % 8);
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return (GetWord(leafIndex / 64) & BitToWord(leafIndex % 64)) != 0;
 	}
 
 	void Set(const uint64_t leafIndex)
 	{
-		SetDirty(true);
-		uint8_t byte = GetByte(leafIndex / 8);
-		byte |= BitToByte(leafIndex % 8);
-		m_modifiedBytes[leafIndex / 8] = byte;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		UpdateWord(leafIndex / 64, BitToWord(leafIndex % 64), true);
+		m_size = (std::max)(m_size, (leafIndex / 8) + 1);
 	}
 
 	void Set(const Roaring& positionsToSet)
 	{
-		for (auto iter = positionsToSet.begin(); iter != positionsToSet.end(); iter++)
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		uint64_t lastLeafIndex = 0;
+		UpdateWords(positionsToSet, true, lastLeafIndex);
+
+		if (!positionsToSet.isEmpty())
 		{
-			Set(MMRUtil::GetLeafIndex(iter.i.current_value - 1));
+			m_size = (std::max)(m_size, (lastLeafIndex / 8) + 1);
 		}
 	}
 
 	void Unset(const uint64_t leafIndex)
 	{
-		SetDirty(true);
-		uint8_t byte = GetByte(leafIndex / 8);
-		byte &= (0xff ^ BitToByte(leafIndex % 8));
-		m_modifiedBytes[leafIndex / 8] = byte;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		UpdateWord(leafIndex / 64, BitToWord(leafIndex % 64), false);
 	}
 
 	void Unset(const Roaring& positionsToUnset)
 	{
-		for (auto iter = positionsToUnset.begin(); iter != positionsToUnset.end(); iter++)
-		{
-			Unset(MMRUtil::GetLeafIndex(iter.i.current_value - 1));
-		}
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		uint64_t lastLeafIndex = 0;
+		UpdateWords(positionsToUnset, false, lastLeafIndex);
 	}
 
 	const bool& operator[] (const size_t leafIndex) const
@@ -126,31 +195,78 @@ public:
 
 	void Rewind(const size_t numLeaves, const std::vector<uint64_t>& leavesToAdd)
 	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
 		for (const uint64_t leafIndex : leavesToAdd)
 		{
-			Set(leafIndex);
+			UpdateWord(leafIndex / 64, BitToWord(leafIndex % 64), true);
+			m_size = (std::max)(m_size, (leafIndex / 8) + 1);
 		}
 
-		size_t currentSize = GetNumBytes() * 8;
-		for (size_t i = numLeaves; i < currentSize; i++)
+		// Clear everything from numLeaves onward, one page at a time.
+		// Pages with nothing to clear are left alone, so they're never copied or rewritten.
+		const uint64_t numBits = m_size * 8;
+		for (uint64_t bit = numLeaves; bit < numBits; )
 		{
-			Unset(i);
+			const uint64_t pageIndex = bit / BITS_PER_PAGE;
+			const uint64_t pageEnd = (std::min)((pageIndex + 1) * BITS_PER_PAGE, numBits);
+
+			Page page;
+			const Page& current = GetPage(pageIndex, page);
+
+			const uint64_t firstWord = (bit / 64) % WORDS_PER_PAGE;
+			const uint64_t lastWord = ((pageEnd - 1) / 64) % WORDS_PER_PAGE;
+			const uint64_t firstMask = ~0ull >> (bit % 64);
+
+			bool anySet = (current[firstWord] & firstMask) != 0;
+			for (uint64_t w = firstWord + 1; !anySet && w <= lastWord; w++)
+			{
+				anySet = current[w] != 0;
+			}
+
+			if (anySet)
+			{
+				Page& writable = GetWritablePage(pageIndex);
+				writable[firstWord] &= ~firstMask;
+				for (uint64_t w = firstWord + 1; w <= lastWord; w++)
+				{
+					writable[w] = 0;
+				}
+
+				SetDirty(true);
+			}
+
+			bit = pageEnd;
 		}
 	}
 
 	Roaring ToRoaring() const
 	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
 		Roaring bitmap;
 
-		const uint64_t numBytes = GetNumBytes();
-		for (uint32_t i = 0; i < (uint32_t)numBytes; i++)
+		const uint64_t numWords = (m_size + 7) / 8;
+		for (uint64_t pageIndex = 0; pageIndex * WORDS_PER_PAGE < numWords; pageIndex++)
 		{
-			const uint8_t byte = GetByte(i);
-			for (uint8_t j = 0; j < 8; j++)
+			Page page;
+			const Page& current = GetPage(pageIndex, page);
+
+			for (uint64_t w = 0; w < WORDS_PER_PAGE; w++)
 			{
-				if ((byte & BitToByte(j)) > 0)
+				const uint64_t word = current[w];
+				if (word == 0)
+				{
+					continue;
+				}
+
+				const uint64_t firstLeaf = (pageIndex * BITS_PER_PAGE) + (w * 64);
+				for (uint8_t j = 0; j < 64; j++)
 				{
-					bitmap.add((uint32_t)(MMRUtil::GetPMMRIndex((i * 8) + j) + 1));
+					if ((word & BitToWord(j)) != 0)
+					{
+						bitmap.add((uint32_t)(MMRUtil::GetPMMRIndex(firstLeaf + j) + 1));
+					}
 				}
 			}
 		}
@@ -160,21 +276,13 @@ public:
 
 	uint8_t GetByte(const uint64_t byteIndex) const
 	{
-		auto iter = m_modifiedBytes.find(byteIndex);
-		if (iter != m_modifiedBytes.cend())
-		{
-			return iter->second;
-		}
-		else if (byteIndex < m_mmap.size())
-		{
-			return *((uint8_t*)(m_mmap.cbegin() + byteIndex));
-		}
-
-		return 0;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		return (uint8_t)(GetWord(byteIndex / 8) >> (56 - (8 * (byteIndex % 8))));
 	}
 
 private:
-	BitmapFile(const fs::path& path) : m_path(path), m_size(0) { }
+	BitmapFile(const fs::path& path)
+		: m_path(path), m_fileSize(0), m_flushingSize(0), m_isFlushing(false), m_committedSize(0), m_size(0) { }
 
 	void Load()
 	{
@@ -198,19 +306,9 @@ private:
 			outFile.close();
 		}
 
-		m_size = FileUtil::GetFileSize(m_path);
-
-		if (m_size > 0)
+		if (FileUtil::GetFileSize(m_path) > 0)
 		{
 			ConvertToLeaves(version1Path);
-
-			std::error_code error;
-			m_mmap = mio::make_mmap_source(MPATH_STR, error);
-			if (error.value() != 0)
-			{
-				LOG_ERROR_F("Failed to mmap file: {}", error.value());
-				throw FILE_EXCEPTION_F("Failed to mmap file: {}", m_path);
-			}
 		}
 		else
 		{
@@ -223,6 +321,11 @@ private:
 
 			outFile.close();
 		}
+
+		m_fileSize = FileUtil::GetFileSize(m_path);
+		m_committedSize = m_fileSize;
+		m_size = m_fileSize;
+		m_pMappedFile = IMappedFile::Load(m_path);
 	}
 
 	void ConvertToLeaves(const fs::path& version1Path)
@@ -260,20 +363,147 @@ private:
 		}
 	}
 
-	uint64_t GetNumBytes() const
+	//
+	// The helpers below must be called while holding m_mutex.
+	//
+
+	// Returns the newest in-memory copy of the page, or nullptr if it's unmodified since it was last written to disk.
+	const Page* FindPage(const uint64_t pageIndex) const
+	{
+		for (const PageMap* pPages : { &m_modifiedPages, &m_committedPages, &m_flushingPages })
+		{
+			auto iter = pPages->find(pageIndex);
+			if (iter != pPages->cend())
+			{
+				return iter->second.get();
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Returns the newest version of the page, reading it from disk into the given page if it's not in memory.
+	const Page& GetPage(const uint64_t pageIndex, Page& page) const
+	{
+		const Page* pPage = FindPage(pageIndex);
+		if (pPage != nullptr)
+		{
+			return *pPage;
+		}
+
+		ReadWords(pageIndex * WORDS_PER_PAGE, WORDS_PER_PAGE, page.data());
+		return page;
+	}
+
+	Page& GetWritablePage(const uint64_t pageIndex)
+	{
+		auto iter = m_modifiedPages.find(pageIndex);
+		if (iter != m_modifiedPages.end())
+		{
+			return *iter->second;
+		}
+
+		auto pPage = std::make_unique<Page>();
+		const Page& current = GetPage(pageIndex, *pPage);
+		if (&current != pPage.get())
+		{
+			*pPage = current;
+		}
+
+		Page& page = *pPage;
+		m_modifiedPages[pageIndex] = std::move(pPage);
+		return page;
+	}
+
+	uint64_t GetWord(const uint64_t wordIndex) const
+	{
+		const Page* pPage = FindPage(wordIndex / WORDS_PER_PAGE);
+		if (pPage != nullptr)
+		{
+			return (*pPage)[wordIndex % WORDS_PER_PAGE];
+		}
+
+		uint64_t word = 0;
+		ReadWords(wordIndex, 1, &word);
+		return word;
+	}
+
+	// Applies the mask to the word, only copying its page if the word actually changes.
+	void UpdateWord(const uint64_t wordIndex, const uint64_t mask, const bool set)
+	{
+		const uint64_t current = GetWord(wordIndex);
+		const uint64_t updated = set ? (current | mask) : (current & ~mask);
+		if (updated != current)
+		{
+			GetWritablePage(wordIndex / WORDS_PER_PAGE)[wordIndex % WORDS_PER_PAGE] = updated;
+			SetDirty(true);
+		}
+	}
+
+	// Positions are sorted, so all of the bits that fall in the same word are combined into a single mask.
+	void UpdateWords(const Roaring& positions, const bool set, uint64_t& lastLeafIndex)
 	{
-		size_t size = 0;
-		if (!m_modifiedBytes.empty())
+		uint64_t wordIndex = 0;
+		uint64_t mask = 0;
+		for (auto iter = positions.begin(); iter != positions.end(); iter++)
+		{
+			const uint64_t leafIndex = MMRUtil::GetLeafIndex(iter.i.current_value - 1);
+			if (mask != 0 && leafIndex / 64 != wordIndex)
+			{
+				UpdateWord(wordIndex, mask, set);
+				mask = 0;
+			}
+
+			wordIndex = leafIndex / 64;
+			mask |= BitToWord(leafIndex % 64);
+			lastLeafIndex = leafIndex;
+		}
+
+		if (mask != 0)
 		{
-			size = m_modifiedBytes.crbegin()->first + 1;
+			UpdateWord(wordIndex, mask, set);
 		}
+	}
+
+	// Reads up to a page of words directly from the file. Anything beyond the end of the file is zero.
+	void ReadWords(const uint64_t firstWord, const uint64_t numWords, uint64_t* pWords) const
+	{
+		std::fill(pWords, pWords + numWords, 0);
 
-		if (!m_mmap.empty())
+		const uint64_t position = firstWord * 8;
+		if (position >= m_fileSize)
 		{
-			size = (std::max)(size, m_mmap.size() + 1);
+			return;
 		}
 
-		return size;
+		// Only the bytes that were read are decoded, so the buffer doesn't need to be cleared first.
+		const uint64_t numBytes = (std::min)(numWords * 8, m_fileSize - position);
+		std::array<uint8_t, BYTES_PER_PAGE> bytes;
+		m_pMappedFile->Read(position, numBytes, bytes.data());
+
+		for (uint64_t b = 0; b < numBytes; b++)
+		{
+			pWords[b / 8] |= (uint64_t)bytes[b] << (8 * (7 - (b % 8)));
+		}
+	}
+
+	// Appends the page's bytes, stopping at the end of the bitmap so the file never grows past it.
+	static void SerializePage(const uint64_t pageIndex, const Page& page, const uint64_t size, std::vector<uint8_t>& bytes)
+	{
+		const uint64_t pageStart = pageIndex * BYTES_PER_PAGE;
+		const uint64_t numBytes = size > pageStart ? (std::min)(BYTES_PER_PAGE, size - pageStart) : 0;
+
+		for (uint64_t i = 0; i < numBytes; i++)
+		{
+			bytes.push_back((uint8_t)(page[i / 8] >> (56 - (8 * (i % 8)))));
+		}
+	}
+
+	// Returns a word with the given bit (0-63) set.
+	// Example: BitToWord(2) returns 0x2000000000000000.
+	static uint64_t BitToWord(const uint64_t bit)
+	{
+		return 1ull << (63 - bit);
 	}
 
 	// Returns a byte with the given bit (0-7) set.
@@ -283,18 +513,26 @@ private:
 		return 1 << (7 - bit);
 	}
 
-	bool IsBitSet(const uint8_t byte, const uint64_t position) const
-	{
-		const uint8_t bitPosition = (uint8_t)position % 8;
+	fs::path m_path;
+	mutable std::mutex m_mutex;
+	IMappedFile::UPtr m_pMappedFile;
 
-		return (byte >> (7 - bitPosition)) & 1;
-	}
+	// Size of the file on disk.
+	uint64_t m_fileSize;
 
-	fs::path m_path;
-	std::map<uint64_t, uint8_t> m_modifiedBytes;
-	mio::mmap_source m_mmap;
+	// Pages being written to disk by EndFlush().
+	PageMap m_flushingPages;
+	uint64_t m_flushingSize;
+	bool m_isFlushing;
+
+	// Pages that are committed to the log, but not yet being written.
+	PageMap m_committedPages;
+	uint64_t m_committedSize;
+
+	// Working changes, which can still be rolled back.
+	PageMap m_modifiedPages;
 	uint64_t m_size;
 
 	static const bool s_true{ false };
 	static const bool s_false{ false };
-};
\ No newline at end of file
+};
@@ -34,6 +34,29 @@ public:
 		SetDirty(false);
 	}
 
+	//
+	// Commits the changes to memory and the log batch. They're written to disk later by BeginFlush()/EndFlush().
+	//
+	void Commit(std::vector<WriteAheadLog::Entry>& entries)
+	{
+		if (IsDirty())
+		{
+			m_pFile->Commit(entries);
+		}
+
+		SetDirty(false);
+	}
+
+	void BeginFlush() { m_pFile->BeginFlush(); }
+
+	void EndFlush(const bool sync)
+	{
+		if (!m_pFile->EndFlush(sync))
+		{
+			throw FILE_EXCEPTION("Flush failed.");
+		}
+	}
+
 	void Rollback() noexcept final
 	{
 		if (IsDirty())
@@ -58,6 +81,8 @@ public:
 		return m_pFile->GetSize() / NUM_BYTES;
 	}
 
+	const fs::path& GetPath() const noexcept { return m_pFile->GetPath(); }
+
 	std::vector<unsigned char> GetDataAt(const uint64_t position) const
 	{
 		std::vector<unsigned char> data;
@@ -69,6 +94,34 @@ public:
 		return data;
 	}
 
+	//
+	// Reads the entry directly into a CBigInteger, skipping the intermediate vector used by GetDataAt.
+	//
+	CBigInteger<NUM_BYTES> GetAt(const uint64_t position) const
+	{
+		CBigInteger<NUM_BYTES> value;
+		if (!m_pFile->Read(position * NUM_BYTES, NUM_BYTES, value.data()))
+		{
+			throw FILE_EXCEPTION(StringUtil::Format("Failed to read data at position {}", position));
+		}
+
+		return value;
+	}
+
+	//
+	// Reads numEntries consecutive entries with a single read, starting at the position.
+	//
+	std::vector<unsigned char> GetDataRange(const uint64_t position, const uint64_t numEntries) const
+	{
+		std::vector<unsigned char> data;
+		if (!m_pFile->Read(position * NUM_BYTES, numEntries * NUM_BYTES, data))
+		{
+			throw FILE_EXCEPTION(StringUtil::Format("Failed to read {} entries at position {}", numEntries, position));
+		}
+
+		return data;
+	}
+
 	void AddData(const std::vector<unsigned char>& data)
 	{
 		SetDirty(true);
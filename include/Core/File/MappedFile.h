@@ -15,6 +15,12 @@ public:
     virtual ~IMappedFile() = default;
 
     virtual bool Write(const size_t startIndex, const std::vector<uint8_t>& data) = 0;
+
+    // Writes the data at the position without truncating anything after it, extending the file if needed.
+    virtual bool Overwrite(const uint64_t position, const std::vector<uint8_t>& data) = 0;
     virtual void Read(const uint64_t position, const uint64_t numBytes, std::vector<uint8_t>& data) const = 0;
+
+    // Copies the bytes directly into the caller's buffer, avoiding the temporary vector.
+    virtual void Read(const uint64_t position, const uint64_t numBytes, uint8_t* pData) const = 0;
 };
 
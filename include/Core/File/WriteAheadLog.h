@@ -0,0 +1,89 @@
+#pragma once
+
+#include <filesystem.h>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// A write-ahead log for file changes that are committed immediately, but written to their target files later.
+// Each call to Append() writes a single record containing every change in the commit, followed by one fsync.
+//
+// The log is split into an active segment and a sealed segment, so new commits can keep appending
+// while older changes are being flushed. Rotate() seals the active segment, and RemoveSealed()
+// deletes it once all of its changes have been written to (and synced on) their target files.
+//
+class WriteAheadLog
+{
+public:
+	using Ptr = std::shared_ptr<WriteAheadLog>;
+
+	enum class EType : uint8_t
+	{
+		// Truncates the file at the offset, then writes the data there.
+		APPEND = 0,
+
+		// Writes the data at the offset, leaving the rest of the file untouched.
+		OVERWRITE = 1
+	};
+
+	struct Entry
+	{
+		EType type;
+		fs::path path;
+		uint64_t offset;
+		std::vector<uint8_t> data;
+	};
+
+	//
+	// Replays any records left behind by a previous run, then opens an empty log in the directory.
+	//
+	static WriteAheadLog::Ptr Open(const fs::path& directory);
+
+	//
+	// Applies every complete record found in the directory's logs to its target files, then removes the logs.
+	// A torn record at the end of a log was never acknowledged, so it is discarded.
+	//
+	static void Recover(const fs::path& directory);
+
+	//
+	// Removes the directory's logs without replaying them.
+	//
+	static void Discard(const fs::path& directory);
+
+	~WriteAheadLog();
+
+	//
+	// Durably appends a record containing all of the entries.
+	// Once this returns, the changes will survive a crash, even if they haven't been flushed yet.
+	//
+	void Append(const std::vector<Entry>& entries);
+
+	//
+	// Seals the active segment and starts a new one.
+	// Must not be called again until RemoveSealed() has been called.
+	//
+	void Rotate();
+
+	//
+	// Removes the sealed segment. Only call this once all of its changes are synced to their target files.
+	//
+	void RemoveSealed();
+
+	uint64_t GetActiveSize() const noexcept;
+
+private:
+	WriteAheadLog(const fs::path& directory, std::FILE* pFile);
+
+	static fs::path GetActivePath(const fs::path& directory) { return directory / "pmmr_wal.bin"; }
+	static fs::path GetSealedPath(const fs::path& directory) { return directory / "pmmr_wal.bin.sealed"; }
+	static std::FILE* OpenForAppend(const fs::path& path);
+	static void Replay(const fs::path& directory, const fs::path& logPath);
+
+	fs::path m_directory;
+	mutable std::mutex m_mutex;
+	std::FILE* m_pFile;
+	uint64_t m_activeSize;
+};
@@ -84,6 +84,7 @@ public:
 	Json::Value ToJSON() const;
 	static std::shared_ptr<BlockHeader> FromJSON(const Json::Value& json);
 	std::vector<unsigned char> GetPreProofOfWork() const;
+	void SerializePreProofOfWork(Serializer& serializer) const;
 
 	//
 	// Hashing
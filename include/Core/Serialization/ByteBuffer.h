@@ -33,18 +33,15 @@ public:
 			throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
 		}
 
-		if (EndianHelper::IsBigEndian())
-		{
-			memcpy(&t, &m_bytes[m_index], sizeof(T));
-		}
-		else
+		uint8_t temp[sizeof(T)];
+		memcpy(temp, m_bytes.data() + m_index, sizeof(T));
+
+		if constexpr (!EndianHelper::IsBigEndian())
 		{
-			std::vector<unsigned char> temp;
-			temp.resize(sizeof(T));
-			std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
-			memcpy(&t, &temp[0], sizeof(T));
+			EndianHelper::Reverse<sizeof(T)>(temp);
 		}
 
+		memcpy(&t, temp, sizeof(T));
 		m_index += sizeof(T);
 	}
 
@@ -56,18 +53,15 @@ public:
 			throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
 		}
 
-		if (EndianHelper::IsBigEndian())
-		{
-			std::vector<unsigned char> temp;
-			temp.resize(sizeof(T));
-			std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
-			memcpy(&t, &temp[0], sizeof(T));
-		}
-		else
+		uint8_t temp[sizeof(T)];
+		memcpy(temp, m_bytes.data() + m_index, sizeof(T));
+
+		if constexpr (EndianHelper::IsBigEndian())
 		{
-			memcpy(&t, &m_bytes[m_index], sizeof(T));
+			EndianHelper::Reverse<sizeof(T)>(temp);
 		}
 
+		memcpy(&t, temp, sizeof(T));
 		m_index += sizeof(T);
 	}
 
@@ -156,10 +150,10 @@ public:
 			throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
 		}
 
-		std::vector<unsigned char> temp(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + stringLength);
+		const size_t index = m_index;
 		m_index += stringLength;
 
-		return std::string((char*)&temp[0], stringLength);
+		return std::string((const char*)m_bytes.data() + index, stringLength);
 	}
 
 	std::string ReadString(const size_t size)
@@ -169,10 +163,10 @@ public:
 			throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
 		}
 
-		std::vector<unsigned char> temp(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + size);
+		const size_t index = m_index;
 		m_index += size;
 
-		return std::string((char*)&temp[0], size);
+		return std::string((const char*)m_bytes.data() + index, size);
 	}
 
 	template<size_t NUM_BYTES>
@@ -183,11 +177,10 @@ public:
 			throw DESERIALIZATION_EXCEPTION("Attempted to read past end of ByteBuffer.");
 		}
 
-		std::vector<unsigned char> data(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + NUM_BYTES);
-
+		const size_t index = m_index;
 		m_index += NUM_BYTES;
 
-		return CBigInteger<NUM_BYTES>(std::move(data));
+		return CBigInteger<NUM_BYTES>(m_bytes.data() + index);
 	}
 
 	std::vector<unsigned char> ReadVector(const uint64_t numBytes)
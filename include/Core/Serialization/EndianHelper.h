@@ -6,6 +6,11 @@
 
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
 
 //
 // A header-only utility for determining and changing endianness of data.
@@ -13,40 +18,76 @@
 class EndianHelper
 {
 public:
-	static bool IsBigEndian() noexcept
+	// Known at compile time, so the byte swapping branches get compiled out.
+	static constexpr bool IsBigEndian() noexcept
 	{
-		union 
-		{
-			uint32_t i;
-			char c[4];
-		} bint = { 0x01020304 };
-
-		return bint.c[0] == 1;
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+		return __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+#else
+		// Visual Studio only targets little-endian platforms.
+		return false;
+#endif
 	}
 
-	// In Visual Studio, _byteswap_ushort could be used.
 	static uint16_t changeEndianness16(const uint16_t val) noexcept
 	{
-		return (val << 8) |          // left-shift always fills with zeros
-			((val >> 8) & 0x00ff); // right-shift sign-extends, so force to zero
+#if defined(_MSC_VER)
+		return _byteswap_ushort(val);
+#else
+		return __builtin_bswap16(val);
+#endif
 	}
 
-	// In Visual Studio, _byteswap_ulong could be used.
 	static uint32_t changeEndianness32(const uint32_t val) noexcept
 	{
-		return (val << 24) |
-			((val << 8) & 0x00ff0000) |
-			((val >> 8) & 0x0000ff00) |
-			((val >> 24) & 0x000000ff);
+#if defined(_MSC_VER)
+		return _byteswap_ulong(val);
+#else
+		return __builtin_bswap32(val);
+#endif
 	}
 
 	static uint64_t changeEndianness64(const uint64_t val) noexcept
 	{
-		uint64_t x = val;
-		x = (x & 0x00000000FFFFFFFF) << 32 | (x & 0xFFFFFFFF00000000) >> 32;
-		x = (x & 0x0000FFFF0000FFFF) << 16 | (x & 0xFFFF0000FFFF0000) >> 16;
-		x = (x & 0x00FF00FF00FF00FF) << 8 | (x & 0xFF00FF00FF00FF00) >> 8;
-		return x;
+#if defined(_MSC_VER)
+		return _byteswap_uint64(val);
+#else
+		return __builtin_bswap64(val);
+#endif
+	}
+
+	//
+	// Reverses NUM_BYTES bytes in place.
+	// The 2, 4, and 8 byte widths compile down to a single bswap, and other widths (eg. IP address arrays) are reversed bytewise.
+	//
+	template <size_t NUM_BYTES>
+	static void Reverse(uint8_t* bytes) noexcept
+	{
+		if constexpr (NUM_BYTES == 2)
+		{
+			uint16_t x;
+			std::memcpy(&x, bytes, 2);
+			x = changeEndianness16(x);
+			std::memcpy(bytes, &x, 2);
+		}
+		else if constexpr (NUM_BYTES == 4)
+		{
+			uint32_t x;
+			std::memcpy(&x, bytes, 4);
+			x = changeEndianness32(x);
+			std::memcpy(bytes, &x, 4);
+		}
+		else if constexpr (NUM_BYTES == 8)
+		{
+			uint64_t x;
+			std::memcpy(&x, bytes, 8);
+			x = changeEndianness64(x);
+			std::memcpy(bytes, &x, 8);
+		}
+		else if constexpr (NUM_BYTES > 1)
+		{
+			std::reverse(bytes, bytes + NUM_BYTES);
+		}
 	}
 
 	static uint16_t GetBigEndian16(const uint16_t val) noexcept
@@ -17,6 +17,10 @@ enum class ESerializeLength
 	NONE
 };
 
+//
+// Writes fields in the consensus serialization format.
+// By default, the bytes are collected into a vector, but subclasses can override Write to send them somewhere else (see Blake2bHasher).
+//
 class Serializer
 {
 public:
@@ -27,79 +31,74 @@ public:
 	{
 		m_serialized.reserve(expectedSize);
 	}
+	virtual ~Serializer() = default;
 
 	template <class T>
 	void Append(const T& t)
 	{
-		std::vector<uint8_t> temp(sizeof(T));
-		memcpy(&temp[0], &t, sizeof(T));
+		uint8_t temp[sizeof(T)];
+		memcpy(temp, &t, sizeof(T));
 
-		if (EndianHelper::IsBigEndian())
+		if constexpr (!EndianHelper::IsBigEndian())
 		{
-			m_serialized.insert(m_serialized.end(), temp.cbegin(), temp.cend());
-		}
-		else
-		{
-			m_serialized.insert(m_serialized.end(), temp.crbegin(), temp.crend());
+			EndianHelper::Reverse<sizeof(T)>(temp);
 		}
+
+		Write(temp, sizeof(T));
 	}
 	template <class T>
 	void AppendLittleEndian(const T& t)
 	{
-		std::vector<uint8_t> temp(sizeof(T));
-		memcpy(&temp[0], &t, sizeof(T));
+		uint8_t temp[sizeof(T)];
+		memcpy(temp, &t, sizeof(T));
 
-		if (EndianHelper::IsBigEndian())
-		{
-			m_serialized.insert(m_serialized.end(), temp.crbegin(), temp.crend());
-		}
-		else
+		if constexpr (EndianHelper::IsBigEndian())
 		{
-			m_serialized.insert(m_serialized.end(), temp.cbegin(), temp.cend());
+			EndianHelper::Reverse<sizeof(T)>(temp);
 		}
+
+		Write(temp, sizeof(T));
 	}
 
 	void AppendBytes(const std::vector<uint8_t>& vectorToAppend, const ESerializeLength prepend_length = ESerializeLength::NONE)
 	{
 		AppendLength(prepend_length, vectorToAppend.size());
 
-		m_serialized.insert(m_serialized.end(), vectorToAppend.cbegin(), vectorToAppend.cend());
+		Write(vectorToAppend.data(), vectorToAppend.size());
 	}
 
 	void AppendByteVector(const std::vector<uint8_t>& vectorToAppend, const ESerializeLength prepend_length = ESerializeLength::NONE)
 	{
 		AppendLength(prepend_length, vectorToAppend.size());
 
-		m_serialized.insert(m_serialized.end(), vectorToAppend.cbegin(), vectorToAppend.cend());
+		Write(vectorToAppend.data(), vectorToAppend.size());
 	}
 
 	void AppendByteVector(const SecureVector& vectorToAppend, const ESerializeLength prepend_length = ESerializeLength::NONE)
 	{
 		AppendLength(prepend_length, vectorToAppend.size());
 
-		m_serialized.insert(m_serialized.end(), vectorToAppend.cbegin(), vectorToAppend.cend());
+		Write(vectorToAppend.data(), vectorToAppend.size());
 	}
 
 	void AppendVarStr(const std::string& varString)
 	{
 		AppendLength(ESerializeLength::U64, varString.length());
 
-		m_serialized.insert(m_serialized.end(), varString.cbegin(), varString.cend());
+		Write((const uint8_t*)varString.data(), varString.length());
 	}
 
 	void AppendStr(const std::string& str, const ESerializeLength prepend_length = ESerializeLength::NONE)
 	{
 		AppendLength(prepend_length, str.length());
 
-		m_serialized.insert(m_serialized.end(), str.cbegin(), str.cend());
+		Write((const uint8_t*)str.data(), str.length());
 	}
 
 	template<size_t NUM_BYTES>
 	void AppendBigInteger(const CBigInteger<NUM_BYTES>& bigInteger)
 	{
-		const std::vector<uint8_t>& data = bigInteger.GetData();
-		//std::reverse(data.begin(), data.end());
-		m_serialized.insert(m_serialized.end(), data.cbegin(), data.cend());
+		Write(bigInteger.data(), bigInteger.size());
 	}
 
 	const std::vector<uint8_t>& GetBytes() const { return m_serialized; }
@@ -118,6 +117,15 @@ public:
 		return secureBytes;
 	}
 
+protected:
+	//
+	// Called with the bytes of every field, in order.
+	//
+	virtual void Write(const uint8_t* data, const size_t len)
+	{
+		m_serialized.insert(m_serialized.end(), data, data + len);
+	}
+
 private:
 	void AppendLength(const ESerializeLength prepend_length, const size_t length)
 	{
@@ -130,4 +138,23 @@ private:
 
 	EProtocolVersion m_protocolVersion;
 	std::vector<uint8_t> m_serialized;
+};
+
+//
+// A Serializer that only counts the bytes written to it.
+// Used to find the exact size of an object before serializing it, so the real Serializer only has to reserve once.
+//
+class SizeCounter final : public Serializer
+{
+public:
+	SizeCounter(const EProtocolVersion protocolVersion = EProtocolVersion::V1)
+		: Serializer(protocolVersion), m_size(0) { }
+
+	size_t GetSize() const noexcept { return m_size; }
+
+protected:
+	void Write(const uint8_t*, const size_t len) final { m_size += len; }
+
+private:
+	size_t m_size;
 };
\ No newline at end of file
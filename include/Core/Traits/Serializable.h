@@ -16,14 +16,20 @@ namespace Traits
 
 		std::vector<unsigned char> Serialized() const
 		{
-			Serializer serializer;
+			SizeCounter sizeCounter;
+			Serialize(sizeCounter);
+
+			Serializer serializer(sizeCounter.GetSize());
 			Serialize(serializer);
 			return serializer.GetBytes();
 		}
 
 		virtual std::vector<unsigned char> SerializeWithIndex(const uint64_t index) const
 		{
-			Serializer serializer;
+			SizeCounter sizeCounter;
+			Serialize(sizeCounter);
+
+			Serializer serializer(sizeof(uint64_t) + sizeCounter.GetSize());
 			serializer.Append<uint64_t>(index);
 			Serialize(serializer);
 			return serializer.GetBytes();
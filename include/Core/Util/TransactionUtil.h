@@ -2,57 +2,114 @@
 
 #include <Core/Models/Transaction.h>
 #include <Crypto/Crypto.h>
+#include <algorithm>
 #include <cassert>
-#include <set>
+#include <utility>
+#include <vector>
 
 class TransactionUtil
 {
 public:
+	//
+	// Removes the inputs that spend outputs in the list, along with those outputs.
+	//
+	// Preconditions: inputs and outputs must be sorted by hash.
+	// An input has the same hash as the output it spends, since both are the hash of the features and commitment,
+	// so this is a single linear pass, like the merge step of a merge sort.
+	//
 	static void PerformCutThrough(std::vector<TransactionInput>& inputs, std::vector<TransactionOutput>& outputs)
 	{
-		std::set<Commitment> inputCommitments;
-		for (const TransactionInput& input : inputs)
-		{
-			inputCommitments.insert(input.GetCommitment());
-		}
-
-		std::set<Commitment> outputCommitments;
-		for (const TransactionOutput& output : outputs)
-		{
-			outputCommitments.insert(output.GetCommitment());
-		}
-
 		auto inputIter = inputs.begin();
-		while (inputIter != inputs.end())
+		auto outputIter = outputs.begin();
+		auto inputEnd = inputs.begin();
+		auto outputEnd = outputs.begin();
+		while (inputIter != inputs.end() && outputIter != outputs.end())
 		{
-			if (outputCommitments.find(inputIter->GetCommitment()) != outputCommitments.end())
+			if (inputIter->GetHash() < outputIter->GetHash())
 			{
-				inputIter = inputs.erase(inputIter);
+				MoveTo(inputIter++, inputEnd++);
+			}
+			else if (outputIter->GetHash() < inputIter->GetHash())
+			{
+				MoveTo(outputIter++, outputEnd++);
 			}
 			else
 			{
 				++inputIter;
+				++outputIter;
 			}
 		}
 
-		auto outputIter = outputs.begin();
+		while (inputIter != inputs.end())
+		{
+			MoveTo(inputIter++, inputEnd++);
+		}
+
 		while (outputIter != outputs.end())
 		{
-			if (inputCommitments.find(outputIter->GetCommitment()) != inputCommitments.end())
+			MoveTo(outputIter++, outputEnd++);
+		}
+
+		inputs.erase(inputEnd, inputs.end());
+		outputs.erase(outputEnd, outputs.end());
+	}
+
+	//
+	// Merges lists that are each sorted by hash into a single list sorted by hash.
+	// If removeDuplicates is set, items with the same hash are only included once.
+	//
+	template <typename T>
+	static std::vector<T> MergeSorted(const std::vector<const std::vector<T>*>& lists, const bool removeDuplicates = false)
+	{
+		using Iter = typename std::vector<T>::const_iterator;
+		using Cursor = std::pair<Iter, Iter>;
+
+		size_t totalSize = 0;
+		std::vector<Cursor> cursors;
+		cursors.reserve(lists.size());
+		for (const std::vector<T>* pList : lists)
+		{
+			if (!pList->empty())
 			{
-				outputIter = outputs.erase(outputIter);
+				cursors.push_back(Cursor(pList->cbegin(), pList->cend()));
+				totalSize += pList->size();
+			}
+		}
+
+		std::vector<T> merged;
+		merged.reserve(totalSize);
+
+		// A min-heap of the cursors, ordered by the hash of the item each points to.
+		const auto greater = [](const Cursor& a, const Cursor& b) { return b.first->GetHash() < a.first->GetHash(); };
+		std::make_heap(cursors.begin(), cursors.end(), greater);
+		while (!cursors.empty())
+		{
+			std::pop_heap(cursors.begin(), cursors.end(), greater);
+
+			Cursor& cursor = cursors.back();
+			if (!removeDuplicates || merged.empty() || merged.back().GetHash() != cursor.first->GetHash())
+			{
+				merged.push_back(*cursor.first);
+			}
+
+			if (++cursor.first == cursor.second)
+			{
+				cursors.pop_back();
 			}
 			else
 			{
-				++outputIter;
+				std::push_heap(cursors.begin(), cursors.end(), greater);
 			}
 		}
+
+		return merged;
 	}
 
 	//
 	// Aggregates multiple transactions into 1.
 	//
-	// Preconditions: transactions must not be empty
+	// Preconditions: transactions must not be empty, and each must be sorted, as any valid transaction is.
+	// The inputs, outputs, and kernels are merged rather than re-sorted, and are each copied exactly once.
 	//
 	static TransactionPtr Aggregate(const std::vector<TransactionPtr>& transactions)
 	{
@@ -63,40 +120,30 @@ public:
 			return transactions.front();
 		}
 
-		std::vector<TransactionInput> inputs;
-		std::vector<TransactionOutput> outputs;
-		std::vector<TransactionKernel> kernels;
+		std::vector<const std::vector<TransactionInput>*> inputLists;
+		std::vector<const std::vector<TransactionOutput>*> outputLists;
+		std::vector<const std::vector<TransactionKernel>*> kernelLists;
 		std::vector<BlindingFactor> kernelOffsets;
+		inputLists.reserve(transactions.size());
+		outputLists.reserve(transactions.size());
+		kernelLists.reserve(transactions.size());
+		kernelOffsets.reserve(transactions.size());
 
-		// collect all the inputs, outputs and kernels from the txs
 		for (const TransactionPtr& pTransaction : transactions)
 		{
-			for (const TransactionInput& input : pTransaction->GetInputs())
-			{
-				inputs.push_back(input);
-			}
-
-			for (const TransactionOutput& output : pTransaction->GetOutputs())
-			{
-				outputs.push_back(output);
-			}
-
-			for (const TransactionKernel& kernel : pTransaction->GetKernels())
-			{
-				kernels.push_back(kernel);
-			}
-
+			inputLists.push_back(&pTransaction->GetInputs());
+			outputLists.push_back(&pTransaction->GetOutputs());
+			kernelLists.push_back(&pTransaction->GetKernels());
 			kernelOffsets.push_back(pTransaction->GetOffset());
 		}
 
+		std::vector<TransactionInput> inputs = MergeSorted(inputLists);
+		std::vector<TransactionOutput> outputs = MergeSorted(outputLists);
+		std::vector<TransactionKernel> kernels = MergeSorted(kernelLists);
+
 		// Perform cut-through
 		TransactionUtil::PerformCutThrough(inputs, outputs);
 
-		// Sort the kernels.
-		std::sort(kernels.begin(), kernels.end(), SortKernelsByHash);
-		std::sort(inputs.begin(), inputs.end(), SortInputsByHash);
-		std::sort(outputs.begin(), outputs.end(), SortOutputsByHash);
-
 		// Sum the kernel_offsets up to give us an aggregate offset for the transaction.
 		BlindingFactor totalKernelOffset = Crypto::AddBlindingFactors(kernelOffsets, std::vector<BlindingFactor>());
 
@@ -107,4 +154,15 @@ public:
 		//   * sum of all kernel offsets
 		return std::make_shared<Transaction>(std::move(totalKernelOffset), TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels)));
 	}
+
+private:
+	template <typename ITER>
+	static void MoveTo(const ITER from, const ITER to)
+	{
+		// Moving an item onto itself would leave it empty.
+		if (from != to)
+		{
+			*to = std::move(*from);
+		}
+	}
 };
\ No newline at end of file
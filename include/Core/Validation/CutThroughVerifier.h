@@ -1,7 +1,8 @@
 #pragma once
 
 #include <Core/Models/TransactionBody.h>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 class CutThroughVerifier
 {
@@ -13,15 +14,20 @@ public:
 
 	static bool VerifyCutThrough(const std::vector<TransactionInput>& inputs, const std::vector<TransactionOutput>& outputs)
 	{
-		std::set<Commitment> commitments;
-		for (auto output : outputs)
+		// A sorted vector of the output commitments, which needs just the one allocation.
+		std::vector<const Commitment*> commitments;
+		commitments.reserve(outputs.size());
+		for (const TransactionOutput& output : outputs)
 		{
-			commitments.insert(output.GetCommitment());
+			commitments.push_back(&output.GetCommitment());
 		}
 
-		for (auto input : inputs)
+		const auto compare = [](const Commitment* pA, const Commitment* pB) { return *pA < *pB; };
+		std::sort(commitments.begin(), commitments.end(), compare);
+
+		for (const TransactionInput& input : inputs)
 		{
-			if (commitments.count(input.GetCommitment()) > 0)
+			if (std::binary_search(commitments.cbegin(), commitments.cend(), &input.GetCommitment(), compare))
 			{
 				return false;
 			}
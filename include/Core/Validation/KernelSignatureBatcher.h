@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Core/Models/TransactionKernel.h>
+#include <Crypto/Commitment.h>
+#include <Crypto/Signature.h>
+#include <Crypto/Hash.h>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Collects the kernel signatures of transactions being validated concurrently (eg. by the txpool and the wallet)
+// into micro-batches, so they share one batch verification instead of each paying for their own.
+//
+// A batch is verified once it holds maxBatchSize signatures, or maxDelay after its first request was queued, whichever comes first.
+// If a batch fails, each request in it is verified on its own, so an invalid transaction doesn't fail the others.
+// Requests that would fill a batch on their own are verified on the calling thread.
+//
+class KernelSignatureBatcher
+{
+public:
+	static const size_t DEFAULT_MAX_BATCH_SIZE = 64;
+	static constexpr std::chrono::microseconds DEFAULT_MAX_DELAY = std::chrono::microseconds(2000);
+
+	static KernelSignatureBatcher& GetInstance();
+
+	KernelSignatureBatcher(const size_t maxBatchSize, const std::chrono::microseconds& maxDelay);
+	~KernelSignatureBatcher();
+
+	//
+	// Queues the kernels' signatures for verification.
+	// The future resolves to true only if all of them are valid.
+	//
+	std::future<bool> Verify(const std::vector<TransactionKernel>& kernels);
+
+private:
+	struct Request
+	{
+		std::vector<Signature> signatures;
+		std::vector<Commitment> commitments;
+		std::vector<Hash> messages;
+		std::promise<bool> promise;
+	};
+
+	void Run();
+	static bool VerifyRequests(const std::vector<std::unique_ptr<Request>>& requests, const size_t begin, const size_t end);
+
+	const size_t m_maxBatchSize;
+	const std::chrono::microseconds m_maxDelay;
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::vector<std::unique_ptr<Request>> m_pending;
+	size_t m_numPending;
+	std::chrono::steady_clock::time_point m_firstQueued;
+	bool m_shutdown;
+
+	std::thread m_thread;
+};
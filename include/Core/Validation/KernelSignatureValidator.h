@@ -9,11 +9,12 @@ class KernelSignatureValidator
 public:
 	static bool VerifyKernelSignature(const TransactionKernel& kernel)
 	{
-		return VerifyKernelSignatures(std::vector<TransactionKernel>({ kernel }));
+		const Hash message = kernel.GetSignatureMessage();
+		return Crypto::VerifyKernelSignatures({ &kernel.GetExcessSignature() }, { &kernel.GetExcessCommitment() }, { &message });
 	}
 
-	// Verify the tx kernels.
-	// No ability to batch verify these right now so just do them individually.
+	// Verify the tx kernels in a single batch.
+	// To share a batch with other transactions being validated concurrently, use KernelSignatureBatcher instead.
 	static bool VerifyKernelSignatures(const std::vector<TransactionKernel>& kernels)
 	{
 		std::vector<const Commitment*> commitments;
@@ -30,45 +30,41 @@ public:
 		auto getKernelCommitments = [](TransactionKernel& kernel) -> Commitment { return kernel.GetExcessCommitment(); };
 		std::vector<Commitment> kernelCommitments = FunctionalUtil::map<std::vector<Commitment>>(transactionBody.GetKernels(), getKernelCommitments);
 
-		return ValidateKernelSums(inputCommitments, outputCommitments, kernelCommitments, overage, kernelOffset, blockSumsOpt);
+		return ValidateKernelSums(
+			std::move(inputCommitments),
+			std::move(outputCommitments),
+			std::move(kernelCommitments),
+			overage,
+			kernelOffset,
+			blockSumsOpt
+		);
 	}
 
+	//
+	// The previous block's sums, the overage and the offset are all folded into the secp256k1 sums as parsed points,
+	// so the only commitments serialized are the two returned in the BlockSums, plus the kernel sum with the offset (when there is one) for comparison.
+	//
 	static BlockSums ValidateKernelSums(
-		const std::vector<Commitment>& inputs,
-		const std::vector<Commitment>& outputs,
-		const std::vector<Commitment>& kernels,
+		std::vector<Commitment> inputs,
+		std::vector<Commitment> outputs,
+		std::vector<Commitment> kernels,
 		const int64_t overage,
 		const BlindingFactor& kernelOffset,
 		const std::optional<BlockSums>& blockSumsOpt)
 	{
-		std::vector<Commitment> inputCommitments = inputs;
-		std::vector<Commitment> outputCommitments = outputs;
-		if (overage > 0)
-		{
-			outputCommitments.push_back(Crypto::CommitTransparent(overage));
-		}
-		else if (overage < 0)
-		{
-			inputCommitments.push_back(Crypto::CommitTransparent(0 - overage));
-		}
-
 		if (blockSumsOpt.has_value())
 		{
-			outputCommitments.push_back(blockSumsOpt.value().GetOutputSum());
+			outputs.push_back(blockSumsOpt.value().GetOutputSum());
+			kernels.push_back(blockSumsOpt.value().GetKernelSum());
 		}
 
 		// Sum all input|output|overage commitments.
-		Commitment utxoSum = Crypto::AddCommitments(outputCommitments, inputCommitments);
+		Commitment utxoSum = Crypto::AddCommitments(outputs, inputs, overage, BlindingFactor(ZERO_HASH));
 
 		// Sum the kernel excesses accounting for the kernel offset.
-		std::vector<Commitment> kernelCommitments = kernels;
-		if (blockSumsOpt.has_value())
-		{
-			kernelCommitments.push_back(blockSumsOpt.value().GetKernelSum());
-		}
-
-		Commitment kernelSum = Crypto::AddCommitments(kernelCommitments, std::vector<Commitment>());
-		Commitment kernelSumPlusOffset = AddKernelOffset(kernelSum, kernelOffset);
+		Commitment kernelSum = Crypto::AddCommitments(kernels, std::vector<Commitment>());
+		const bool hasOffset = kernelOffset.GetBytes() != CBigInteger<32>::ValueOf(0);
+		Commitment kernelSumPlusOffset = hasOffset ? Crypto::AddCommitments({ kernelSum }, std::vector<Commitment>(), 0, kernelOffset) : kernelSum;
 		if (utxoSum != kernelSumPlusOffset) {
 			LOG_ERROR_F(
 				"UTXO sum {} does not match kernel sum plus offset {}. Kernel sum is {} and offset is {}.",
@@ -80,21 +76,6 @@ public:
 			throw BAD_DATA_EXCEPTION("UTXO sum does not match kernel sum plus offset");
 		}
 
-		return BlockSums(utxoSum, kernelSum);
-	}
-
-private:
-	static Commitment AddKernelOffset(const Commitment& kernelSum, const BlindingFactor& totalKernelOffset)
-	{
-		// Add the commitments along with the commit to zero built from the offset
-		std::vector<Commitment> commitments;
-		commitments.push_back(kernelSum);
-
-		if (totalKernelOffset.GetBytes() != CBigInteger<32>::ValueOf(0))
-		{
-			commitments.push_back(Crypto::CommitBlinded((uint64_t)0, totalKernelOffset));
-		}
-
-		return Crypto::AddCommitments(commitments, std::vector<Commitment>());
+		return BlockSums(std::move(utxoSum), std::move(kernelSum));
 	}
 };
\ No newline at end of file
@@ -1,15 +1,51 @@
 #pragma once
 
 #include <Core/Models/TransactionBody.h>
+#include <Core/Exceptions/BadDataException.h>
+#include <algorithm>
+#include <iterator>
 
 class TransactionBodyValidator
 {
 public:
 	void Validate(const TransactionBody& transactionBody, const bool withReward);
 
+	//
+	// Validates everything except the rangeproofs and kernel signatures, so they can be batch verified separately.
+	//
+	void ValidateStructure(const TransactionBody& transactionBody, const bool withReward);
+
+	//
+	// Throws a BadDataException if any of the outputs' rangeproofs are invalid.
+	//
+	void VerifyRangeProofs(const std::vector<TransactionOutput>& outputs);
+
 private:
 	void ValidateWeight(const TransactionBody& transactionBody, const bool withReward);
-	void VerifySorted(const TransactionBody& transactionBody);
-	void VerifyCutThrough(const TransactionBody& transactionBody);
-	void VerifyRangeProofs(const std::vector<TransactionOutput>& outputs);
+	void VerifySortedAndCutThrough(const TransactionBody& transactionBody);
+
+	static Hash HashWithFeatures(const EOutputFeatures features, const Commitment& commitment);
+
+	template <typename ITER>
+	static void VerifyNextIsGreater(const ITER iter, const ITER end)
+	{
+		const ITER next = std::next(iter);
+		if (next != end && !(iter->GetHash() < next->GetHash()))
+		{
+			throw BAD_DATA_EXCEPTION("Inputs, outputs, and/or kernels not sorted and unique.");
+		}
+	}
+
+	// Requires the items to be sorted by hash.
+	template <typename T>
+	static bool ContainsHash(const std::vector<T>& items, const Hash& hash)
+	{
+		auto iter = std::lower_bound(
+			items.cbegin(),
+			items.cend(),
+			hash,
+			[](const T& item, const Hash& value) { return item.GetHash() < value; }
+		);
+		return iter != items.cend() && iter->GetHash() == hash;
+	}
 };
\ No newline at end of file
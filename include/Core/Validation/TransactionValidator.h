@@ -1,13 +1,23 @@
 #pragma once
 
 #include <Core/Models/Transaction.h>
+#include <vector>
 
 class TransactionValidator
 {
 public:
 	void Validate(const Transaction& transaction) const;
 
+	//
+	// Validates each of the transactions, verifying the rangeproofs and kernel signatures of all of them in a single batch.
+	// If the batch fails, the proofs are verified one transaction at a time to find the invalid ones.
+	// Returns true for each transaction that's valid.
+	//
+	std::vector<bool> ValidateBatch(const std::vector<TransactionPtr>& transactions) const;
+
 private:
+	bool VerifyProofs(const std::vector<TransactionPtr>& transactions) const;
+	bool VerifyRangeProofs(const std::vector<TransactionPtr>& transactions) const;
 	void ValidateFeatures(const TransactionBody& transactionBody) const;
 	void ValidateKernelSums(const Transaction& transaction) const;
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Core/Serialization/Serializer.h>
+#include <Crypto/Hash.h>
+
+//
+// A Serializer that hashes the fields with Blake2b as they're appended, instead of collecting them into a vector.
+//
+// Serializing an object into a Blake2bHasher and calling Finalize() gives the same hash as
+// calling Hasher::Blake2b on the bytes of a regular Serializer, without the intermediate buffer.
+// GetBytes() is always empty.
+//
+class Blake2bHasher : public Serializer
+{
+public:
+	Blake2bHasher(const EProtocolVersion protocolVersion = EProtocolVersion::V1);
+
+	//
+	// Returns the 32 byte hash of everything appended so far.
+	// The hasher can't be used after this is called.
+	//
+	Hash Finalize();
+
+	//
+	// Hashes the serialized form of the given object, eg. Blake2bHasher::Compute(kernel).
+	//
+	template <class T>
+	static Hash Compute(const T& serializable, const EProtocolVersion protocolVersion = EProtocolVersion::V1)
+	{
+		Blake2bHasher hasher(protocolVersion);
+		serializable.Serialize(hasher);
+		return hasher.Finalize();
+	}
+
+protected:
+	void Write(const uint8_t* data, const size_t len) final;
+
+private:
+	// Storage for libsodium's crypto_generichash_blake2b_state, so sodium's headers aren't needed here.
+	alignas(64) unsigned char m_state[384];
+};
@@ -46,6 +46,17 @@ public:
 		const std::vector<Commitment>& negative
 	);
 
+	//
+	// Adds the homomorphic pedersen commitments together, along with a commitment to the (possibly negative) value and blinding factor.
+	// The extra commitment is added as a parsed point, so only the sum gets serialized.
+	//
+	static Commitment AddCommitments(
+		const std::vector<Commitment>& positive,
+		const std::vector<Commitment>& negative,
+		const int64_t value,
+		const BlindingFactor& blindingFactor
+	);
+
 	//
 	// Takes a vector of blinding factors and calculates an additional blinding value that adds to zero.
 	//
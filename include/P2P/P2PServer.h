@@ -10,6 +10,7 @@
 #include <P2P/SyncStatus.h>
 #include <P2P/Peer.h>
 #include <P2P/ConnectedPeer.h>
+#include <P2P/TransactionQueueStats.h>
 #include <TxPool/TransactionPool.h>
 #include <Database/Database.h>
 #include <optional>
@@ -41,6 +42,11 @@ public:
 	//
 	virtual std::pair<size_t, size_t> GetNumberOfConnectedPeers() const = 0;
 
+	//
+	// Returns the depth and totals of the queue of transactions received from peers.
+	//
+	virtual TransactionQueueStats GetTransactionQueueStats() const = 0;
+
 	virtual std::vector<PeerConstPtr> GetAllPeers() const = 0;
 
 	virtual std::vector<ConnectedPeer> GetConnectedPeers() const = 0;
@@ -61,6 +67,11 @@ public:
 	virtual bool UnbanAllPeers() = 0;
 
 	virtual void BroadcastTransaction(const TransactionPtr& pTransaction) = 0;
+
+	//
+	// Relays a transaction that was just added to the stempool along the Dandelion stem.
+	//
+	virtual void StemTransaction(const TransactionPtr& pTransaction) = 0;
 };
 
 typedef std::shared_ptr<IP2PServer> IP2PServerPtr;
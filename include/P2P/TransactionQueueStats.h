@@ -0,0 +1,62 @@
+#pragma once
+
+#include <json/json.h>
+#include <cstdint>
+
+//
+// A snapshot of the queue of transactions received from peers that are waiting to be validated.
+//
+class TransactionQueueStats
+{
+public:
+	TransactionQueueStats(
+		const uint64_t depth,
+		const uint64_t inFlight,
+		const uint64_t numPeers,
+		const uint64_t numProcessed,
+		const uint64_t numDuplicates,
+		const uint64_t numDropped)
+		: m_depth(depth),
+		m_inFlight(inFlight),
+		m_numPeers(numPeers),
+		m_numProcessed(numProcessed),
+		m_numDuplicates(numDuplicates),
+		m_numDropped(numDropped)
+	{
+
+	}
+
+	// The number of transactions waiting to be picked up by a worker.
+	uint64_t GetDepth() const noexcept { return m_depth; }
+
+	// The number of transactions currently being validated.
+	uint64_t GetInFlight() const noexcept { return m_inFlight; }
+
+	// The number of peers with transactions waiting.
+	uint64_t GetNumPeers() const noexcept { return m_numPeers; }
+
+	// Totals since startup.
+	uint64_t GetNumProcessed() const noexcept { return m_numProcessed; }
+	uint64_t GetNumDuplicates() const noexcept { return m_numDuplicates; }
+	uint64_t GetNumDropped() const noexcept { return m_numDropped; }
+
+	Json::Value ToJSON() const
+	{
+		Json::Value json;
+		json["depth"] = m_depth;
+		json["in_flight"] = m_inFlight;
+		json["peers"] = m_numPeers;
+		json["processed"] = m_numProcessed;
+		json["duplicates"] = m_numDuplicates;
+		json["dropped"] = m_numDropped;
+		return json;
+	}
+
+private:
+	uint64_t m_depth;
+	uint64_t m_inFlight;
+	uint64_t m_numPeers;
+	uint64_t m_numProcessed;
+	uint64_t m_numDuplicates;
+	uint64_t m_numDropped;
+};
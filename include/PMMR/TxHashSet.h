@@ -9,6 +9,8 @@
 #include <Core/Traits/Batchable.h>
 #include <BlockChain/Chain.h>
 #include <Crypto/Hash.h>
+#include <atomic>
+#include <functional>
 
 // Forward Declarations
 class Config;
@@ -18,9 +20,36 @@ class OutputIdentifier;
 class IBlockChain;
 class IBlockDB;
 class Transaction;
+class TransactionInput;
 class TransactionBody;
 class SyncStatus;
 
+//
+// A compaction of the output and rangeproof PMMRs, started by ITxHashSet::PrepareCompaction().
+// Compaction is split up so that block processing is only blocked while preparing and finishing it:
+// 1. PrepareCompaction() records the horizon. Requires the TxHashSet write lock.
+// 2. Write() writes compacted copies of everything below the horizon. Doesn't require any locks.
+// 3. FinishCompaction() copies everything after the horizon, and swaps in the new files. Requires the TxHashSet write lock.
+//
+class ITxHashSetCompaction
+{
+public:
+	using Ptr = std::shared_ptr<ITxHashSetCompaction>;
+
+	virtual ~ITxHashSetCompaction() = default;
+
+	//
+	// Returns the total number of bytes Write() will read.
+	//
+	virtual uint64_t GetTotalBytes() const noexcept = 0;
+
+	//
+	// Writes the compacted files, calling onProgress with the number of bytes read since the last call.
+	// Returns false if there was nothing to compact, or if terminate was set before it finished.
+	//
+	virtual bool Write(const std::function<void(const uint64_t)>& onProgress, const std::atomic_bool& terminate) = 0;
+};
+
 class ITxHashSet : public Traits::IBatchable
 {
 public:
@@ -53,6 +82,22 @@ public:
 		const Transaction& transaction
 	) const = 0;
 
+	//
+	// Returns true if the input spends an output in the UTXO set, and it's mature if it's a coinbase.
+	//
+	virtual bool IsUnspent(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const TransactionInput& input
+	) const = 0;
+
+	//
+	// Returns true if the output's commitment isn't already in the UTXO set.
+	//
+	virtual bool IsUnique(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		const TransactionOutput& output
+	) const = 0;
+
 	//
 	// Appends all new kernels, outputs, and rangeproofs to the MMRs, and prunes all of the inputs.
 	//
@@ -130,19 +175,43 @@ public:
 	) = 0;
 
 	//
-	// Flushes all changes to disk.
+	// Commits all changes. Once this returns, the changes are durable,
+	// but they may only be in the write-ahead log until the background flusher writes them to the PMMR files.
 	//
 	virtual void Commit() = 0;
 
+	//
+	// Synchronously writes all committed changes to the PMMR files.
+	//
+	virtual void Flush() = 0;
+
+	//
+	// Flushes all committed changes, then copies the PMMR files to the destination directory.
+	// The background flusher can't touch the files until the copy is done, so the copy is never torn.
+	//
+	virtual void FlushAndCopy(const fs::path& destination) = 0;
+
 	//
 	// Discards all changes since the last commit.
 	//
 	virtual void Rollback() noexcept = 0;
 
 	//
-	// Removes pruned leaves and hashes from the output and rangeproof PMMRs to reduce disk usage.
+	// Starts compacting the output and rangeproof PMMRs, which removes the data and hashes of spent outputs before the horizon.
+	//
+	virtual ITxHashSetCompaction::Ptr PrepareCompaction(const BlockHeader& horizonHeader) = 0;
+
+	//
+	// Swaps in the files written by the compaction. Returns the number of bytes reclaimed.
+	// Any PMMR that was rewound before the horizon since PrepareCompaction() is left as is.
+	//
+	virtual uint64_t FinishCompaction(const ITxHashSetCompaction::Ptr& pCompaction) = 0;
+
+	//
+	// Returns the height of the horizon the output and rangeproof PMMRs were last compacted up to, or 0 if they never were.
+	// It's saved with the TxHashSet, so restarting doesn't cause an unnecessary compaction.
 	//
-	virtual void Compact() = 0;
+	virtual uint64_t GetCompactedHeight() const = 0;
 };
 
 typedef std::shared_ptr<ITxHashSet> ITxHashSetPtr;
@@ -33,6 +33,21 @@ public:
 		const BlockHeader& previousHeader
 	) const;
 
+	//
+	// Validates the difficulty of the header's proof of work, but not the cuckoo cycle itself.
+	//
+	bool IsDifficultyValid(
+		const BlockHeader& header,
+		const BlockHeader& previousHeader
+	) const;
+
+	//
+	// Verifies the cuckoo cycles of all of the headers at once, which is much faster than one at a time.
+	// The cycles don't depend on the chain, so this can be called before any of the previous headers are validated.
+	// Returns true if all of the proofs are valid.
+	//
+	bool AreProofsValid(const std::vector<BlockHeaderPtr>& headers) const;
+
 private:
 	const Config& m_config;
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
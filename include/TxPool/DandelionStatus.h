@@ -2,13 +2,13 @@
 
 enum class EDandelionStatus
 {
-	// Tx to be included in the next "stem" run.
+	// Tx waiting to be relayed along the stem.
 	TO_STEM,
 
 	// Tx previously "stemmed" and propagated.
 	STEMMED,
 
-	// Tx to be included in the next "fluff" run.
+	// Tx to be aggregated and broadcast when the patience timer fires.
 	TO_FLUFF,
 
 	// Tx previously "fluffed" and broadcast.
@@ -71,6 +71,19 @@ public:
 		const BlockHeader& lastConfirmedBlock
 	) = 0;
 
+	//
+	// Validates and adds the transactions to the specified pool, returning the status of each as described for AddTransaction.
+	// Only the UTXO checks and insertion are done while holding the pool's write lock.
+	// The rest of the validation is done beforehand on worker threads, with the rangeproofs and kernel signatures batch verified.
+	//
+	virtual std::vector<EAddTransactionStatus> AddTransactions(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const std::vector<TransactionPtr>& transactions,
+		const EPoolType poolType,
+		const BlockHeader& lastConfirmedBlock
+	) = 0;
+
 	virtual std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const = 0;
 	virtual TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const = 0;
 	virtual void ReconcileBlock(
@@ -79,16 +92,37 @@ public:
 		const FullBlock& block
 	) = 0;
 
+	//
+	// Picks the mempool txs with the highest fee rates that fit within the given block weight.
+	// Txs that depend on others in the mempool are returned after them.
+	//
+	virtual std::vector<TransactionPtr> GetBlockTemplate(const uint64_t maxWeight) const = 0;
+
+	//
 	// Dandelion
-	virtual TransactionPtr GetTransactionToStem(
-		std::shared_ptr<const IBlockDB> pBlockDB,
-		ITxHashSetConstPtr pTxHashSet
+	//
+
+	//
+	// Sets the status of the stempool txs, eg. once they've been relayed along the stem, or are waiting to be fluffed.
+	//
+	virtual void ChangeStemStatus(
+		const std::vector<TransactionPtr>& transactions,
+		const EDandelionStatus status
 	) = 0;
+
+	//
+	// Aggregates the stempool txs that are waiting to be fluffed, and adds the aggregate to the mempool.
+	// Returns the aggregate to broadcast, or nullptr if none of them are still valid.
+	//
 	virtual TransactionPtr GetTransactionToFluff(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet
 	) = 0;
-	virtual std::vector<TransactionPtr> GetExpiredTransactions() const = 0;
+
+	//
+	// Returns the tx if it's still in the stempool, ie. it hasn't been fluffed, or seen in the mempool or a block.
+	//
+	virtual TransactionPtr GetStemTransaction(const Hash& txHash) const = 0;
 };
 
 namespace TxPoolAPI
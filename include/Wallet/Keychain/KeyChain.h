@@ -49,4 +49,8 @@ private:
 	const Config& m_config;
 	PrivateExtKey m_masterKey;
 	SecretKey m_bulletProofNonce;
+
+	// Hashes the ENHANCED nonces are derived from. They're computed once, since restoring a wallet rewinds every output in the chain.
+	SecretKey m_privateNonceHash;
+	SecretKey m_rewindNonceHash;
 };
\ No newline at end of file
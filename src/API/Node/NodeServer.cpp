@@ -5,8 +5,13 @@
 #include <API/Node/Handlers/GetVersionHandler.h>
 #include <API/Node/Handlers/GetTipHandler.h>
 #include <API/Node/Handlers/PushTransactionHandler.h>
+#include <API/Node/Handlers/GetBlockTemplateHandler.h>
 
-NodeServer::UPtr NodeServer::Create(const ServerPtr& pServer, const IBlockChain::Ptr& pBlockChain, const IP2PServerPtr& pP2PServer)
+NodeServer::UPtr NodeServer::Create(
+    const ServerPtr& pServer,
+    const IBlockChain::Ptr& pBlockChain,
+    const IP2PServerPtr& pP2PServer,
+    const ITransactionPool::Ptr& pTransactionPool)
 {
     RPCServer::Ptr pForeignServer = RPCServer::Create(pServer, "/v2/foreign", LoggerAPI::LogFile::NODE);
     pForeignServer->AddMethod("get_header", std::make_shared<GetHeaderHandler>(pBlockChain));
@@ -16,6 +21,7 @@ NodeServer::UPtr NodeServer::Create(const ServerPtr& pServer, const IBlockChain:
     pForeignServer->AddMethod("push_transaction", std::make_shared<PushTransactionHandler>(pBlockChain, pP2PServer));
 
     RPCServer::Ptr pOwnerServer = RPCServer::Create(pServer, "/v2/owner", LoggerAPI::LogFile::NODE);
+    pOwnerServer->AddMethod("get_block_template", std::make_shared<GetBlockTemplateHandler>(pTransactionPool));
 
     return std::make_unique<NodeServer>(pForeignServer, pOwnerServer);
 }
\ No newline at end of file
@@ -29,7 +29,8 @@ BlockChain::BlockChain(
 	m_pTxHashSetManager(pTxHashSetManager),
 	m_pTransactionPool(pTransactionPool),
 	m_pChainState(pChainState),
-	m_pHeaderMMR(pHeaderMMR)
+	m_pHeaderMMR(pHeaderMMR),
+	m_pCompactor(TxHashSetCompactor::Create(pChainState))
 {
 
 }
@@ -55,7 +56,7 @@ std::shared_ptr<BlockChain> BlockChain::Create(
 		genesisBlock
 	);
 
-	// Trigger Compaction
+	// Close the TxHashSet if it's too far behind to catch up. Compaction happens in the background.
 	{
 		auto pBatch = pTxHashSetManager->BatchWrite();
 		auto pTxHashSet = pBatch->GetTxHashSet();
@@ -66,10 +67,6 @@ std::shared_ptr<BlockChain> BlockChain::Create(
 			{
 				pTxHashSetManager->Write()->Close();
 			}
-			else
-			{
-				pTxHashSet->Compact();
-			}
 
 			pBatch->Commit();
 		}
@@ -147,8 +144,7 @@ EBlockChainStatus BlockChain::AddCompactBlock(const CompactBlock& compactBlock)
 
 	{
 		auto pReader = m_pChainState->Read();
-		auto pConfirmed = pReader->GetChainStore()->GetConfirmedChain()->GetByHeight(height);
-		if (pConfirmed != nullptr && pConfirmed->GetHash() == hash)
+		if (pReader->GetChainStore()->GetConfirmedChain()->IsOnChain(height, hash))
 		{
 			return EBlockChainStatus::ALREADY_EXISTS;
 		}
@@ -209,30 +205,37 @@ EBlockChainStatus BlockChain::ProcessTransactionHashSet(const Hash& blockHash, c
 
 EBlockChainStatus BlockChain::AddTransaction(TransactionPtr pTransaction, const EPoolType poolType)
 {
+	return AddTransactions({ pTransaction }, poolType).front();
+}
+
+std::vector<EBlockChainStatus> BlockChain::AddTransactions(const std::vector<TransactionPtr>& transactions, const EPoolType poolType)
+{
+	std::vector<EBlockChainStatus> results(transactions.size(), EBlockChainStatus::INVALID);
+
 	try
 	{
 		auto pReader = m_pChainState->Read();
 		auto pLastConfimedHeader = pReader->GetTipBlockHeader(EChainType::CONFIRMED);
 		if (pLastConfimedHeader != nullptr)
 		{
-			const EAddTransactionStatus status = m_pTransactionPool->AddTransaction(
+			const std::vector<EAddTransactionStatus> statuses = m_pTransactionPool->AddTransactions(
 				pReader->GetBlockDB().GetShared(),
 				pReader->GetTxHashSetManager()->GetTxHashSet(),
-				pTransaction,
+				transactions,
 				poolType,
 				*pLastConfimedHeader
 			);
-			if (status == EAddTransactionStatus::ADDED)
-			{
-				return EBlockChainStatus::SUCCESS;
-			}
-			else if (status == EAddTransactionStatus::TX_INVALID)
-			{
-				return EBlockChainStatus::INVALID;
-			}
-			else
+
+			for (size_t i = 0; i < statuses.size(); i++)
 			{
-				return EBlockChainStatus::UNKNOWN_ERROR;
+				if (statuses[i] == EAddTransactionStatus::ADDED)
+				{
+					results[i] = EBlockChainStatus::SUCCESS;
+				}
+				else if (statuses[i] != EAddTransactionStatus::TX_INVALID)
+				{
+					results[i] = EBlockChainStatus::UNKNOWN_ERROR;
+				}
 			}
 		}
 	}
@@ -241,7 +244,7 @@ EBlockChainStatus BlockChain::AddTransaction(TransactionPtr pTransaction, const
 		LOG_ERROR_F("Exception thrown: {}", e.what());
 	}
 
-	return EBlockChainStatus::INVALID;
+	return results;
 }
 
 TransactionPtr BlockChain::GetTransactionByKernelHash(const Hash& kernelHash) const
@@ -373,10 +376,8 @@ std::vector<BlockWithOutputs> BlockChain::GetOutputsByHeight(const uint64_t star
 bool BlockChain::HasBlock(const uint64_t height, const Hash& hash) const
 {
 	auto pChainStateReader = m_pChainState->Read();
-	
-	auto pIndex = pChainStateReader->GetChainStore()->GetConfirmedChain()->GetByHeight(height);
 
-	return pIndex != nullptr && pIndex->GetHash() == hash;
+	return pChainStateReader->GetChainStore()->GetConfirmedChain()->IsOnChain(height, hash);
 }
 
 std::vector<std::pair<uint64_t, Hash>> BlockChain::GetBlocksNeeded(const uint64_t maxNumBlocks) const
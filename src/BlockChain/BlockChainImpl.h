@@ -2,6 +2,7 @@
 
 #include "ChainState.h"
 #include "ChainStore.h"
+#include "TxHashSetCompactor.h"
 
 #include <TxPool/TransactionPool.h>
 #include <BlockChain/BlockChain.h>
@@ -42,6 +43,7 @@ public:
 	fs::path SnapshotTxHashSet(BlockHeaderPtr pBlockHeader) final;
 	EBlockChainStatus ProcessTransactionHashSet(const Hash& blockHash, const fs::path& path, SyncStatus& syncStatus) final;
 	EBlockChainStatus AddTransaction(TransactionPtr pTransaction, const EPoolType poolType) final;
+	std::vector<EBlockChainStatus> AddTransactions(const std::vector<TransactionPtr>& transactions, const EPoolType poolType) final;
 	TransactionPtr GetTransactionByKernelHash(const Hash& kernelHash) const final;
 
 	BlockHeaderPtr GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const final;
@@ -77,4 +79,5 @@ private:
 	std::shared_ptr<ITransactionPool> m_pTransactionPool;
 	std::shared_ptr<Locked<ChainState>> m_pChainState;
 	std::shared_ptr<Locked<IHeaderMMR>> m_pHeaderMMR;
+	std::unique_ptr<TxHashSetCompactor> m_pCompactor;
 };
@@ -1,8 +1,6 @@
 #include "BlockHydrator.h"
 
 #include <Core/Util/TransactionUtil.h>
-#include <Core/Validation/CutThroughVerifier.h>
-#include <unordered_set>
 
 BlockHydrator::BlockHydrator(std::shared_ptr<const ITransactionPool> pTransactionPool)
 	: m_pTransactionPool(pTransactionPool)
@@ -35,72 +33,33 @@ std::unique_ptr<FullBlock> BlockHydrator::Hydrate(const CompactBlock& compactBlo
 
 std::unique_ptr<FullBlock> BlockHydrator::Hydrate(const CompactBlock& compactBlock, const std::vector<TransactionPtr>& transactions) const
 {
-	std::unordered_set<Hash> inputsSet;
-	std::unordered_set<Hash> outputsSet;
-	std::unordered_set<Hash> kernelsSet;
-
-	std::vector<TransactionInput> allInputs;
-	std::vector<TransactionOutput> allOutputs;
-	std::vector<TransactionKernel> allKernels;
+	std::vector<const std::vector<TransactionInput>*> inputLists;
+	std::vector<const std::vector<TransactionOutput>*> outputLists;
+	std::vector<const std::vector<TransactionKernel>*> kernelLists;
+	inputLists.reserve(transactions.size());
+	outputLists.reserve(transactions.size() + 1);
+	kernelLists.reserve(transactions.size() + 1);
 
 	// collect all the inputs, outputs and kernels from the txs
-	for (TransactionPtr pTransaction : transactions)
+	for (const TransactionPtr& pTransaction : transactions)
 	{
-		for (const TransactionInput& input : pTransaction->GetInputs())
-		{
-			if (inputsSet.count(input.GetHash()) == 0)
-			{
-				inputsSet.insert(input.GetHash());
-				allInputs.push_back(input);
-			}
-		}
-
-		for (const TransactionOutput& output : pTransaction->GetOutputs())
-		{
-			if (outputsSet.count(output.GetHash()) == 0)
-			{
-				outputsSet.insert(output.GetHash());
-				allOutputs.push_back(output);
-			}
-		}
-
-		for (const TransactionKernel& kernel : pTransaction->GetKernels())
-		{
-			if (kernelsSet.count(kernel.GetHash()) == 0)
-			{
-				kernelsSet.insert(kernel.GetHash());
-				allKernels.push_back(kernel);
-			}
-		}
+		inputLists.push_back(&pTransaction->GetInputs());
+		outputLists.push_back(&pTransaction->GetOutputs());
+		kernelLists.push_back(&pTransaction->GetKernels());
 	}
 
 	// include the coinbase output(s) and kernel(s) from the compact_block
-	for (const TransactionOutput& output : compactBlock.GetOutputs())
-	{
-		if (outputsSet.count(output.GetHash()) == 0)
-		{
-			outputsSet.insert(output.GetHash());
-			allOutputs.push_back(output);
-		}
-	}
+	outputLists.push_back(&compactBlock.GetOutputs());
+	kernelLists.push_back(&compactBlock.GetKernels());
 
-	for (const TransactionKernel& kernel : compactBlock.GetKernels())
-	{
-		if (kernelsSet.count(kernel.GetHash()) == 0)
-		{
-			kernelsSet.insert(kernel.GetHash());
-			allKernels.push_back(kernel);
-		}
-	}
+	// Merge the sorted lists, skipping duplicates.
+	std::vector<TransactionInput> allInputs = TransactionUtil::MergeSorted(inputLists, true);
+	std::vector<TransactionOutput> allOutputs = TransactionUtil::MergeSorted(outputLists, true);
+	std::vector<TransactionKernel> allKernels = TransactionUtil::MergeSorted(kernelLists, true);
 
 	// Perform cut-through.
 	TransactionUtil::PerformCutThrough(allInputs, allOutputs);
 
-	// Sort allInputs, allOutputs, and allKernels.
-	std::sort(allInputs.begin(), allInputs.end(), SortInputsByHash);
-	std::sort(allOutputs.begin(), allOutputs.end(), SortOutputsByHash);
-	std::sort(allKernels.begin(), allKernels.end(), SortKernelsByHash);
-
 	// Create a Transaction Body.
 	TransactionBody transactionBody(std::move(allInputs), std::move(allOutputs), std::move(allKernels));
 
@@ -4,21 +4,17 @@
 
 Chain::Chain(
 	const EChainType chainType,
-	std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
-	std::shared_ptr<DataFile<32>> pDataFile,
-	std::vector<std::shared_ptr<const BlockIndex>>&& indices)
+	std::shared_ptr<DataFile<32>> pDataFile)
 	: m_chainType(chainType),
-	m_pBlockIndexAllocator(pBlockIndexAllocator),
+	m_height(pDataFile->GetSize() - 1),
+	m_pDataFile(pDataFile),
 	m_dataFile(pDataFile),
-	m_dataFileWriter(),
-	m_indices(std::move(indices)),
-	m_height(m_indices.size() - 1)
+	m_dataFileWriter()
 {
 
 }
 
 std::shared_ptr<Chain> Chain::Load(
-	std::shared_ptr<BlockIndexAllocator> pBlockIndexAllocator,
 	const EChainType chainType,
 	const fs::path& path,
 	std::shared_ptr<const BlockIndex> pGenesisIndex)
@@ -32,23 +28,14 @@ std::shared_ptr<Chain> Chain::Load(
 		pDataFile->Commit();
 	}
 
-	std::vector<std::shared_ptr<const BlockIndex>> indices;
-	indices.push_back(pGenesisIndex);
-
-	while (indices.size() < pDataFile->GetSize())
-	{
-		Hash hash = pDataFile->GetDataAt(indices.size());
-		indices.emplace_back(pBlockIndexAllocator->GetOrCreateIndex(std::move(hash), indices.size()));
-	}
-
-	return std::shared_ptr<Chain>(new Chain(chainType, pBlockIndexAllocator, pDataFile, std::move(indices)));
+	return std::shared_ptr<Chain>(new Chain(chainType, pDataFile));
 }
 
 std::shared_ptr<const BlockIndex> Chain::GetByHeight(const uint64_t height) const
 {
-	if (m_height >= height && m_indices.size() > height)
+	if (height <= m_height)
 	{
-		return m_indices[height];
+		return std::make_shared<const BlockIndex>(GetHash(height), height);
 	}
 
 	return nullptr;
@@ -64,14 +51,10 @@ std::shared_ptr<const BlockIndex> Chain::AddBlock(const Hash& hash, const uint64
 
 	SetDirty(true);
 
-	std::shared_ptr<const BlockIndex> pBlockIndex = m_pBlockIndexAllocator->GetOrCreateIndex(hash, height);
-	m_indices.push_back(pBlockIndex);
-
-	const auto bytes = pBlockIndex->GetHash().GetData();
-	m_dataFileWriter->AddData(bytes);
+	m_dataFileWriter->AddData(hash.GetData());
 
 	++m_height;
-	return pBlockIndex;
+	return std::make_shared<const BlockIndex>(hash, height);
 }
 
 void Chain::Rewind(const uint64_t lastHeight)
@@ -84,7 +67,6 @@ void Chain::Rewind(const uint64_t lastHeight)
 	if (m_height > lastHeight)
 	{
 		SetDirty(true);
-		m_indices.erase(m_indices.begin() + lastHeight + 1, m_indices.end());
 
 		m_dataFileWriter->Rewind(lastHeight + 1);
 		m_height = lastHeight;
@@ -106,15 +88,7 @@ void Chain::Rollback() noexcept
 	if (IsDirty())
 	{
 		m_dataFileWriter->Rollback();
-		m_indices.clear();
-
-		while (m_indices.size() < m_dataFileWriter->GetSize())
-		{
-			Hash hash = m_dataFileWriter->GetDataAt(m_indices.size());
-			m_indices.push_back(m_pBlockIndexAllocator->GetOrCreateIndex(std::move(hash), m_indices.size()));
-		}
-
-		m_height = m_indices.size() - 1;
+		m_height = m_pDataFile->GetSize() - 1;
 	}
 
 	SetDirty(false);
@@ -129,4 +103,4 @@ void Chain::OnInitWrite()
 void Chain::OnEndWrite()
 {
 	m_dataFileWriter.Clear();
-}
\ No newline at end of file
+}
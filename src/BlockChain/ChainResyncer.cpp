@@ -26,8 +26,7 @@ void ChainResyncer::ResyncChain()
 
 	for (uint64_t i = 1; i <= pCandidateChain->GetHeight(); i++)
 	{
-		auto pIndex = pCandidateChain->GetByHeight(i);
-		auto pHeader = pBlockDB->GetBlockHeader(pIndex->GetHash());
+		auto pHeader = pBlockDB->GetBlockHeader(pCandidateChain->GetHash(i));
 		if (pHeader == nullptr || pHeader->GetPreviousHash() != pPrevHeader->GetHash())
 		{
 			pCandidateChain->Rewind(i - 1);
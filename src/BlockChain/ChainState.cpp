@@ -34,7 +34,7 @@ std::shared_ptr<Locked<ChainState>> ChainState::Create(
 	const FullBlock& genesisBlock)
 {
 	std::shared_ptr<const Chain> pCandidateChain = pChainStore->Read()->GetCandidateChain();
-	const uint64_t candidateHeight = pCandidateChain->GetTip()->GetHeight();
+	const uint64_t candidateHeight = pCandidateChain->GetHeight();
 	if (candidateHeight == 0)
 	{
 		auto locked = MultiLocker().Lock(*pDatabase, *pHeaderMMR);
@@ -108,10 +108,10 @@ BlockHeaderPtr ChainState::GetBlockHeaderByHash(const Hash& hash) const
 
 BlockHeaderPtr ChainState::GetBlockHeaderByHeight(const uint64_t height, const EChainType chainType) const
 {
-	auto pBlockIndex = GetChainStore()->GetChain(chainType)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
+	std::shared_ptr<const Chain> pChain = GetChainStore()->GetChain(chainType);
+	if (height <= pChain->GetHeight())
 	{
-		return GetBlockDB()->GetBlockHeader(pBlockIndex->GetHash());
+		return GetBlockDB()->GetBlockHeader(pChain->GetHash(height));
 	}
 
 	return BlockHeaderPtr(nullptr);
@@ -124,10 +124,10 @@ BlockHeaderPtr ChainState::GetBlockHeaderByCommitment(const Commitment& outputCo
 	std::unique_ptr<OutputLocation> pOutputLocation = GetBlockDB()->GetOutputPosition(outputCommitment);
 	if (pOutputLocation != nullptr)
 	{
-		auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(pOutputLocation->GetBlockHeight());
-		if (pBlockIndex != nullptr)
+		std::shared_ptr<const Chain> pChain = GetChainStore()->GetChain(EChainType::CONFIRMED);
+		if (pOutputLocation->GetBlockHeight() <= pChain->GetHeight())
 		{
-			return GetBlockDB()->GetBlockHeader(pBlockIndex->GetHash());
+			return GetBlockDB()->GetBlockHeader(pChain->GetHash(pOutputLocation->GetBlockHeight()));
 		}
 	}
 
@@ -141,10 +141,10 @@ std::unique_ptr<FullBlock> ChainState::GetBlockByHash(const Hash& hash) const
 
 std::unique_ptr<FullBlock> ChainState::GetBlockByHeight(const uint64_t height) const
 {
-	auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
+	std::shared_ptr<const Chain> pChain = GetChainStore()->GetChain(EChainType::CONFIRMED);
+	if (height <= pChain->GetHeight())
 	{
-		return GetBlockDB()->GetBlock(pBlockIndex->GetHash());
+		return GetBlockDB()->GetBlock(pChain->GetHash(height));
 	}
 
 	return std::unique_ptr<FullBlock>(nullptr);
@@ -157,10 +157,10 @@ std::shared_ptr<const FullBlock> ChainState::GetOrphanBlock(const uint64_t heigh
 
 std::unique_ptr<BlockWithOutputs> ChainState::GetBlockWithOutputs(const uint64_t height) const
 {
-	auto pBlockIndex = GetChainStore()->GetChain(EChainType::CONFIRMED)->GetByHeight(height);
-	if (pBlockIndex != nullptr)
+	std::shared_ptr<const Chain> pChain = GetChainStore()->GetChain(EChainType::CONFIRMED);
+	if (height <= pChain->GetHeight())
 	{
-		std::unique_ptr<FullBlock> pBlock = GetBlockDB()->GetBlock(pBlockIndex->GetHash());
+		std::unique_ptr<FullBlock> pBlock = GetBlockDB()->GetBlock(pChain->GetHash(height));
 		if (pBlock != nullptr)
 		{
 			std::vector<OutputDTO> outputsFound;
@@ -189,15 +189,15 @@ std::vector<std::pair<uint64_t, Hash>> ChainState::GetBlocksNeeded(const uint64_
 	blocksNeeded.reserve(maxNumBlocks);
 
 	std::shared_ptr<const Chain> pCandidateChain = GetChainStore()->GetCandidateChain();
-	const uint64_t candidateHeight = pCandidateChain->GetTip()->GetHeight();
+	const uint64_t candidateHeight = pCandidateChain->GetHeight();
 
 	uint64_t nextHeight = GetChainStore()->FindCommonIndex(EChainType::CANDIDATE, EChainType::CONFIRMED)->GetHeight() + 1;
 	while (nextHeight <= candidateHeight)
 	{
-		auto pIndex = pCandidateChain->GetByHeight(nextHeight);
-		if (!m_pOrphanPool->IsOrphan(nextHeight, pIndex->GetHash()))
+		Hash hash = pCandidateChain->GetHash(nextHeight);
+		if (!m_pOrphanPool->IsOrphan(nextHeight, hash))
 		{
-			blocksNeeded.emplace_back(std::pair<uint64_t, Hash>(nextHeight, pIndex->GetHash()));
+			blocksNeeded.emplace_back(std::pair<uint64_t, Hash>(nextHeight, std::move(hash)));
 
 			if (blocksNeeded.size() == maxNumBlocks)
 			{
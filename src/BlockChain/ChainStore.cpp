@@ -14,34 +14,29 @@ ChainStore::ChainStore(const Chain::Ptr& pConfirmedChain, const Chain::Ptr& pCan
 std::shared_ptr<Locked<ChainStore>> ChainStore::Load(const Config& config, std::shared_ptr<BlockIndex> pGenesisIndex)
 {
 	LOG_TRACE("Loading Chain");
-	std::shared_ptr<BlockIndexAllocator> pAllocator = std::make_shared<BlockIndexAllocator>();
 
 	const auto& chainPath = config.GetNodeConfig().GetChainPath();
-	std::shared_ptr<Chain> pConfirmedChain = Chain::Load(pAllocator, EChainType::CONFIRMED, chainPath / "confirmed.chain", pGenesisIndex);
+	std::shared_ptr<Chain> pConfirmedChain = Chain::Load(EChainType::CONFIRMED, chainPath / "confirmed.chain", pGenesisIndex);
 	if (pConfirmedChain == nullptr)
 	{
 		LOG_INFO("Failed to load confirmed chain");
 		throw std::exception();
 	}
 
-	pAllocator->AddChain(pConfirmedChain);
-	std::shared_ptr<Chain> pCandidateChain = Chain::Load(pAllocator, EChainType::CANDIDATE, chainPath / "candidate.chain", pGenesisIndex);
+	std::shared_ptr<Chain> pCandidateChain = Chain::Load(EChainType::CANDIDATE, chainPath / "candidate.chain", pGenesisIndex);
 	if (pCandidateChain == nullptr)
 	{
 		LOG_INFO("Failed to load candidate chain");
 		throw std::exception();
 	}
 
-	pAllocator->AddChain(pCandidateChain);
-	//std::shared_ptr<Chain> pSyncChain = Chain::Load(pAllocator, EChainType::SYNC, chainPath / "sync.chain", pGenesisIndex);
+	//std::shared_ptr<Chain> pSyncChain = Chain::Load(EChainType::SYNC, chainPath / "sync.chain", pGenesisIndex);
 	//if (pSyncChain == nullptr)
 	//{
 	//	LOG_INFO("Failed to load sync chain");
 	//	throw std::exception();
 	//}
 
-	//pAllocator->AddChain(pSyncChain);
-
 	auto pChainStore = std::shared_ptr<ChainStore>(new ChainStore(pConfirmedChain, pCandidateChain));
 	return std::make_shared<Locked<ChainStore>>(Locked<ChainStore>(pChainStore));
 }
@@ -79,18 +74,24 @@ std::shared_ptr<const BlockIndex> ChainStore::FindCommonIndex(const EChainType c
 	std::shared_ptr<const Chain> pChain1 = GetChain(chainType1);
 	std::shared_ptr<const Chain> pChain2 = GetChain(chainType2);
 
-	uint64_t height = (std::min)(pChain1->GetHeight(), pChain2->GetHeight());
-	std::shared_ptr<const BlockIndex> pChain1Index = pChain1->GetByHeight(height);
-	std::shared_ptr<const BlockIndex> pChain2Index = pChain2->GetByHeight(height);
-
-	while (pChain1Index->GetHash() != pChain2Index->GetHash())
+	// A block hash commits to all of its ancestors, so both chains agree on every height up to
+	// the fork point and disagree on every height after it. That lets us binary search for it.
+	uint64_t low = 0;
+	uint64_t high = (std::min)(pChain1->GetHeight(), pChain2->GetHeight());
+	while (low < high)
 	{
-		--height;
-		pChain1Index = pChain1->GetByHeight(height);
-		pChain2Index = pChain2->GetByHeight(height);
+		const uint64_t mid = low + ((high - low + 1) / 2);
+		if (pChain1->GetHash(mid) == pChain2->GetHash(mid))
+		{
+			low = mid;
+		}
+		else
+		{
+			high = mid - 1;
+		}
 	}
 
-	return pChain1Index;
+	return pChain1->GetByHeight(low);
 }
 
 void ChainStore::ReorgChain(const EChainType source, const EChainType destination)
@@ -127,9 +128,9 @@ void ChainStore::AddBlock(const EChainType source, const EChainType destination,
 	std::shared_ptr<Chain> pSourceChain = GetChain(source);
 	std::shared_ptr<Chain> pDestinationChain = GetChain(destination);
 
-	if (pDestinationChain->GetTip()->GetHeight() + 1 == height)
+	if (pDestinationChain->GetHeight() + 1 == height)
 	{
-		if (pSourceChain->GetTip()->GetHeight() >= height)
+		if (pSourceChain->GetHeight() >= height)
 		{
 			pDestinationChain->AddBlock(pSourceChain->GetHash(height), height);
 			return;
@@ -21,6 +21,20 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSingleHeader(const BlockHeaderPtr
 {
 	LOG_TRACE_F("Validating {}", *pHeader);
 
+	// The same header is usually relayed by several peers, so skip the self-consistency checks if it's already known.
+	if (m_pChainState->Read()->GetBlockHeaderByHash(pHeader->GetHash()) != nullptr)
+	{
+		LOG_TRACE_F("Header {} already processed.", *pHeader);
+		return EBlockChainStatus::ALREADY_EXISTS;
+	}
+
+	// Verify header is self-consistent before locking
+	if (!BlockHeaderValidator::AreSelfConsistent(m_config, { pHeader }))
+	{
+		LOG_ERROR_F("Header {} failed to validate", *pHeader);
+		throw BAD_DATA_EXCEPTION("Header failed to validate.");
+	}
+
 	auto pLockedState = m_pChainState->BatchWrite();
 	auto pBlockDB = pLockedState->GetBlockDB();
 	auto pHeaderMMR = pLockedState->GetHeaderMMR();
@@ -146,6 +160,13 @@ EBlockChainStatus BlockHeaderProcessor::ProcessSyncHeaders(const std::vector<Blo
 		}
 	}
 
+	// Verify headers are self-consistent before locking
+	if (!BlockHeaderValidator::AreSelfConsistent(m_config, headers))
+	{
+		LOG_ERROR_F("Headers {} to {} failed to validate", *headers.front(), *headers.back());
+		throw BAD_DATA_EXCEPTION("Header invalid.");
+	}
+
 	const size_t size = headers.size();
 	size_t index = 0;
 
@@ -13,6 +13,7 @@ public:
 
 	//
 	// Validates and adds a single header to the candidate chain.
+	// The stateless checks, including the proof of work, run before the chain state is locked.
 	//
 	// Throws BadDataException if the header is invalid.
 	// Throws BlockChainException if any other errors occur.
@@ -22,6 +23,7 @@ public:
 	//
 	// Validates and adds multiple headers to the sync chain.
 	// The headers are also added to the candidate chain if total difficulty increases.
+	// The stateless checks for all of the headers are split across threads before the chain state is locked.
 	//
 	// Throws BadDataException if any of the headers are invalid.
 	// Throws BlockChainException if any other errors occur.
@@ -161,9 +161,11 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 
 	pTxHashSet->Rewind(pBlockDB, *pCommonHeader);
 
+	// Each block's sums are carried over to the next, so only the fork point's are read from the BlockDB.
+	std::optional<BlockSums> blockSumsOpt = std::nullopt;
 	for (const FullBlock::CPtr& pBlock : reorgBlocks)
 	{
-		ValidateAndAddBlock(*pBlock, pBatch);
+		blockSumsOpt = ValidateAndAddBlock(*pBlock, pBatch, std::move(blockSumsOpt));
 	}
 
 	if (reorgBlocks.back()->GetTotalDifficulty() > totalDifficulty)
@@ -192,7 +194,7 @@ void BlockProcessor::HandleReorg(Writer<ChainState> pBatch, const std::vector<Fu
 	}
 }
 
-void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pBatch)
+BlockSums BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pBatch, std::optional<BlockSums> previousSumsOpt)
 {
 	auto pOrphanPool = pBatch->GetOrphanPool();
 	auto pBlockDB = pBatch->GetBlockDB();
@@ -218,17 +220,21 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 		throw BAD_DATA_EXCEPTION("Failed to validate TxHashSet roots.");
 	}
 
-	std::unique_ptr<BlockSums> pPreviousBlockSums = pBlockDB->GetBlockSums(previousHash);
-	if (pPreviousBlockSums == nullptr) {
-		LOG_WARNING_F("Failed to retrieve block sums for block {}", previousHash);
-		throw BLOCK_CHAIN_EXCEPTION("Failed to retrieve block sums.");
+	if (!previousSumsOpt.has_value()) {
+		std::unique_ptr<BlockSums> pPreviousBlockSums = pBlockDB->GetBlockSums(previousHash);
+		if (pPreviousBlockSums == nullptr) {
+			LOG_WARNING_F("Failed to retrieve block sums for block {}", previousHash);
+			throw BLOCK_CHAIN_EXCEPTION("Failed to retrieve block sums.");
+		}
+
+		previousSumsOpt = std::make_optional(std::move(*pPreviousBlockSums));
 	}
 
 	BlockSums blockSums = KernelSumValidator::ValidateKernelSums(
 		block.GetTransactionBody(),
 		0 - Consensus::REWARD,
 		block.GetTotalKernelOffset(),
-		std::make_optional(*pPreviousBlockSums)
+		previousSumsOpt
 	);
 
 	pBlockDB->RemoveOutputPositions(block.GetInputCommitments());
@@ -236,4 +242,6 @@ void BlockProcessor::ValidateAndAddBlock(const FullBlock& block, Writer<ChainSta
 	pBlockDB->AddBlock(block);
 	pOrphanPool->RemoveOrphan(block.GetHeight(), block.GetHash());
 	pTxPool->ReconcileBlock(pBlockDB, pTxHashSet, block);
+
+	return blockSums;
 }
\ No newline at end of file
@@ -4,7 +4,9 @@
 
 #include <Config/Config.h>
 #include <Core/Models/FullBlock.h>
+#include <Core/Models/BlockSums.h>
 #include <BlockChain/BlockChainStatus.h>
+#include <optional>
 
 enum class EBlockStatus
 {
@@ -28,7 +30,12 @@ public:
 private:
 	EBlockChainStatus ProcessBlockInternal(const FullBlock& block);
 	void HandleReorg(Writer<ChainState> pBatch, const std::vector<FullBlock::CPtr>& reorgBlocks);
-	void ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pLockedState);
+
+	//
+	// Validates the block against the TxHashSet and adds it to the BlockDB, returning its BlockSums.
+	// The previous block's sums are read from the BlockDB unless they're passed in.
+	//
+	BlockSums ValidateAndAddBlock(const FullBlock& block, Writer<ChainState> pLockedState, std::optional<BlockSums> previousSumsOpt = std::nullopt);
 
 	BlockProcessingInfo DetermineBlockStatus(const FullBlock& block, Writer<ChainState> pLockedState);
 
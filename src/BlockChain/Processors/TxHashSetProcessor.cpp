@@ -78,8 +78,7 @@ bool TxHashSetProcessor::UpdateConfirmedChain(Writer<ChainState> pLockedState, c
 	std::shared_ptr<Chain> pCandidateChain = pLockedState->GetChainStore()->GetCandidateChain();
 	std::shared_ptr<Chain> pConfirmedChain = pLockedState->GetChainStore()->GetConfirmedChain();
 	
-	std::shared_ptr<const BlockIndex> pBlockIndex = pCandidateChain->GetByHeight(blockHeader.GetHeight());
-	if (pBlockIndex->GetHash() != blockHeader.GetHash())
+	if (!pCandidateChain->IsOnChain(blockHeader.GetHeight(), blockHeader.GetHash()))
 	{
 		return false;
 	}
@@ -88,7 +87,7 @@ bool TxHashSetProcessor::UpdateConfirmedChain(Writer<ChainState> pLockedState, c
 	pConfirmedChain->Rewind(pCommonIndex->GetHeight());
 
 	uint64_t height = pCommonIndex->GetHeight() + 1;
-	while (height <= pBlockIndex->GetHeight())
+	while (height <= blockHeader.GetHeight())
 	{
 		pConfirmedChain->AddBlock(pCandidateChain->GetHash(height), height);
 		height++;
@@ -0,0 +1,136 @@
+#include "TxHashSetCompactor.h"
+
+#include <Consensus/BlockTime.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Common/ThreadManager.h>
+#include <Common/Logger.h>
+#include <chrono>
+
+TxHashSetCompactor::TxHashSetCompactor(std::shared_ptr<Locked<ChainState>> pChainState)
+	: m_pChainState(pChainState), m_lastHorizonHeight(0), m_terminate(false)
+{
+
+}
+
+TxHashSetCompactor::~TxHashSetCompactor()
+{
+	m_terminate = true;
+	ThreadUtil::Join(m_compactThread);
+}
+
+std::unique_ptr<TxHashSetCompactor> TxHashSetCompactor::Create(std::shared_ptr<Locked<ChainState>> pChainState)
+{
+	auto pCompactor = std::unique_ptr<TxHashSetCompactor>(new TxHashSetCompactor(pChainState));
+	pCompactor->m_compactThread = std::thread(TxHashSetCompactor::Thread_Compact, std::ref(*pCompactor));
+	return pCompactor;
+}
+
+void TxHashSetCompactor::Thread_Compact(TxHashSetCompactor& compactor)
+{
+	ThreadManagerAPI::SetCurrentThreadName("TXHASHSET_COMPACT");
+	LOG_TRACE("BEGIN");
+
+	while (!compactor.m_terminate)
+	{
+		try
+		{
+			compactor.Compact();
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Failed to compact TxHashSet: {}", e.what());
+		}
+
+		ThreadUtil::SleepFor(std::chrono::minutes(10), compactor.m_terminate);
+	}
+
+	LOG_TRACE("END");
+}
+
+void TxHashSetCompactor::Compact()
+{
+	// Step 1: Prepare the compaction once the horizon has advanced by at least a day.
+	std::weak_ptr<ITxHashSet> pPreparedTxHashSet;
+	ITxHashSetCompaction::Ptr pCompaction = nullptr;
+	uint64_t horizonHeight = 0;
+	{
+		auto pBatch = m_pChainState->BatchWrite();
+
+		auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
+		if (pTxHashSet == nullptr)
+		{
+			return;
+		}
+
+		// The TxHashSet remembers its last compaction, so this also holds across restarts.
+		const uint64_t lastHorizonHeight = (std::max)(m_lastHorizonHeight, pTxHashSet->GetCompactedHeight());
+
+		horizonHeight = Consensus::GetHorizonHeight(pBatch->GetHeight(EChainType::CONFIRMED));
+		if (horizonHeight == 0 || horizonHeight < lastHorizonHeight + Consensus::DAY_HEIGHT)
+		{
+			return;
+		}
+
+		auto pHorizonHeader = pBatch->GetBlockHeaderByHeight(horizonHeight, EChainType::CONFIRMED);
+		if (pHorizonHeader == nullptr)
+		{
+			return;
+		}
+
+		pCompaction = pTxHashSet->PrepareCompaction(*pHorizonHeader);
+		pPreparedTxHashSet = pTxHashSet;
+	}
+
+	if (pCompaction == nullptr)
+	{
+		return;
+	}
+
+	// Step 2: Write the compacted files without holding any locks.
+	LOG_INFO_F("Compacting TxHashSet up to horizon {}", horizonHeight);
+
+	const uint64_t totalBytes = (std::max)(pCompaction->GetTotalBytes(), (uint64_t)1);
+	uint64_t bytesRead = 0;
+	uint64_t lastPercentage = 0;
+	const bool written = pCompaction->Write([totalBytes, &bytesRead, &lastPercentage](const uint64_t bytes) {
+		bytesRead += bytes;
+
+		const uint64_t percentage = (std::min)((bytesRead * 100) / totalBytes, (uint64_t)100);
+		if (percentage >= lastPercentage + 10)
+		{
+			LOG_INFO_F("Compacting TxHashSet: {}%", percentage);
+			lastPercentage = percentage;
+		}
+	}, m_terminate);
+
+	if (!written)
+	{
+		if (!m_terminate)
+		{
+			LOG_DEBUG("Nothing to compact");
+			m_lastHorizonHeight = horizonHeight;
+		}
+
+		return;
+	}
+
+	// Step 3: Swap in the compacted files.
+	{
+		auto pBatch = m_pChainState->BatchWrite();
+
+		// A TxHashSet sync may have replaced the TxHashSet in the meantime.
+		auto pTxHashSet = pBatch->GetTxHashSetManager()->GetTxHashSet();
+		if (pTxHashSet == nullptr || pTxHashSet != pPreparedTxHashSet.lock())
+		{
+			LOG_INFO("TxHashSet was replaced. Discarding compaction.");
+			return;
+		}
+
+		const uint64_t reclaimedBytes = pTxHashSet->FinishCompaction(pCompaction);
+		pBatch->Commit();
+
+		LOG_INFO_F("Compacted TxHashSet up to horizon {}, reclaiming {} bytes", horizonHeight, reclaimedBytes);
+	}
+
+	m_lastHorizonHeight = horizonHeight;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ChainState.h"
+
+#include <Core/Traits/Lockable.h>
+#include <PMMR/TxHashSet.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+//
+// Periodically compacts the output and rangeproof PMMRs as the horizon advances.
+// The compacted files are written without holding the chain lock, so block processing is only paused
+// while the compaction is prepared, and again while the new files are swapped in.
+//
+class TxHashSetCompactor
+{
+public:
+	static std::unique_ptr<TxHashSetCompactor> Create(std::shared_ptr<Locked<ChainState>> pChainState);
+	~TxHashSetCompactor();
+
+private:
+	TxHashSetCompactor(std::shared_ptr<Locked<ChainState>> pChainState);
+
+	static void Thread_Compact(TxHashSetCompactor& compactor);
+
+	void Compact();
+
+	std::shared_ptr<Locked<ChainState>> m_pChainState;
+	uint64_t m_lastHorizonHeight;
+
+	std::atomic_bool m_terminate;
+	std::thread m_compactThread;
+};
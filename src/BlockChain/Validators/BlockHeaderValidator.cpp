@@ -7,6 +7,8 @@
 #include <Common/Logger.h>
 #include <PoW/PoWManager.h>
 #include <PMMR/HeaderMMR.h>
+#include <Common/Util/ThreadUtil.h>
+#include <atomic>
 #include <chrono>
 
 BlockHeaderValidator::BlockHeaderValidator(
@@ -18,27 +20,68 @@ BlockHeaderValidator::BlockHeaderValidator(
 
 }
 
-bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const
+bool BlockHeaderValidator::AreSelfConsistent(const Config& config, const std::vector<BlockHeaderPtr>& headers)
 {
-	// Validate Height
-	if (header.GetHeight() != (previousHeader.GetHeight() + 1))
+	std::atomic_bool valid = true;
+	ThreadUtil::ParallelFor(headers.size(), MIN_HEADERS_PER_THREAD, [&config, &headers, &valid](const size_t begin, const size_t end)
 	{
-		LOG_WARNING_F("Invalid height for header {}", header);
-		return false;
+		const std::vector<BlockHeaderPtr> chunkHeaders(headers.cbegin() + begin, headers.cbegin() + end);
+
+		try
+		{
+			if (!AreSelfConsistentChunk(config, chunkHeaders))
+			{
+				valid = false;
+			}
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Exception thrown while validating headers: {}", e.what());
+			valid = false;
+		}
+	});
+
+	return valid;
+}
+
+bool BlockHeaderValidator::AreSelfConsistentChunk(const Config& config, const std::vector<BlockHeaderPtr>& headers)
+{
+	const auto maxBlockTime = Consensus::GetMaxBlockTime(std::chrono::system_clock::now());
+
+	for (const BlockHeaderPtr& pHeader : headers)
+	{
+		// Validate Timestamp - Ensure timestamp not too far in the future
+		if (pHeader->GetTimestamp() > maxBlockTime)
+		{
+			LOG_WARNING_F("Timestamp beyond maxBlockTime for header {}", *pHeader);
+			return false;
+		}
+
+		// Validate Version
+		const uint64_t validHeaderVersion = Consensus::GetHeaderVersion(config.GetEnvironment().GetType(), pHeader->GetHeight());
+		if (pHeader->GetVersion() != validHeaderVersion)
+		{
+			LOG_WARNING_F("Invalid version for header {}", *pHeader);
+			return false;
+		}
 	}
 
-	// Validate Timestamp - Ensure timestamp not too far in the future
-	if (header.GetTimestamp() > Consensus::GetMaxBlockTime(std::chrono::system_clock::now()))
+	// Validate Proof Of Work - Only the cuckoo cycles. The difficulty depends on the previous headers.
+	if (!PoWManager(config, nullptr).AreProofsValid(headers))
 	{
-		LOG_WARNING_F("Timestamp beyond maxBlockTime for header {}", header);
+		LOG_WARNING_F("Invalid Proof of Work in headers {} to {}", *headers.front(), *headers.back());
 		return false;
 	}
 
-	// Validate Version
-	const uint64_t validHeaderVersion = Consensus::GetHeaderVersion(m_config.GetEnvironment().GetType(), header.GetHeight());
-	if (header.GetVersion() != validHeaderVersion)
+	return true;
+}
+
+bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	// Validate Height
+	if (header.GetHeight() != (previousHeader.GetHeight() + 1))
 	{
-		LOG_WARNING_F("Invalid version for header {}", header);
+		LOG_WARNING_F("Invalid height for header {}", header);
 		return false;
 	}
 
@@ -49,9 +92,9 @@ bool BlockHeaderValidator::IsValidHeader(const BlockHeader& header, const BlockH
 		return false;
 	}
 
-	// Validate Proof Of Work
-	const bool validPoW = PoWManager(m_config, m_pBlockDB).IsPoWValid(header, previousHeader);
-	if (!validPoW)
+	// Validate Proof Of Work Difficulty
+	const bool validDifficulty = PoWManager(m_config, m_pBlockDB).IsDifficultyValid(header, previousHeader);
+	if (!validDifficulty)
 	{
 		LOG_WARNING_F("Invalid Proof of Work for header {}", header);
 		return false;
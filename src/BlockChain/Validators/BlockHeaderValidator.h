@@ -12,8 +12,25 @@ class BlockHeaderValidator
 public:
 	BlockHeaderValidator(const Config& config, std::shared_ptr<const IBlockDB> pBlockDB, std::shared_ptr<const IHeaderMMR> pHeaderMMR);
 
+	//
+	// Checks everything that doesn't depend on the chain state: the version, the timestamp isn't too far in the future,
+	// and the proof of work's cuckoo cycle. This is the expensive part of header validation, so it should be done
+	// before taking the chain state lock. The headers are split across threads when there are enough of them.
+	//
+	static bool AreSelfConsistent(const Config& config, const std::vector<BlockHeaderPtr>& headers);
+
+	//
+	// Validates the header against the previous one and the chain state: height, timestamp, difficulty and header MMR root.
+	// The header must have already passed AreSelfConsistent.
+	//
 	bool IsValidHeader(const BlockHeader& header, const BlockHeader& previousHeader) const;
 
+private:
+	// Each thread checks at least this many headers, so their proofs can still be batched.
+	static constexpr size_t MIN_HEADERS_PER_THREAD = 16;
+
+	static bool AreSelfConsistentChunk(const Config& config, const std::vector<BlockHeaderPtr>& headers);
+
 	const Config& m_config;
 	std::shared_ptr<const IBlockDB> m_pBlockDB;
 	std::shared_ptr<const IHeaderMMR> m_pHeaderMMR;
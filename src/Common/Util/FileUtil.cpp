@@ -8,6 +8,7 @@
 
 #ifndef _WIN32
 #include <unistd.h>
+#include <fcntl.h>
 #endif
 
 static const size_t MAX_PATH_LEN = 260;
@@ -184,6 +185,33 @@ bool FileUtil::TruncateFile(const fs::path& filePath, const uint64_t size)
 #endif
 }
 
+bool FileUtil::SyncFile(const fs::path& filePath)
+{
+#ifdef _WIN32
+	HANDLE hFile = CreateFile(filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	const bool success = FlushFileBuffers(hFile);
+	CloseHandle(hFile);
+
+	return success;
+#else
+	const int fd = open(filePath.c_str(), O_RDWR);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	const bool success = fsync(fd) == 0;
+	close(fd);
+
+	return success;
+#endif
+}
+
 std::vector<GrinStr> FileUtil::GetSubDirectories(const fs::path& filePath, const bool includeHidden)
 {
 	std::vector<GrinStr> listOfFiles;
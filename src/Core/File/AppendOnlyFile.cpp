@@ -1,50 +1,92 @@
 #include <Core/File/AppendOnlyFile.h>
 #include <Core/Exceptions/FileException.h>
 #include <Common/Util/FileUtil.h>
+#include <Common/Logger.h>
+#include <algorithm>
 
 void AppendOnlyFile::Load()
 {
 	m_fileSize = FileUtil::GetFileSize(m_path);
+	m_committedIndex = m_fileSize;
 	m_bufferIndex = m_fileSize;
 	m_pMappedFile = IMappedFile::Load(m_path);
 }
 
 bool AppendOnlyFile::Flush()
 {
-	if (m_fileSize == m_bufferIndex && m_buffer.empty())
 	{
-		return true;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		CommitBuffer();
 	}
 
-	if (m_fileSize < m_bufferIndex)
+	BeginFlush();
+	return EndFlush(false);
+}
+
+void AppendOnlyFile::Commit(std::vector<WriteAheadLog::Entry>& entries)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (m_bufferIndex == m_committedIndex + m_committed.size() && m_buffer.empty())
 	{
-		return false;
+		return;
+	}
+
+	entries.push_back({ WriteAheadLog::EType::APPEND, m_path, m_bufferIndex, m_buffer });
+	CommitBuffer();
+}
+
+void AppendOnlyFile::BeginFlush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (m_isFlushing || (m_committedIndex == m_fileSize && m_committed.empty()))
+	{
+		return;
+	}
+
+	m_flushingIndex = m_committedIndex;
+	m_flushing = std::move(m_committed);
+	m_committed.clear();
+	m_committedIndex = m_flushingIndex + m_flushing.size();
+	m_isFlushing = true;
+}
+
+bool AppendOnlyFile::EndFlush(const bool sync)
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_isFlushing)
+		{
+			return true;
+		}
 	}
 
-	if (!m_pMappedFile->Write(m_bufferIndex, m_buffer))
+	// m_flushing can't change until m_isFlushing is cleared, so it's safe to write it without holding the lock.
+	// Concurrent reads only touch the file below m_flushingIndex, which this doesn't modify.
+	if (!m_pMappedFile->Write(m_flushingIndex, m_flushing) || (sync && !FileUtil::SyncFile(m_path)))
 	{
+		LOG_ERROR_F("Failed to flush {}", m_path);
 		return false;
 	}
 
-	m_fileSize = m_bufferIndex + m_buffer.size();
-	m_bufferIndex = m_fileSize;
-	m_buffer.clear();
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_fileSize = m_flushingIndex + m_flushing.size();
+	m_flushing.clear();
+	m_isFlushing = false;
 
 	return true;
 }
 
 void AppendOnlyFile::Append(const std::vector<unsigned char>& data)
 {
+	std::unique_lock<std::mutex> lock(m_mutex);
 	m_buffer.insert(m_buffer.end(), data.cbegin(), data.cend());
 }
 
 bool AppendOnlyFile::Rewind(const uint64_t nextPosition)
 {
-	// TODO: Shouldn't flush here - need to support multiple rewinds
-	//if (!Flush())
-	//{
-	//	return false;
-	//}
+	std::unique_lock<std::mutex> lock(m_mutex);
 
 	if (nextPosition > (m_bufferIndex + m_buffer.size()))
 	{
@@ -66,31 +108,84 @@ bool AppendOnlyFile::Rewind(const uint64_t nextPosition)
 
 void AppendOnlyFile::Discard() noexcept
 {
-	m_bufferIndex = m_fileSize;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_bufferIndex = m_committedIndex + m_committed.size();
 	m_buffer.clear();
 }
 
 uint64_t AppendOnlyFile::GetSize() const noexcept
 {
+	std::unique_lock<std::mutex> lock(m_mutex);
 	return m_bufferIndex + m_buffer.size();
 }
 
 bool AppendOnlyFile::Read(const uint64_t position, const uint64_t numBytes, std::vector<unsigned char>& data) const
 {
-	// TODO: Handle partial read from m_mmap and m_buffer
-	if (position < m_bufferIndex)
+	data.resize(numBytes);
+	return Read(position, numBytes, data.data());
+}
+
+bool AppendOnlyFile::Read(const uint64_t position, const uint64_t numBytes, uint8_t* pData) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (position + numBytes > m_bufferIndex + m_buffer.size())
 	{
-		m_pMappedFile->Read(position, numBytes, data);
+		return false;
 	}
-	else
-	{
-		const uint64_t firstBufferIndex = position - m_bufferIndex;
 
-		data = std::vector<unsigned char>(
-			m_buffer.cbegin() + firstBufferIndex,
-			m_buffer.cbegin() + firstBufferIndex + numBytes
-		);
+	// Each layer overrides everything at or beyond its starting index in the layers below it.
+	uint64_t bytesRead = 0;
+	while (bytesRead < numBytes)
+	{
+		const uint64_t index = position + bytesRead;
+		const uint64_t remaining = numBytes - bytesRead;
+
+		if (index >= m_bufferIndex)
+		{
+			const auto begin = m_buffer.cbegin() + (index - m_bufferIndex);
+			std::copy(begin, begin + remaining, pData + bytesRead);
+			bytesRead += remaining;
+		}
+		else if (index >= m_committedIndex)
+		{
+			const uint64_t count = (std::min)(remaining, m_bufferIndex - index);
+			const auto begin = m_committed.cbegin() + (index - m_committedIndex);
+			std::copy(begin, begin + count, pData + bytesRead);
+			bytesRead += count;
+		}
+		else if (m_isFlushing && index >= m_flushingIndex)
+		{
+			const uint64_t count = (std::min)(remaining, m_committedIndex - index);
+			const auto begin = m_flushing.cbegin() + (index - m_flushingIndex);
+			std::copy(begin, begin + count, pData + bytesRead);
+			bytesRead += count;
+		}
+		else
+		{
+			const uint64_t diskEnd = m_isFlushing ? (std::min)(m_flushingIndex, m_committedIndex) : m_committedIndex;
+			const uint64_t count = (std::min)(remaining, diskEnd - index);
+			m_pMappedFile->Read(index, count, pData + bytesRead);
+			bytesRead += count;
+		}
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+void AppendOnlyFile::CommitBuffer()
+{
+	if (m_bufferIndex >= m_committedIndex)
+	{
+		m_committed.resize(m_bufferIndex - m_committedIndex);
+		m_committed.insert(m_committed.end(), m_buffer.cbegin(), m_buffer.cend());
+	}
+	else
+	{
+		m_committedIndex = m_bufferIndex;
+		m_committed = std::move(m_buffer);
+	}
+
+	m_buffer.clear();
+	m_bufferIndex = m_committedIndex + m_committed.size();
+}
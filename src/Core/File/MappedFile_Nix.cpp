@@ -1,94 +1,184 @@
 #include "MappedFile_Nix.h"
 
-#include <fstream>
 #include <filesystem.h>
-#include <stdlib.h>
 #include <Core/Exceptions/FileException.h>
 #include <Common/Logger.h>
-#include <Common/Util/FileUtil.h>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Files are reserved and mapped in chunks of this size, so most appends neither allocate nor remap.
+static const uint64_t EXTENT_SIZE = 8 * 1024 * 1024;
+
+static uint64_t RoundUpToExtent(const uint64_t size)
+{
+	return ((size / EXTENT_SIZE) + 1) * EXTENT_SIZE;
+}
 
 MappedFile::~MappedFile()
 {
 	LOG_TRACE_F("Closing File: {}", m_path);
 
 	Unmap();
+	close(m_fd);
 }
 
 IMappedFile::UPtr IMappedFile::Load(const fs::path& path)
 {
-	std::ifstream inFile(path, std::ios::in | std::ifstream::ate | std::ifstream::binary);
-	if (inFile.is_open())
+	const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd < 0)
 	{
-		inFile.close();
+		LOG_ERROR_F("Failed to open file {} with error {}", path, errno);
+		throw FILE_EXCEPTION_F("Failed to open file: {}", path);
 	}
-	else
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		LOG_ERROR_F("Failed to stat file {} with error {}", path, errno);
+		throw FILE_EXCEPTION_F("Failed to stat file: {}", path);
+	}
+
+	return std::unique_ptr<IMappedFile>(new MappedFile(path, fd, (uint64_t)fileStat.st_size));
+}
+
+bool MappedFile::Write(const size_t startIndex, const std::vector<uint8_t>& data)
+{
+	std::unique_lock<std::mutex> lock(m_writeMutex);
+
+	// Rewinds are rare, so the reserved extents are simply released along with the truncated data.
+	// The mapping can stay in place, since nothing beyond startIndex will be read until it's rewritten.
+	if (startIndex < m_size)
 	{
-		LOG_INFO_F("File {} does not exist. Creating it now.", path);
-		std::ofstream outFile(path, std::ios::out | std::ios::binary | std::ios::app);
-		if (!outFile.is_open())
+		if (ftruncate(m_fd, startIndex) != 0)
 		{
-			LOG_ERROR_F("Failed to create file: {}", path);
-			throw FILE_EXCEPTION_F("Failed to create file: {}", path);
+			LOG_ERROR_F("Failed to truncate file {} with error {}", m_path, errno);
+			return false;
 		}
 
-		outFile.close();
+		m_size = startIndex;
+		m_reserved = startIndex;
 	}
 
-	return std::unique_ptr<IMappedFile>(new MappedFile(path));
+	return WriteAt(startIndex, data);
 }
 
-bool MappedFile::Write(const size_t startIndex, const std::vector<uint8_t>& data)
+bool MappedFile::Overwrite(const uint64_t position, const std::vector<uint8_t>& data)
 {
-	std::unique_lock<std::mutex> lock(m_mutex);
-
-	Unmap();
+	std::unique_lock<std::mutex> lock(m_writeMutex);
+	return WriteAt(position, data);
+}
 
-	FileUtil::TruncateFile(m_path, startIndex);
+bool MappedFile::WriteAt(const uint64_t position, const std::vector<uint8_t>& data)
+{
+	const uint64_t endIndex = position + data.size();
+	if (endIndex > m_reserved)
+	{
+		Reserve(RoundUpToExtent(endIndex));
+	}
 
-	if (!data.empty())
+	size_t bytesWritten = 0;
+	while (bytesWritten < data.size())
 	{
-		std::ofstream file(m_path, std::ios::out | std::ios::binary | std::ios::app);
-		if (!file.is_open())
+		const ssize_t result = pwrite(m_fd, data.data() + bytesWritten, data.size() - bytesWritten, position + bytesWritten);
+		if (result < 0)
 		{
-			LOG_ERROR_F("Failed to open file: {}", m_path);
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			LOG_ERROR_F("Failed to write file {} with error {}", m_path, errno);
 			return false;
 		}
 
-		file.seekp(startIndex, std::ios::beg);
-		file.write((const char*)data.data(), data.size());
-		file.close();
+		bytesWritten += (size_t)result;
 	}
 
+	m_size = (std::max)(m_size, endIndex);
 	return true;
 }
 
 void MappedFile::Read(const uint64_t position, const uint64_t numBytes, std::vector<uint8_t>& data) const
 {
+	data.resize(numBytes);
+	Read(position, numBytes, data.data());
+}
+
+void MappedFile::Read(const uint64_t position, const uint64_t numBytes, uint8_t* pData) const
+{
+	if (numBytes == 0)
+	{
+		return;
+	}
+
 	std::unique_lock<std::mutex> lock(m_mutex);
 
-	if (!m_mmap.is_mapped())
+	if (position + numBytes > m_mappedSize)
 	{
-		Map();
+		Map(RoundUpToExtent(position + numBytes));
 	}
 
-	data = std::vector<uint8_t>(
-		m_mmap.cbegin() + position,
-		m_mmap.cbegin() + position + numBytes
+	std::copy(
+		m_pMapped + position,
+		m_pMapped + position + numBytes,
+		pData
 	);
 }
 
-void MappedFile::Map() const
+void MappedFile::Reserve(const uint64_t size)
+{
+	// Reserving the blocks up front keeps the file contiguous and avoids an allocation on every append.
+	// KEEP_SIZE leaves the file's size alone, so the reserved space is invisible to everything else.
+	// Not every filesystem supports this, in which case blocks are just allocated as they're written.
+#ifdef __linux__
+	if (fallocate(m_fd, FALLOC_FL_KEEP_SIZE, m_reserved, size - m_reserved) != 0)
+	{
+		LOG_DEBUG_F("fallocate failed for file {} with error {}", m_path, errno);
+	}
+#endif
+
+	m_reserved = size;
+}
+
+void MappedFile::Map(const uint64_t size) const
 {
-	std::error_code error;
-	m_mmap = mio::make_mmap_source(m_path.c_str(), error);
-	if (error.value() != 0)
+	// It's fine to map past the end of the file, as long as the pages beyond it are never touched.
+	void* pMapped = MAP_FAILED;
+#ifdef __linux__
+	if (m_pMapped != nullptr)
 	{
-		LOG_ERROR_F("Failed to mmap file: {}", error.value());
+		pMapped = mremap(m_pMapped, m_mappedSize, size, MREMAP_MAYMOVE);
+	}
+	else
+	{
+		pMapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+	}
+#else
+	Unmap();
+	pMapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+#endif
+
+	if (pMapped == MAP_FAILED)
+	{
+		LOG_ERROR_F("Failed to mmap file {} with error {}", m_path, errno);
 		throw FILE_EXCEPTION_F("Failed to mmap file: {}", m_path);
 	}
+
+	m_pMapped = (uint8_t*)pMapped;
+	m_mappedSize = size;
 }
 
 void MappedFile::Unmap() const
 {
-	m_mmap.unmap();
-}
\ No newline at end of file
+	if (m_pMapped != nullptr)
+	{
+		munmap(m_pMapped, m_mappedSize);
+		m_pMapped = nullptr;
+		m_mappedSize = 0;
+	}
+}
@@ -1,30 +1,41 @@
 #include <Core/File/MappedFile.h>
 
-#pragma warning(push)
-#pragma warning(disable:4244)
-#pragma warning(disable:4267)
-#pragma warning(disable:4334)
-#pragma warning(disable:4018)
-#include <mio/mmap.hpp>
-#pragma warning(pop)
-
+//
+// Appends are written with pwrite into extents reserved ahead of time with fallocate,
+// and the read-only mapping is grown in place with mremap instead of being dropped and rebuilt.
+// Since the mapping shares the page cache with the file, bytes written by Write() are
+// immediately visible to Read() without remapping.
+//
 class MappedFile : public IMappedFile
 {
 public:
 	using UPtr = std::unique_ptr<MappedFile>;
 
-	MappedFile(const fs::path& path) noexcept
-		: m_path(path) { }
+	MappedFile(const fs::path& path, const int fd, const uint64_t size) noexcept
+		: m_path(path), m_fd(fd), m_size(size), m_reserved(size), m_pMapped(nullptr), m_mappedSize(0) { }
 	virtual ~MappedFile();
 
 	bool Write(const size_t startIndex, const std::vector<uint8_t>& data) final;
+	bool Overwrite(const uint64_t position, const std::vector<uint8_t>& data) final;
 	void Read(const uint64_t position, const uint64_t numBytes, std::vector<uint8_t>& data) const final;
+	void Read(const uint64_t position, const uint64_t numBytes, uint8_t* pData) const final;
 
 private:
-	void Map() const;
+	bool WriteAt(const uint64_t position, const std::vector<uint8_t>& data);
+	void Reserve(const uint64_t size);
+	void Map(const uint64_t size) const;
 	void Unmap() const;
 
 	fs::path m_path;
-	mutable mio::mmap_source m_mmap;
+	int m_fd;
+
+	// Guards the file size and reserved extents. Only held by Write().
+	std::mutex m_writeMutex;
+	uint64_t m_size;
+	uint64_t m_reserved;
+
+	// Guards the mapping. Never held while writing, so reads don't wait on disk I/O.
 	mutable std::mutex m_mutex;
-};
\ No newline at end of file
+	mutable uint8_t* m_pMapped;
+	mutable uint64_t m_mappedSize;
+};
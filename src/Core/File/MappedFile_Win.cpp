@@ -96,6 +96,34 @@ bool MappedFile::Write(const size_t startIndex, const std::vector<uint8_t>& data
 	return true;
 }
 
+bool MappedFile::Overwrite(const uint64_t position, const std::vector<uint8_t>& data)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	Unmap();
+
+	LARGE_INTEGER li;
+	li.QuadPart = position;
+
+	if (!SetFilePointerEx(m_handle, li, NULL, FILE_BEGIN))
+	{
+		LOG_ERROR_F("Failed to set file pointer for {} - error: {}", m_path, GetLastError());
+		return false;
+	}
+
+	if (!data.empty())
+	{
+		DWORD bytesWritten;
+		if (FALSE == WriteFile(m_handle, (const char*)data.data(), (DWORD)data.size(), &bytesWritten, 0))
+		{
+			LOG_ERROR_F("Failed to write to {} - error: {}", m_path, GetLastError());
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void MappedFile::Read(const uint64_t position, const uint64_t numBytes, std::vector<uint8_t>& data) const
 {
 	std::unique_lock<std::mutex> lock(m_mutex);
@@ -111,6 +139,22 @@ void MappedFile::Read(const uint64_t position, const uint64_t numBytes, std::vec
 	);
 }
 
+void MappedFile::Read(const uint64_t position, const uint64_t numBytes, uint8_t* pData) const
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (!m_mmap.IsMapped())
+	{
+		Map();
+	}
+
+	std::copy(
+		m_mmap.mapped_view + position,
+		m_mmap.mapped_view + position + numBytes,
+		pData
+	);
+}
+
 void MappedFile::Map() const
 {
 	m_mmap.mapping_handle = CreateFileMapping(m_handle, 0, PAGE_READONLY, 0, 0, 0);
@@ -30,7 +30,9 @@ public:
 	virtual ~MappedFile();
 
 	bool Write(const size_t startIndex, const std::vector<uint8_t>& data) final;
+	bool Overwrite(const uint64_t position, const std::vector<uint8_t>& data) final;
 	void Read(const uint64_t position, const uint64_t numBytes, std::vector<uint8_t>& data) const final;
+	void Read(const uint64_t position, const uint64_t numBytes, uint8_t* pData) const final;
 
 private:
 	void Map() const;
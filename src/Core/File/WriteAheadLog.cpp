@@ -0,0 +1,225 @@
+#include <Core/File/WriteAheadLog.h>
+#include <Core/Exceptions/FileException.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Crypto/Hasher.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Logger.h>
+
+#include <fstream>
+#include <set>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const uint32_t RECORD_MAGIC = 0x4757414C; // "GWAL"
+
+WriteAheadLog::WriteAheadLog(const fs::path& directory, std::FILE* pFile)
+	: m_directory(directory), m_pFile(pFile), m_activeSize(0)
+{
+
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+	if (m_pFile != nullptr)
+	{
+		std::fclose(m_pFile);
+	}
+}
+
+WriteAheadLog::Ptr WriteAheadLog::Open(const fs::path& directory)
+{
+	Recover(directory);
+
+	std::FILE* pFile = OpenForAppend(GetActivePath(directory));
+	return std::shared_ptr<WriteAheadLog>(new WriteAheadLog(directory, pFile));
+}
+
+void WriteAheadLog::Recover(const fs::path& directory)
+{
+	// The sealed segment always contains older records than the active one.
+	Replay(directory, GetSealedPath(directory));
+	Replay(directory, GetActivePath(directory));
+
+	Discard(directory);
+}
+
+void WriteAheadLog::Discard(const fs::path& directory)
+{
+	FileUtil::RemoveFile(GetSealedPath(directory));
+	FileUtil::RemoveFile(GetActivePath(directory));
+}
+
+void WriteAheadLog::Append(const std::vector<Entry>& entries)
+{
+	Serializer payload;
+	payload.Append<uint32_t>((uint32_t)entries.size());
+	for (const Entry& entry : entries)
+	{
+		payload.Append<uint8_t>((uint8_t)entry.type);
+		payload.AppendVarStr(entry.path.lexically_relative(m_directory).generic_u8string());
+		payload.Append<uint64_t>(entry.offset);
+		payload.AppendBytes(entry.data, ESerializeLength::U64);
+	}
+
+	Serializer record(payload.size() + 44);
+	record.Append<uint32_t>(RECORD_MAGIC);
+	record.AppendBytes(payload.GetBytes(), ESerializeLength::U64);
+	record.AppendBigInteger(Hasher::Blake2b(payload.GetBytes()));
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if (std::fwrite(record.data(), 1, record.size(), m_pFile) != record.size() || std::fflush(m_pFile) != 0)
+	{
+		LOG_ERROR_F("Failed to write to {}", GetActivePath(m_directory));
+		throw FILE_EXCEPTION_F("Failed to write to {}", GetActivePath(m_directory));
+	}
+
+#ifdef _WIN32
+	const bool synced = _commit(_fileno(m_pFile)) == 0;
+#else
+	const bool synced = fsync(fileno(m_pFile)) == 0;
+#endif
+	if (!synced)
+	{
+		LOG_ERROR_F("Failed to sync {}", GetActivePath(m_directory));
+		throw FILE_EXCEPTION_F("Failed to sync {}", GetActivePath(m_directory));
+	}
+
+	m_activeSize += record.size();
+}
+
+void WriteAheadLog::Rotate()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	std::fclose(m_pFile);
+	m_pFile = nullptr;
+
+	FileUtil::RenameFile(GetActivePath(m_directory), GetSealedPath(m_directory));
+
+	m_pFile = OpenForAppend(GetActivePath(m_directory));
+	m_activeSize = 0;
+}
+
+void WriteAheadLog::RemoveSealed()
+{
+	FileUtil::RemoveFile(GetSealedPath(m_directory));
+}
+
+uint64_t WriteAheadLog::GetActiveSize() const noexcept
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	return m_activeSize;
+}
+
+std::FILE* WriteAheadLog::OpenForAppend(const fs::path& path)
+{
+#ifdef _WIN32
+	std::FILE* pFile = _wfopen(path.c_str(), L"ab");
+#else
+	std::FILE* pFile = std::fopen(path.c_str(), "ab");
+#endif
+	if (pFile == nullptr)
+	{
+		LOG_ERROR_F("Failed to open {}", path);
+		throw FILE_EXCEPTION_F("Failed to open {}", path);
+	}
+
+	return pFile;
+}
+
+void WriteAheadLog::Replay(const fs::path& directory, const fs::path& logPath)
+{
+	std::vector<uint8_t> bytes;
+	if (!FileUtil::ReadFile(logPath, bytes) || bytes.empty())
+	{
+		return;
+	}
+
+	LOG_INFO_F("Replaying {} bytes from {}", bytes.size(), logPath);
+
+	ByteBuffer buffer(std::move(bytes));
+	std::set<fs::path> modifiedFiles;
+	size_t numRecords = 0;
+
+	try
+	{
+		while (buffer.GetRemainingSize() > 0)
+		{
+			if (buffer.ReadU32() != RECORD_MAGIC)
+			{
+				LOG_WARNING_F("Invalid record found in {}", logPath);
+				break;
+			}
+
+			const uint64_t payloadSize = buffer.ReadU64();
+			if (payloadSize + 32 > buffer.GetRemainingSize())
+			{
+				LOG_WARNING_F("Torn record found at end of {}", logPath);
+				break;
+			}
+
+			std::vector<uint8_t> payloadBytes = buffer.ReadVector(payloadSize);
+			const Hash checksum = buffer.ReadBigInteger<32>();
+			if (Hasher::Blake2b(payloadBytes) != checksum)
+			{
+				LOG_WARNING_F("Checksum mismatch in {}", logPath);
+				break;
+			}
+
+			ByteBuffer payload(std::move(payloadBytes));
+			const uint32_t numEntries = payload.ReadU32();
+			for (uint32_t i = 0; i < numEntries; i++)
+			{
+				const EType type = (EType)payload.ReadU8();
+				const fs::path path = directory / fs::u8path(payload.ReadVarStr());
+				const uint64_t offset = payload.ReadU64();
+				const std::vector<uint8_t> data = payload.ReadVector(payload.ReadU64());
+
+				if (!FileUtil::Exists(path))
+				{
+					std::ofstream create(path, std::ios::out | std::ios::binary | std::ios::app);
+				}
+
+				if (type == EType::APPEND && !FileUtil::TruncateFile(path, offset))
+				{
+					throw FILE_EXCEPTION_F("Failed to truncate {}", path);
+				}
+
+				if (!data.empty())
+				{
+					std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+					file.seekp(offset, std::ios::beg);
+					file.write((const char*)data.data(), data.size());
+					if (!file.good())
+					{
+						throw FILE_EXCEPTION_F("Failed to write to {}", path);
+					}
+				}
+
+				modifiedFiles.insert(path);
+			}
+
+			++numRecords;
+		}
+	}
+	catch (DeserializationException&)
+	{
+		LOG_WARNING_F("Torn record found at end of {}", logPath);
+	}
+
+	for (const fs::path& path : modifiedFiles)
+	{
+		if (!FileUtil::SyncFile(path))
+		{
+			throw FILE_EXCEPTION_F("Failed to sync {}", path);
+		}
+	}
+
+	LOG_INFO_F("Replayed {} records from {}", numRecords, logPath);
+}
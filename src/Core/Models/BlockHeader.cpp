@@ -40,20 +40,7 @@ BlockHeader::BlockHeader(
 
 void BlockHeader::Serialize(Serializer& serializer) const
 {
-	serializer.Append<uint16_t>(m_version);
-	serializer.Append<uint64_t>(m_height);
-	serializer.Append<int64_t>(m_timestamp);
-	serializer.AppendBigInteger<32>(m_previousBlockHash);
-	serializer.AppendBigInteger<32>(m_previousRoot);
-	serializer.AppendBigInteger<32>(m_outputRoot);
-	serializer.AppendBigInteger<32>(m_rangeProofRoot);
-	serializer.AppendBigInteger<32>(m_kernelRoot);
-	m_totalKernelOffset.Serialize(serializer);
-	serializer.Append<uint64_t>(m_outputMMRSize);
-	serializer.Append<uint64_t>(m_kernelMMRSize);
-	serializer.Append<uint64_t>(m_totalDifficulty);
-	serializer.Append<uint32_t>(m_scalingDifficulty);
-	serializer.Append<uint64_t>(m_nonce);
+	SerializePreProofOfWork(serializer);
 	m_proofOfWork.Serialize(serializer);
 }
 
@@ -184,6 +171,13 @@ std::shared_ptr<BlockHeader> BlockHeader::FromJSON(const Json::Value& json)
 std::vector<unsigned char> BlockHeader::GetPreProofOfWork() const
 {
 	Serializer serializer;
+	SerializePreProofOfWork(serializer);
+
+	return serializer.GetBytes();
+}
+
+void BlockHeader::SerializePreProofOfWork(Serializer& serializer) const
+{
 	serializer.Append<uint16_t>(m_version);
 	serializer.Append<uint64_t>(m_height);
 	serializer.Append<int64_t>(m_timestamp);
@@ -198,6 +192,4 @@ std::vector<unsigned char> BlockHeader::GetPreProofOfWork() const
 	serializer.Append<uint64_t>(m_totalDifficulty);
 	serializer.Append<uint32_t>(m_scalingDifficulty);
 	serializer.Append<uint64_t>(m_nonce);
-
-	return serializer.GetBytes();
 }
\ No newline at end of file
@@ -1,14 +1,15 @@
 #include <Core/Models/ProofOfWork.h>
 #include <Consensus/BlockDifficulty.h>
 #include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 
 ProofOfWork::ProofOfWork(const uint8_t edgeBits, std::vector<uint64_t>&& proofNonces)
 	: m_edgeBits(edgeBits),
 	m_proofNonces(std::move(proofNonces))
 {
-	Serializer serializer;
-	SerializeCycle(serializer);
-	m_hash = Hasher::Blake2b(serializer.GetBytes());
+	Blake2bHasher hasher;
+	SerializeCycle(hasher);
+	m_hash = hasher.Finalize();
 }
 
 ProofOfWork::ProofOfWork(const uint8_t edgeBits, std::vector<uint64_t>&& proofNonces, Hash&& hash)
@@ -1,5 +1,6 @@
 #include <Core/Models/ShortId.h>
 #include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 
 ShortId::ShortId(CBigInteger<6>&& id)
 	: m_id(id)
@@ -10,10 +11,10 @@ ShortId::ShortId(CBigInteger<6>&& id)
 ShortId ShortId::Create(const CBigInteger<32>& hash, const CBigInteger<32>& blockHash, const uint64_t nonce)
 {
 	// take the block hash and the nonce and hash them together
-	Serializer serializer;
-	serializer.AppendBigInteger<32>(blockHash);
-	serializer.Append<uint64_t>(nonce);
-	const CBigInteger<32> hashWithNonce = Hasher::Blake2b(serializer.GetBytes());
+	Blake2bHasher hasher;
+	hasher.AppendBigInteger<32>(blockHash);
+	hasher.Append<uint64_t>(nonce);
+	const CBigInteger<32> hashWithNonce = hasher.Finalize();
 
 	// extract k0/k1 from the block_hash
 	ByteBuffer byteBuffer(hashWithNonce.GetData());
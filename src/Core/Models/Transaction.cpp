@@ -1,6 +1,6 @@
 #include <Core/Models/Transaction.h>
 
-#include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 #include <Core/Serialization/Serializer.h>
 #include <Core/Util/JsonUtil.h>
 
@@ -66,9 +66,7 @@ const Hash& Transaction::GetHash() const
 	std::unique_lock lock(m_mutex);
 
 	if (m_hash == Hash{}) {
-		Serializer serializer;
-		Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+		m_hash = Blake2bHasher::Compute(*this);
 	}
 
 	return m_hash;
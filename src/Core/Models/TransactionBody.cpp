@@ -2,14 +2,27 @@
 
 #include <Core/Serialization/Serializer.h>
 #include <Core/Util/JsonUtil.h>
+#include <algorithm>
 
 TransactionBody::TransactionBody(std::vector<TransactionInput>&& inputs, std::vector<TransactionOutput>&& outputs, std::vector<TransactionKernel>&& kernels)
 	: m_inputs(std::move(inputs)), m_outputs(std::move(outputs)), m_kernels(std::move(kernels))
 {
 	// TODO: Figure out why this is necessary. We're apparently missing a sort when creating transactions in the wallet.
-	std::sort(m_inputs.begin(), m_inputs.end(), SortInputsByHash);
-	std::sort(m_outputs.begin(), m_outputs.end(), SortOutputsByHash);
-	std::sort(m_kernels.begin(), m_kernels.end(), SortKernelsByHash);
+	// Bodies built by merging sorted ones (eg. aggregates) are already sorted, so only the check is paid for.
+	if (!std::is_sorted(m_inputs.cbegin(), m_inputs.cend(), SortInputsByHash))
+	{
+		std::sort(m_inputs.begin(), m_inputs.end(), SortInputsByHash);
+	}
+
+	if (!std::is_sorted(m_outputs.cbegin(), m_outputs.cend(), SortOutputsByHash))
+	{
+		std::sort(m_outputs.begin(), m_outputs.end(), SortOutputsByHash);
+	}
+
+	if (!std::is_sorted(m_kernels.cbegin(), m_kernels.cend(), SortKernelsByHash))
+	{
+		std::sort(m_kernels.begin(), m_kernels.end(), SortKernelsByHash);
+	}
 }
 
 void TransactionBody::Serialize(Serializer& serializer) const
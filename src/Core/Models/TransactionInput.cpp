@@ -2,14 +2,12 @@
 
 #include <Core/Serialization/Serializer.h>
 #include <Core/Util/JsonUtil.h>
-#include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 
 TransactionInput::TransactionInput(const EOutputFeatures features, Commitment&& commitment)
 	: m_features(features), m_commitment(std::move(commitment))
 {
-		Serializer serializer;
-		Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+		m_hash = Blake2bHasher::Compute(*this);
 }
 
 void TransactionInput::Serialize(Serializer& serializer) const
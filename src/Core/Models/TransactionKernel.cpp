@@ -3,23 +3,19 @@
 #include <Core/Serialization/Serializer.h>
 #include <Core/Util/JsonUtil.h>
 #include <Crypto/Crypto.h>
-#include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 #include <Consensus/BlockTime.h>
 
 TransactionKernel::TransactionKernel(const EKernelFeatures features, const uint64_t fee, const uint64_t lockHeight, Commitment&& excessCommitment, Signature&& excessSignature)
 	: m_features(features), m_fee(fee), m_lockHeight(lockHeight), m_excessCommitment(std::move(excessCommitment)), m_excessSignature(std::move(excessSignature))
 {
-		Serializer serializer{ EProtocolVersion::V1 };
-		Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+		m_hash = Blake2bHasher::Compute(*this, EProtocolVersion::V1);
 }
 
 TransactionKernel::TransactionKernel(const EKernelFeatures features, const uint64_t fee, const uint64_t lockHeight, const Commitment& excessCom, const Signature& excessSig)
 	: m_features(features), m_fee(fee), m_lockHeight(lockHeight), m_excessCommitment(excessCom), m_excessSignature(excessSig)
 {
-		Serializer serializer{ EProtocolVersion::V1 };
-		Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+		m_hash = Blake2bHasher::Compute(*this, EProtocolVersion::V1);
 }
 
 void TransactionKernel::Serialize(Serializer& serializer) const
@@ -154,25 +150,25 @@ TransactionKernel TransactionKernel::FromJSON(const Json::Value& transactionKern
 
 Hash TransactionKernel::GetSignatureMessage(const EKernelFeatures features, const uint64_t fee, const uint64_t lockHeight)
 {
-	Serializer serializer;
-	serializer.Append<uint8_t>((uint8_t)features);
+	Blake2bHasher hasher;
+	hasher.Append<uint8_t>((uint8_t)features);
 
 	if (features != EKernelFeatures::COINBASE_KERNEL)
 	{
-		serializer.Append<uint64_t>(fee);
+		hasher.Append<uint64_t>(fee);
 	}
 
 	if (features == EKernelFeatures::HEIGHT_LOCKED)
 	{
-		serializer.Append<uint64_t>(lockHeight);
+		hasher.Append<uint64_t>(lockHeight);
 	}
 
 	if (features == EKernelFeatures::NO_RECENT_DUPLICATE)
 	{
-		serializer.Append<uint16_t>((uint16_t)lockHeight);
+		hasher.Append<uint16_t>((uint16_t)lockHeight);
 	}
 
-	return Hasher::Blake2b(serializer.GetBytes());
+	return hasher.Finalize();
 }
 
 Hash TransactionKernel::GetSignatureMessage() const
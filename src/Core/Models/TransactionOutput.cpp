@@ -1,29 +1,29 @@
 #include <Core/Models/TransactionOutput.h>
 #include <Core/Util/JsonUtil.h>
-#include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 
 TransactionOutput::TransactionOutput(const EOutputFeatures features, Commitment&& commitment, RangeProof&& rangeProof)
 	: m_features(features), m_commitment(std::move(commitment)), m_rangeProof(std::move(rangeProof))
 {
-		Serializer serializer;
+		Blake2bHasher hasher;
 		// Serialize OutputFeatures
-		serializer.Append<uint8_t>((uint8_t)m_features);
+		hasher.Append<uint8_t>((uint8_t)m_features);
 
 		// Serialize Commitment
-		m_commitment.Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+		m_commitment.Serialize(hasher);
+		m_hash = hasher.Finalize();
 }
 
 TransactionOutput::TransactionOutput(const EOutputFeatures features, const Commitment& commitment, const RangeProof& rangeProof)
 	: m_features(features), m_commitment(commitment), m_rangeProof(rangeProof)
 {
-		Serializer serializer;
+		Blake2bHasher hasher;
 		// Serialize OutputFeatures
-		serializer.Append<uint8_t>((uint8_t)m_features);
+		hasher.Append<uint8_t>((uint8_t)m_features);
 
 		// Serialize Commitment
-		m_commitment.Serialize(serializer);
-		m_hash = Hasher::Blake2b(serializer.GetBytes());
+		m_commitment.Serialize(hasher);
+		m_hash = hasher.Finalize();
 }
 
 void TransactionOutput::Serialize(Serializer& serializer) const
@@ -0,0 +1,139 @@
+#include <Core/Validation/KernelSignatureBatcher.h>
+#include <Core/Validation/KernelSignatureValidator.h>
+
+#include <Common/Logger.h>
+#include <Common/ThreadManager.h>
+#include <Common/Util/ThreadUtil.h>
+#include <Crypto/Crypto.h>
+
+KernelSignatureBatcher& KernelSignatureBatcher::GetInstance()
+{
+	static KernelSignatureBatcher instance(DEFAULT_MAX_BATCH_SIZE, DEFAULT_MAX_DELAY);
+	return instance;
+}
+
+KernelSignatureBatcher::KernelSignatureBatcher(const size_t maxBatchSize, const std::chrono::microseconds& maxDelay)
+	: m_maxBatchSize(maxBatchSize), m_maxDelay(maxDelay), m_numPending(0), m_shutdown(false)
+{
+	m_thread = std::thread(&KernelSignatureBatcher::Run, this);
+}
+
+KernelSignatureBatcher::~KernelSignatureBatcher()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_shutdown = true;
+	}
+
+	m_condition.notify_all();
+	ThreadUtil::Join(m_thread);
+}
+
+std::future<bool> KernelSignatureBatcher::Verify(const std::vector<TransactionKernel>& kernels)
+{
+	if (kernels.empty() || kernels.size() >= m_maxBatchSize)
+	{
+		std::promise<bool> promise;
+		promise.set_value(kernels.empty() || KernelSignatureValidator::VerifyKernelSignatures(kernels));
+		return promise.get_future();
+	}
+
+	std::unique_ptr<Request> pRequest = std::make_unique<Request>();
+	pRequest->signatures.reserve(kernels.size());
+	pRequest->commitments.reserve(kernels.size());
+	pRequest->messages.reserve(kernels.size());
+	for (const TransactionKernel& kernel : kernels)
+	{
+		pRequest->signatures.push_back(kernel.GetExcessSignature());
+		pRequest->commitments.push_back(kernel.GetExcessCommitment());
+		pRequest->messages.push_back(kernel.GetSignatureMessage());
+	}
+
+	std::future<bool> future = pRequest->promise.get_future();
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_pending.empty())
+		{
+			m_firstQueued = std::chrono::steady_clock::now();
+		}
+
+		m_numPending += kernels.size();
+		m_pending.push_back(std::move(pRequest));
+	}
+
+	m_condition.notify_one();
+	return future;
+}
+
+void KernelSignatureBatcher::Run()
+{
+	ThreadManagerAPI::SetCurrentThreadName("KERNEL_BATCHER");
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this] { return !m_pending.empty() || m_shutdown; });
+		if (m_pending.empty())
+		{
+			break;
+		}
+
+		// Give other callers until the deadline to join the batch, unless it fills up first.
+		m_condition.wait_until(
+			lock,
+			m_firstQueued + m_maxDelay,
+			[this] { return m_numPending >= m_maxBatchSize || m_shutdown; }
+		);
+
+		std::vector<std::unique_ptr<Request>> batch;
+		batch.swap(m_pending);
+		m_numPending = 0;
+		lock.unlock();
+
+		if (VerifyRequests(batch, 0, batch.size()))
+		{
+			for (std::unique_ptr<Request>& pRequest : batch)
+			{
+				pRequest->promise.set_value(true);
+			}
+		}
+		else
+		{
+			LOG_DEBUG_F("Batch of {} kernel signature requests failed. Verifying them individually.", batch.size());
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				batch[i]->promise.set_value(batch.size() > 1 && VerifyRequests(batch, i, i + 1));
+			}
+		}
+
+		lock.lock();
+	}
+}
+
+bool KernelSignatureBatcher::VerifyRequests(const std::vector<std::unique_ptr<Request>>& requests, const size_t begin, const size_t end)
+{
+	std::vector<const Signature*> signatures;
+	std::vector<const Commitment*> commitments;
+	std::vector<const Hash*> messages;
+	for (size_t i = begin; i < end; i++)
+	{
+		const Request& request = *requests[i];
+		for (size_t j = 0; j < request.signatures.size(); j++)
+		{
+			signatures.push_back(&request.signatures[j]);
+			commitments.push_back(&request.commitments[j]);
+			messages.push_back(&request.messages[j]);
+		}
+	}
+
+	try
+	{
+		return Crypto::VerifyKernelSignatures(signatures, commitments, messages);
+	}
+	catch (std::exception& e)
+	{
+		LOG_ERROR_F("Exception thrown while verifying kernel signatures: {}", e.what());
+		return false;
+	}
+}
@@ -3,19 +3,17 @@
 #include <Core/Validation/KernelSignatureValidator.h>
 #include <Core/Exceptions/BadDataException.h>
 #include <Consensus/BlockWeight.h>
-#include <Consensus/Sorting.h>
 #include <Common/Logger.h>
 #include <Common/Util/HexUtil.h>
 #include <Crypto/Crypto.h>
-#include <set>
+#include <Crypto/Blake2bHasher.h>
+#include <algorithm>
 
 // Validates all relevant parts of a transaction body. 
 // Checks the excess value against the signature as well as range proofs for each output.
 void TransactionBodyValidator::Validate(const TransactionBody& transactionBody, const bool withReward)
 {
-	ValidateWeight(transactionBody, withReward);
-	VerifySorted(transactionBody);
-	VerifyCutThrough(transactionBody);
+	ValidateStructure(transactionBody, withReward);
 	VerifyRangeProofs(transactionBody.GetOutputs());
 	
 	if (!KernelSignatureValidator::VerifyKernelSignatures(transactionBody.GetKernels()))
@@ -24,6 +22,12 @@ void TransactionBodyValidator::Validate(const TransactionBody& transactionBody,
 	}
 }
 
+void TransactionBodyValidator::ValidateStructure(const TransactionBody& transactionBody, const bool withReward)
+{
+	ValidateWeight(transactionBody, withReward);
+	VerifySortedAndCutThrough(transactionBody);
+}
+
 // Verify the body is not too big in terms of number of inputs|outputs|kernels.
 void TransactionBodyValidator::ValidateWeight(const TransactionBody& transactionBody, const bool withReward)
 {
@@ -39,45 +43,66 @@ void TransactionBodyValidator::ValidateWeight(const TransactionBody& transaction
 	}
 }
 
-void TransactionBodyValidator::VerifySorted(const TransactionBody& transactionBody)
+// Verify the inputs, outputs, and kernels are each sorted by hash with no duplicates,
+// and that no input is spending an output from the same block.
+// Inputs and outputs with the same features and commitment hash the same, so that's checked while merging the 2 sorted lists.
+void TransactionBodyValidator::VerifySortedAndCutThrough(const TransactionBody& transactionBody)
 {
-	// TODO: Check for duplicates?
-	const bool sorted = Consensus::IsSorted(transactionBody.GetInputs())
-		&& Consensus::IsSorted(transactionBody.GetOutputs())
-		&& Consensus::IsSorted(transactionBody.GetKernels());
-	if (!sorted)
+	const std::vector<TransactionInput>& inputs = transactionBody.GetInputs();
+	const std::vector<TransactionOutput>& outputs = transactionBody.GetOutputs();
+	const std::vector<TransactionKernel>& kernels = transactionBody.GetKernels();
+
+	auto inputIter = inputs.cbegin();
+	auto outputIter = outputs.cbegin();
+	while (inputIter != inputs.cend() || outputIter != outputs.cend())
 	{
-		throw BAD_DATA_EXCEPTION("Inputs, outputs, and/or kernels not sorted.");
+		if (outputIter == outputs.cend() || (inputIter != inputs.cend() && inputIter->GetHash() < outputIter->GetHash()))
+		{
+			VerifyNextIsGreater(inputIter++, inputs.cend());
+		}
+		else if (inputIter == inputs.cend() || outputIter->GetHash() < inputIter->GetHash())
+		{
+			VerifyNextIsGreater(outputIter++, outputs.cend());
+		}
+		else
+		{
+			throw BAD_DATA_EXCEPTION("Cut-through not performed correctly.");
+		}
 	}
-}
 
-// Verify that no input is spending an output from the same block.
-void TransactionBodyValidator::VerifyCutThrough(const TransactionBody& transactionBody)
-{
-	const std::vector<TransactionOutput>& outputs = transactionBody.GetOutputs();
-	const std::vector<TransactionInput>& inputs = transactionBody.GetInputs();
+	for (auto kernelIter = kernels.cbegin(); kernelIter != kernels.cend(); kernelIter++)
+	{
+		VerifyNextIsGreater(kernelIter, kernels.cend());
+	}
 
-	// Create set with output commitments
-	std::set<Commitment> commitments;
-	std::transform(
-		outputs.cbegin(),
-		outputs.cend(),
-		std::inserter(commitments, commitments.end()),
-		[](const TransactionOutput& output) { return output.GetCommitment(); }
-	);
+	// An input and output with the same commitment but different features don't hash the same.
+	// One of them has to be a coinbase, and there are rarely more than a few of those, so each one is looked up again as a plain output.
+	for (const TransactionOutput& output : outputs)
+	{
+		if (output.IsCoinbase() && ContainsHash(inputs, HashWithFeatures(EOutputFeatures::DEFAULT, output.GetCommitment())))
+		{
+			throw BAD_DATA_EXCEPTION("Cut-through not performed correctly.");
+		}
+	}
 
-	// Verify none of the input commitments are in the commitments set
-	const bool invalid = std::any_of(
-		inputs.cbegin(),
-		inputs.cend(),
-		[&commitments](const TransactionInput& input) { return commitments.find(input.GetCommitment()) != commitments.cend(); }
-	);
-	if (invalid)
+	for (const TransactionInput& input : inputs)
 	{
-		throw BAD_DATA_EXCEPTION("Cut-through not performed correctly.");
+		if (input.IsCoinbase() && ContainsHash(outputs, HashWithFeatures(EOutputFeatures::DEFAULT, input.GetCommitment())))
+		{
+			throw BAD_DATA_EXCEPTION("Cut-through not performed correctly.");
+		}
 	}
 }
 
+Hash TransactionBodyValidator::HashWithFeatures(const EOutputFeatures features, const Commitment& commitment)
+{
+	// Same as the hash of an input or output.
+	Blake2bHasher hasher;
+	hasher.Append<uint8_t>((uint8_t)features);
+	commitment.Serialize(hasher);
+	return hasher.Finalize();
+}
+
 void TransactionBodyValidator::VerifyRangeProofs(const std::vector<TransactionOutput>& outputs)
 {
 	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
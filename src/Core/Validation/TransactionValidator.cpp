@@ -3,21 +3,123 @@
 
 #include <Common/Util/HexUtil.h>
 #include <Core/Validation/KernelSumValidator.h>
+#include <Core/Validation/KernelSignatureBatcher.h>
+#include <Crypto/Crypto.h>
 #include <Common/Logger.h>
 #include <algorithm>
+#include <future>
 #include <numeric>
 
 // See: https://github.com/mimblewimble/docs/wiki/Validation-logic
 void TransactionValidator::Validate(const Transaction& transaction) const
 {
-	// Validate the "transaction body"
-	TransactionBodyValidator().Validate(transaction.GetBody(), true);
+	// Validate the "transaction body", except for the rangeproofs and kernel signatures
+	TransactionBodyValidator bodyValidator;
+	bodyValidator.ValidateStructure(transaction.GetBody(), true);
 
 	// Verify no output or kernel includes invalid features (coinbase)
 	ValidateFeatures(transaction.GetBody());
 
 	// Verify the big "sum": all inputs plus reward+fee, all output commitments, all kernels plus the kernel excess
 	ValidateKernelSums(transaction);
+
+	// The kernel signatures share a batch with other transactions being validated concurrently, and the rangeproofs are verified while they wait.
+	std::future<bool> kernelsValid = KernelSignatureBatcher::GetInstance().Verify(transaction.GetKernels());
+	if (!transaction.GetOutputs().empty())
+	{
+		bodyValidator.VerifyRangeProofs(transaction.GetOutputs());
+	}
+
+	if (!kernelsValid.get())
+	{
+		throw BAD_DATA_EXCEPTION("Kernel signatures invalid");
+	}
+}
+
+std::vector<bool> TransactionValidator::ValidateBatch(const std::vector<TransactionPtr>& transactions) const
+{
+	std::vector<bool> valid(transactions.size(), false);
+
+	std::vector<size_t> indices;
+	std::vector<TransactionPtr> toVerify;
+	for (size_t i = 0; i < transactions.size(); i++)
+	{
+		try
+		{
+			TransactionBodyValidator().ValidateStructure(transactions[i]->GetBody(), true);
+			ValidateFeatures(transactions[i]->GetBody());
+			ValidateKernelSums(*transactions[i]);
+
+			indices.push_back(i);
+			toVerify.push_back(transactions[i]);
+		}
+		catch (std::exception& e)
+		{
+			LOG_WARNING_F("Invalid transaction ({}). Error: ({})", *transactions[i], e.what());
+		}
+	}
+
+	if (toVerify.empty())
+	{
+		return valid;
+	}
+
+	if (VerifyProofs(toVerify))
+	{
+		for (const size_t index : indices)
+		{
+			valid[index] = true;
+		}
+	}
+	else
+	{
+		// Queue every transaction's kernels up front, so they still share batches while each gets its own result.
+		std::vector<std::future<bool>> kernelsValid;
+		for (const TransactionPtr& pTransaction : toVerify)
+		{
+			kernelsValid.push_back(KernelSignatureBatcher::GetInstance().Verify(pTransaction->GetKernels()));
+		}
+
+		for (size_t i = 0; i < toVerify.size(); i++)
+		{
+			valid[indices[i]] = VerifyRangeProofs({ toVerify[i] }) && kernelsValid[i].get();
+			if (!valid[indices[i]])
+			{
+				LOG_WARNING_F("Invalid transaction ({}). Error: (Rangeproofs or kernel signatures invalid)", *toVerify[i]);
+			}
+		}
+	}
+
+	return valid;
+}
+
+bool TransactionValidator::VerifyProofs(const std::vector<TransactionPtr>& transactions) const
+{
+	std::vector<TransactionKernel> kernels;
+	for (const TransactionPtr& pTransaction : transactions)
+	{
+		const std::vector<TransactionKernel>& transactionKernels = pTransaction->GetKernels();
+		kernels.insert(kernels.end(), transactionKernels.cbegin(), transactionKernels.cend());
+	}
+
+	// Small batches share a batch with other transactions being validated concurrently.
+	std::future<bool> kernelsValid = KernelSignatureBatcher::GetInstance().Verify(kernels);
+
+	return VerifyRangeProofs(transactions) && kernelsValid.get();
+}
+
+bool TransactionValidator::VerifyRangeProofs(const std::vector<TransactionPtr>& transactions) const
+{
+	std::vector<std::pair<Commitment, RangeProof>> rangeProofs;
+	for (const TransactionPtr& pTransaction : transactions)
+	{
+		for (const TransactionOutput& output : pTransaction->GetOutputs())
+		{
+			rangeProofs.push_back(std::make_pair(output.GetCommitment(), output.GetRangeProof()));
+		}
+	}
+
+	return rangeProofs.empty() || Crypto::VerifyRangeProofs(rangeProofs);
 }
 
 void TransactionValidator::ValidateFeatures(const TransactionBody& transactionBody) const
@@ -1,5 +1,6 @@
 #include "AggSig.h"
-#include "Pedersen.h"
+#include "Context.h"
+#include "ParsedCommitments.h"
 
 #include <secp256k1-zkp/secp256k1_generator.h>
 #include <secp256k1-zkp/secp256k1_aggsig.h>
@@ -9,9 +10,6 @@
 #include <Crypto/CSPRNG.h>
 #include <Crypto/CryptoException.h>
 
-const uint64_t MAX_WIDTH = 1 << 20;
-const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
-
 static AggSig instance;
 
 AggSig& AggSig::GetInstance()
@@ -19,24 +17,14 @@ AggSig& AggSig::GetInstance()
 	return instance;
 }
 
-AggSig::AggSig()
-{
-	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-}
-
-AggSig::~AggSig()
-{
-	secp256k1_context_destroy(m_pContext);
-}
-
 SecretKey AggSig::GenerateSecureNonce() const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	std::vector<unsigned char> nonce(32);
 	const SecretKey seed = CSPRNG::GenerateRandom32();
 
-	const int result = secp256k1_aggsig_export_secnonce_single(m_pContext, nonce.data(), seed.data());
+	const int result = secp256k1_aggsig_export_secnonce_single(pContext->Get(), nonce.data(), seed.data());
 	if (result == 1)
 	{
 		return SecretKey(CBigInteger<32>(std::move(nonce)));
@@ -47,18 +35,12 @@ SecretKey AggSig::GenerateSecureNonce() const
 
 std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, const Commitment& commitment, const Hash& message)
 {
-	std::lock_guard<std::shared_mutex> writeLock(m_mutex);
-
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
+	secp256k1_context* pRandomizedContext = pContext->Randomized();
 	const SecretKey randomSeed = CSPRNG::GenerateRandom32();
-	const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
-	if (randomizeResult != 1)
-	{
-		LOG_ERROR("Context randomization failed");
-		return nullptr;
-	}
 
 	secp256k1_pedersen_commitment parsedCommitment;
-	const int commitmentResult = secp256k1_pedersen_commitment_parse(m_pContext, &parsedCommitment, commitment.data());
+	const int commitmentResult = secp256k1_pedersen_commitment_parse(pRandomizedContext, &parsedCommitment, commitment.data());
 	if (commitmentResult != 1)
 	{
 		LOG_ERROR("secp256k1_pedersen_commitment_parse failed");
@@ -66,7 +48,7 @@ std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, co
 	}
 
 	secp256k1_pubkey pubKey;
-	const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(m_pContext, &pubKey, &parsedCommitment);
+	const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(pRandomizedContext, &pubKey, &parsedCommitment);
 	if (pubkeyResult != 1)
 	{
 		LOG_ERROR("secp256k1_pedersen_commitment_to_pubkey failed");
@@ -75,7 +57,7 @@ std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, co
 
 	secp256k1_ecdsa_signature signature;
 	const int signedResult = secp256k1_aggsig_sign_single(
-		m_pContext,
+		pRandomizedContext,
 		&signature.data[0],
 		message.data(),
 		secretKey.data(),
@@ -98,29 +80,25 @@ std::unique_ptr<Signature> AggSig::BuildSignature(const SecretKey& secretKey, co
 
 CompactSignature AggSig::CalculatePartialSignature(const SecretKey& secretKey, const SecretKey& secretNonce, const PublicKey& sumPubKeys, const PublicKey& sumPubNonces, const Hash& message)
 {
-	std::lock_guard<std::shared_mutex> writeLock(m_mutex);
-
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
+	secp256k1_context* pRandomizedContext = pContext->Randomized();
 	const SecretKey randomSeed = CSPRNG::GenerateRandom32();
-	const int randomize_result = secp256k1_context_randomize(m_pContext, randomSeed.data());
-    if (randomize_result != 1) {
-		throw CRYPTO_EXCEPTION_F("secp256k1_context_randomize failed with error {}", randomize_result);
-    }
 
 	secp256k1_pubkey pubKeyForE;
-	int pubkey_parsed = secp256k1_ec_pubkey_parse(m_pContext, &pubKeyForE, sumPubKeys.data(), sumPubKeys.size());
+	int pubkey_parsed = secp256k1_ec_pubkey_parse(pRandomizedContext, &pubKeyForE, sumPubKeys.data(), sumPubKeys.size());
 	if (pubkey_parsed != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_pubkey_parse failed with error {}", pubkey_parsed);
 	}
 
 	secp256k1_pubkey pubNoncesForE;
-	int nonces_parsed = secp256k1_ec_pubkey_parse(m_pContext, &pubNoncesForE, sumPubNonces.data(), sumPubNonces.size());
+	int nonces_parsed = secp256k1_ec_pubkey_parse(pRandomizedContext, &pubNoncesForE, sumPubNonces.data(), sumPubNonces.size());
 	if (nonces_parsed != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_pubkey_parse failed with error {}", nonces_parsed);
 	}
 
 	secp256k1_ecdsa_signature signature;
 	const int signed_result = secp256k1_aggsig_sign_single(
-		m_pContext,
+		pRandomizedContext,
 		&signature.data[0],
 		message.data(),
 		secretKey.data(),
@@ -136,7 +114,7 @@ CompactSignature AggSig::CalculatePartialSignature(const SecretKey& secretKey, c
 	}
 
 	CompactSignature result;
-	const int serialized_result = secp256k1_ecdsa_signature_serialize_compact(m_pContext, result.data(), &signature);
+	const int serialized_result = secp256k1_ecdsa_signature_serialize_compact(pRandomizedContext, result.data(), &signature);
 	if (serialized_result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ecdsa_signature_serialize_compact failed with error {}", serialized_result);
 	}
@@ -146,25 +124,25 @@ CompactSignature AggSig::CalculatePartialSignature(const SecretKey& secretKey, c
 
 bool AggSig::VerifyPartialSignature(const CompactSignature& partialSignature, const PublicKey& publicKey, const PublicKey& sumPubKeys, const PublicKey& sumPubNonces, const Hash& message) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	secp256k1_ecdsa_signature signature;
 	
-	const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(m_pContext, &signature, partialSignature.GetSignatureBytes().data());
+	const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(pContext->Get(), &signature, partialSignature.GetSignatureBytes().data());
 	if (parseSignatureResult == 1)
 	{
 		secp256k1_pubkey pubkey;
-		const int pubkeyResult = secp256k1_ec_pubkey_parse(m_pContext, &pubkey, publicKey.data(), publicKey.size());
+		const int pubkeyResult = secp256k1_ec_pubkey_parse(pContext->Get(), &pubkey, publicKey.data(), publicKey.size());
 
 		secp256k1_pubkey sumPubKey;
-		const int sumPubkeysResult = secp256k1_ec_pubkey_parse(m_pContext, &sumPubKey, sumPubKeys.data(), sumPubKeys.size());
+		const int sumPubkeysResult = secp256k1_ec_pubkey_parse(pContext->Get(), &sumPubKey, sumPubKeys.data(), sumPubKeys.size());
 
 		secp256k1_pubkey sumNoncesPubKey;
-		const int sumPubNonceKeyResult = secp256k1_ec_pubkey_parse(m_pContext, &sumNoncesPubKey, sumPubNonces.data(), sumPubNonces.size());
+		const int sumPubNonceKeyResult = secp256k1_ec_pubkey_parse(pContext->Get(), &sumNoncesPubKey, sumPubNonces.data(), sumPubNonces.size());
 
 		if (pubkeyResult == 1 && sumPubkeysResult == 1 && sumPubNonceKeyResult == 1)
 		{
-			const int verifyResult = secp256k1_aggsig_verify_single(m_pContext, signature.data, message.data(), &sumNoncesPubKey, &pubkey, &sumPubKey, nullptr, true);
+			const int verifyResult = secp256k1_aggsig_verify_single(pContext->Get(), signature.data, message.data(), &sumNoncesPubKey, &pubkey, &sumPubKey, nullptr, true);
 			if (verifyResult == 1)
 			{
 				return true;
@@ -177,13 +155,13 @@ bool AggSig::VerifyPartialSignature(const CompactSignature& partialSignature, co
 
 std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<CompactSignature>& signatures, const PublicKey& sumPubNonces) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	secp256k1_pubkey pubNonces;
-	const int noncesParsed = secp256k1_ec_pubkey_parse(m_pContext, &pubNonces, sumPubNonces.data(), sumPubNonces.size());
+	const int noncesParsed = secp256k1_ec_pubkey_parse(pContext->Get(), &pubNonces, sumPubNonces.data(), sumPubNonces.size());
 	if (noncesParsed == 1)
 	{
-		std::vector<secp256k1_ecdsa_signature> parsedSignatures = ParseCompactSignatures(signatures);
+		std::vector<secp256k1_ecdsa_signature> parsedSignatures = ParseCompactSignatures(pContext->Get(), signatures);
 		if (!parsedSignatures.empty())
 		{
 			std::vector<secp256k1_ecdsa_signature*> signaturePointers;
@@ -196,7 +174,7 @@ std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<Compact
 
 			secp256k1_ecdsa_signature aggregatedSignature;
 			const int result = secp256k1_aggsig_add_signatures_single(
-				m_pContext, 
+				pContext->Get(), 
 				aggregatedSignature.data, 
 				(const unsigned char**)signaturePointers.data(), 
 				signaturePointers.size(), 
@@ -216,30 +194,25 @@ std::unique_ptr<Signature> AggSig::AggregateSignatures(const std::vector<Compact
 
 bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& signatures, const std::vector<const Commitment*>& commitments, const std::vector<const Hash*>& messages) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
-	std::vector<secp256k1_pubkey> parsedPubKeys;
-	for (const Commitment* commitment : commitments)
+	std::unique_ptr<ParsedCommitments> pParsedCommitments = nullptr;
+	try
 	{
-		secp256k1_pedersen_commitment parsedCommitment;
-		const int commitmentResult = secp256k1_pedersen_commitment_parse(m_pContext, &parsedCommitment, commitment->data());
-		if (commitmentResult == 1)
-		{
-			secp256k1_pubkey pubKey;
-			const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(m_pContext, &pubKey, &parsedCommitment);
-			if (pubkeyResult == 1)
-			{
-				parsedPubKeys.emplace_back(std::move(pubKey));
-			}
-			else
-			{
-				LOG_ERROR("Failed to convert commitment to pubkey: " + commitment->ToHex());
-				return false;
-			}
-		}
-		else
+		pParsedCommitments = std::make_unique<ParsedCommitments>(pContext->Get(), commitments);
+	}
+	catch (CryptoException&)
+	{
+		return false;
+	}
+
+	std::vector<secp256k1_pubkey> parsedPubKeys(commitments.size());
+	for (size_t i = 0; i < commitments.size(); i++)
+	{
+		const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(pContext->Get(), &parsedPubKeys[i], (*pParsedCommitments)[i]);
+		if (pubkeyResult != 1)
 		{
-			LOG_ERROR("Failed to parse commitment " + commitment->ToHex());
+			LOG_ERROR("Failed to convert commitment to pubkey: " + commitments[i]->ToHex());
 			return false;
 		}
 	}
@@ -254,7 +227,7 @@ bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& sign
 	for (const Signature* signature : signatures)
 	{
 		secp256k1_schnorrsig parsedSig;
-		if (secp256k1_schnorrsig_parse(m_pContext, &parsedSig, signature->GetSignatureBytes().data()) == 0)
+		if (secp256k1_schnorrsig_parse(pContext->Get(), &parsedSig, signature->GetSignatureBytes().data()) == 0)
 		{
 			return false;
 		}
@@ -278,9 +251,10 @@ bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& sign
 		[](const Hash* pMessage) { return pMessage->data(); }
 	);
 
-	secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
-	const int verifyResult = secp256k1_schnorrsig_verify_batch(m_pContext, pScratchSpace, signaturePtrs.data(), messageData.data(), pubKeyPtrs.data(), signatures.size());
-	secp256k1_scratch_space_destroy(pScratchSpace);
+	// Batch verification only pays off for multiple signatures, and needs the scratch space.
+	const int verifyResult = signatures.size() == 1
+		? secp256k1_schnorrsig_verify(pContext->Get(), signaturePtrs.front(), messageData.front(), pubKeyPtrs.front())
+		: secp256k1_schnorrsig_verify_batch(pContext->Get(), pContext->GetScratchSpace(), signaturePtrs.data(), messageData.data(), pubKeyPtrs.data(), signatures.size());
 
 	if (verifyResult == 1)
 	{
@@ -295,13 +269,13 @@ bool AggSig::VerifyAggregateSignatures(const std::vector<const Signature*>& sign
 
 bool AggSig::VerifyAggregateSignature(const Signature& signature, const PublicKey& sumPubKeys, const Hash& message) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	secp256k1_pubkey parsedPubKey;
-	const int parseResult = secp256k1_ec_pubkey_parse(m_pContext, &parsedPubKey, sumPubKeys.data(), sumPubKeys.size());
+	const int parseResult = secp256k1_ec_pubkey_parse(pContext->Get(), &parsedPubKey, sumPubKeys.data(), sumPubKeys.size());
 	if (parseResult == 1)
 	{
-		const int verifyResult = secp256k1_aggsig_verify_single(m_pContext, signature.GetSignatureBytes().data(), message.data(), nullptr, &parsedPubKey, &parsedPubKey, nullptr, false);
+		const int verifyResult = secp256k1_aggsig_verify_single(pContext->Get(), signature.GetSignatureBytes().data(), message.data(), nullptr, &parsedPubKey, &parsedPubKey, nullptr, false);
 		if (verifyResult == 1)
 		{
 			return true;
@@ -312,12 +286,19 @@ bool AggSig::VerifyAggregateSignature(const Signature& signature, const PublicKe
 }
 
 std::vector<secp256k1_ecdsa_signature> AggSig::ParseCompactSignatures(const std::vector<CompactSignature>& signatures) const
+{
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
+
+	return ParseCompactSignatures(pContext->Get(), signatures);
+}
+
+std::vector<secp256k1_ecdsa_signature> AggSig::ParseCompactSignatures(const secp256k1_context* pContext, const std::vector<CompactSignature>& signatures) const
 {
 	std::vector<secp256k1_ecdsa_signature> parsed;
 	for (const Signature partialSignature : signatures)
 	{
 		secp256k1_ecdsa_signature signature;
-		const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(m_pContext, &signature, partialSignature.GetSignatureBytes().data());
+		const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(pContext, &signature, partialSignature.GetSignatureBytes().data());
 		if (parseSignatureResult == 1)
 		{
 			parsed.emplace_back(std::move(signature));
@@ -333,10 +314,12 @@ std::vector<secp256k1_ecdsa_signature> AggSig::ParseCompactSignatures(const std:
 
 CompactSignature AggSig::ToCompact(const Signature& signature) const
 {
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
+
 	CompactSignature compactSignature;
 	secp256k1_ecdsa_signature ecdsa_sig;
 	memcpy(ecdsa_sig.data, signature.data(), 64);
-	const int result = secp256k1_ecdsa_signature_serialize_compact(m_pContext, compactSignature.data(), &ecdsa_sig);
+	const int result = secp256k1_ecdsa_signature_serialize_compact(pContext->Get(), compactSignature.data(), &ecdsa_sig);
 	if (result != 1) {
 		throw CryptoException("Failed to serialize to compact");
 	}
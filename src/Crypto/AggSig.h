@@ -9,7 +9,6 @@
 #include <Crypto/Hash.h>
 #include <vector>
 #include <memory>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
@@ -18,8 +17,6 @@ class AggSig
 {
 public:
 	static AggSig& GetInstance();
-	AggSig();
-	~AggSig();
 
 	SecretKey GenerateSecureNonce() const;
 
@@ -36,6 +33,6 @@ public:
 	CompactSignature ToCompact(const Signature& signature) const;
 
 private:
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
+	// Parses with a context that the caller already has checked out, so it doesn't need a second one.
+	std::vector<secp256k1_ecdsa_signature> ParseCompactSignatures(const secp256k1_context* pContext, const std::vector<CompactSignature>& signatures) const;
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include <Crypto/Blake2bHasher.h>
+#include <Crypto/CryptoException.h>
+
+#include <sodium/crypto_generichash_blake2b.h>
+
+static_assert(sizeof(crypto_generichash_blake2b_state) <= 384, "Blake2bHasher::m_state is too small");
+static_assert(alignof(crypto_generichash_blake2b_state) <= 64, "Blake2bHasher::m_state is not aligned");
+
+Blake2bHasher::Blake2bHasher(const EProtocolVersion protocolVersion)
+	: Serializer(protocolVersion)
+{
+	int result = crypto_generichash_blake2b_init((crypto_generichash_blake2b_state*)m_state, nullptr, 0, HASH_SIZE);
+	if (result != 0) {
+		throw CRYPTO_EXCEPTION_F("crypto_generichash_blake2b_init failed with error {}", result);
+	}
+}
+
+Hash Blake2bHasher::Finalize()
+{
+	Hash output;
+
+	int result = crypto_generichash_blake2b_final((crypto_generichash_blake2b_state*)m_state, output.data(), output.size());
+	if (result != 0) {
+		throw CRYPTO_EXCEPTION_F("crypto_generichash_blake2b_final failed with error {}", result);
+	}
+
+	return output;
+}
+
+void Blake2bHasher::Write(const uint8_t* data, const size_t len)
+{
+	crypto_generichash_blake2b_update((crypto_generichash_blake2b_state*)m_state, data, len);
+}
@@ -7,18 +7,11 @@
 #include <Crypto/BlindingFactor.h>
 #include <Crypto/ProofMessage.h>
 #include <Crypto/RewoundProof.h>
-#include <shared_mutex>
-
-// Forward Declarations
-typedef struct secp256k1_context_struct secp256k1_context;
-struct secp256k1_bulletproof_generators;
 
 class Bulletproofs
 {
 public:
 	static Bulletproofs& GetInstance();
-	Bulletproofs();
-	~Bulletproofs();
 
 	bool VerifyBulletproofs(const std::vector<std::pair<Commitment, RangeProof>>& rangeProofs) const;
 
@@ -37,8 +30,5 @@ public:
 	) const;
 
 private:
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
-	secp256k1_bulletproof_generators* m_pGenerators;
 	mutable BulletProofsCache m_cache;
 };
\ No newline at end of file
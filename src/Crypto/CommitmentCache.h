@@ -0,0 +1,70 @@
+#pragma once
+
+#include <caches/Cache.h>
+#include <Crypto/Commitment.h>
+#include <secp256k1-zkp/secp256k1_commitment.h>
+#include <mutex>
+#include <vector>
+
+//
+// Remembers the parsed secp256k1 points of recently used commitments, so a commitment that's checked in the txpool,
+// and then again in a block, its kernel sums and its signatures, only has its point decompressed once.
+//
+class CommitmentCache
+{
+public:
+	static const size_t MAX_SIZE = 32768;
+
+	static CommitmentCache& GetInstance()
+	{
+		static CommitmentCache instance(MAX_SIZE);
+		return instance;
+	}
+
+	CommitmentCache(const size_t maxSize)
+		: m_maxSize(maxSize), m_cache(maxSize)
+	{
+
+	}
+
+	size_t GetMaxSize() const noexcept { return m_maxSize; }
+
+	//
+	// Copies the cached point of each commitment into parsed, and returns the indices of the ones that weren't cached.
+	//
+	std::vector<size_t> Get(const std::vector<const Commitment*>& commitments, secp256k1_pedersen_commitment* parsed) const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		std::vector<size_t> missing;
+		for (size_t i = 0; i < commitments.size(); i++)
+		{
+			if (m_cache.Cached(*commitments[i]))
+			{
+				parsed[i] = m_cache.Get(*commitments[i]);
+			}
+			else
+			{
+				missing.push_back(i);
+			}
+		}
+
+		return missing;
+	}
+
+	void Put(const std::vector<const Commitment*>& commitments, const secp256k1_pedersen_commitment* parsed, const std::vector<size_t>& indices)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		for (const size_t index : indices)
+		{
+			m_cache.Put(*commitments[index], parsed[index]);
+		}
+	}
+
+private:
+	const size_t m_maxSize;
+
+	mutable std::mutex m_mutex;
+	mutable LRUCache<Commitment, secp256k1_pedersen_commitment> m_cache;
+};
@@ -5,24 +5,43 @@
 #include <Crypto/CSPRNG.h>
 #include <Crypto/SecretKey.h>
 #include <Crypto/CryptoException.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace secp256k1 {
 
+static const size_t MAX_GENERATORS = 256;
+static const size_t MAX_WIDTH = 1 << 20;
+static const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
+
+//
+// A secp256k1 context together with its bulletproof generators and a scratch space.
+// The scratch space only reserves its limit up front; frames are allocated as a multi-exponentiation needs them.
+//
+// A Context is not thread-safe. Randomizing it, or using its scratch space, requires exclusive access,
+// so it should only ever be used through a ContextPool::Handle.
+//
 class Context
 {
 public:
     Context()
     {
         m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-        m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, 256);
+        m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, MAX_GENERATORS);
+        m_pScratchSpace = secp256k1_scratch_space_create(m_pContext, SCRATCH_SPACE_SIZE);
     }
 
     ~Context()
     {
+        secp256k1_scratch_space_destroy(m_pScratchSpace);
         secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
         secp256k1_context_destroy(m_pContext);
     }
 
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
     secp256k1_context* Randomized()
     {
         const SecretKey randomSeed = CSPRNG::GenerateRandom32();
@@ -38,10 +57,78 @@ public:
     const secp256k1_context* Get() const noexcept { return m_pContext; }
 
     const secp256k1_bulletproof_generators* GetGenerators() const noexcept { return m_pGenerators; }
+    secp256k1_scratch_space* GetScratchSpace() noexcept { return m_pScratchSpace; }
 
 private:
     secp256k1_context* m_pContext;
     secp256k1_bulletproof_generators* m_pGenerators;
+    secp256k1_scratch_space* m_pScratchSpace;
+};
+
+//
+// Hands out Contexts for exclusive use, so signing and proving threads never block verifying threads.
+//
+// Contexts are created on demand and returned to the pool when their Handle is destroyed,
+// so the pool grows to the number of threads using it concurrently, and no further.
+// The mutex only guards checkout and return; it is never held while a context is in use.
+//
+class ContextPool
+{
+public:
+    class Handle
+    {
+    public:
+        Handle(ContextPool& pool, std::unique_ptr<Context>&& pContext)
+            : m_pool(pool), m_pContext(std::move(pContext)) { }
+        Handle(Handle&& other) noexcept = default;
+        ~Handle()
+        {
+            if (m_pContext != nullptr) {
+                m_pool.Return(std::move(m_pContext));
+            }
+        }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        Handle& operator=(Handle&&) = delete;
+
+        Context* operator->() noexcept { return m_pContext.get(); }
+        Context& operator*() noexcept { return *m_pContext; }
+
+    private:
+        ContextPool& m_pool;
+        std::unique_ptr<Context> m_pContext;
+    };
+
+    static ContextPool& GetInstance()
+    {
+        static ContextPool pool;
+        return pool;
+    }
+
+    Handle Checkout()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_idle.empty()) {
+                std::unique_ptr<Context> pContext = std::move(m_idle.back());
+                m_idle.pop_back();
+                return Handle(*this, std::move(pContext));
+            }
+        }
+
+        return Handle(*this, std::make_unique<Context>());
+    }
+
+private:
+    void Return(std::unique_ptr<Context>&& pContext)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.push_back(std::move(pContext));
+    }
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Context>> m_idle;
 };
 
-}
\ No newline at end of file
+}
@@ -1,5 +1,4 @@
 #include <Crypto/Crypto.h>
-#include <Core/Traits/Lockable.h>
 #include <cassert>
 
 #include "Context.h"
@@ -14,8 +13,6 @@
 #pragma comment(lib, "crypt32")
 #endif
 
-Locked<secp256k1::Context> SECP256K1_CONTEXT(std::make_shared<secp256k1::Context>());
-
 Commitment Crypto::CommitTransparent(const uint64_t value)
 {
 	const BlindingFactor blindingFactor(CBigInteger<32>::ValueOf(0));
@@ -29,26 +26,35 @@ Commitment Crypto::CommitBlinded(const uint64_t value, const BlindingFactor& bli
 }
 
 Commitment Crypto::AddCommitments(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative)
+{
+	return AddCommitments(positive, negative, 0, BlindingFactor(ZERO_HASH));
+}
+
+Commitment Crypto::AddCommitments(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative, const int64_t value, const BlindingFactor& blindingFactor)
 {
 	const Commitment zeroCommitment(CBigInteger<33>::ValueOf(0));
 
-	std::vector<Commitment> sanitizedPositive;
-	std::copy_if(
-		positive.cbegin(),
-		positive.cend(),
-		std::back_inserter(sanitizedPositive),
-		[&zeroCommitment](const Commitment& positiveCommitment) { return positiveCommitment != zeroCommitment; }
-	);
+	std::vector<const Commitment*> sanitizedPositive;
+	sanitizedPositive.reserve(positive.size());
+	for (const Commitment& positiveCommitment : positive)
+	{
+		if (positiveCommitment != zeroCommitment)
+		{
+			sanitizedPositive.push_back(&positiveCommitment);
+		}
+	}
 
-	std::vector<Commitment> sanitizedNegative;
-	std::copy_if(
-		negative.cbegin(),
-		negative.cend(),
-		std::back_inserter(sanitizedNegative),
-		[&zeroCommitment](const Commitment& negativeCommitment) { return negativeCommitment != zeroCommitment; }
-	);
+	std::vector<const Commitment*> sanitizedNegative;
+	sanitizedNegative.reserve(negative.size());
+	for (const Commitment& negativeCommitment : negative)
+	{
+		if (negativeCommitment != zeroCommitment)
+		{
+			sanitizedNegative.push_back(&negativeCommitment);
+		}
+	}
 
-	return Pedersen::GetInstance().PedersenCommitSum(sanitizedPositive, sanitizedNegative);
+	return Pedersen::GetInstance().PedersenCommitSum(sanitizedPositive, sanitizedNegative, value, blindingFactor);
 }
 
 BlindingFactor Crypto::AddBlindingFactors(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative)
@@ -86,9 +92,11 @@ SecretKey Crypto::BlindSwitch(const SecretKey& secretKey, const uint64_t amount)
 
 SecretKey Crypto::AddPrivateKeys(const SecretKey& secretKey1, const SecretKey& secretKey2)
 {
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
+
 	SecretKey result(secretKey1.GetVec());
 
-	const int tweak_result = secp256k1_ec_privkey_tweak_add(SECP256K1_CONTEXT.Read()->Get(), result.data(), secretKey2.data());
+	const int tweak_result = secp256k1_ec_privkey_tweak_add(pContext->Get(), result.data(), secretKey2.data());
 	if (tweak_result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_privkey_tweak_add failed with error {}", tweak_result);
 	}
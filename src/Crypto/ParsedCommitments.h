@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CommitmentCache.h"
+
+#include <secp256k1-zkp/secp256k1_commitment.h>
+#include <Crypto/Commitment.h>
+#include <Crypto/CryptoException.h>
+#include <Common/Logger.h>
+#include <vector>
+
+//
+// Parses a batch of commitments into one contiguous buffer, along with the array of pointers that secp256k1 takes,
+// so converting a batch costs a couple of allocations instead of one per commitment.
+//
+// Points are looked up in the CommitmentCache first, and the ones that had to be parsed are added to it.
+// Batches too big to fit in the cache (eg. the whole UTXO set) bypass it, as do callers that pass cache = false
+// for commitments that won't be seen again, like the outputs scanned during a wallet restore.
+//
+class ParsedCommitments
+{
+public:
+	ParsedCommitments(const secp256k1_context* pContext, const std::vector<const Commitment*>& commitments, const bool cache = true)
+	{
+		Parse(pContext, commitments, cache);
+	}
+
+	ParsedCommitments(const ParsedCommitments&) = delete;
+	ParsedCommitments& operator=(const ParsedCommitments&) = delete;
+
+	//
+	// Adds an already parsed point, eg. one created by secp256k1_pedersen_commit.
+	//
+	void Append(const secp256k1_pedersen_commitment& point)
+	{
+		const secp256k1_pedersen_commitment* pBefore = m_parsed.data();
+		m_parsed.push_back(point);
+
+		if (m_parsed.data() == pBefore)
+		{
+			m_pointers.push_back(&m_parsed.back());
+		}
+		else
+		{
+			BuildPointers();
+		}
+	}
+
+	bool empty() const noexcept { return m_parsed.empty(); }
+	size_t size() const noexcept { return m_parsed.size(); }
+
+	const secp256k1_pedersen_commitment* const* data() const noexcept { return m_pointers.empty() ? nullptr : m_pointers.data(); }
+	const secp256k1_pedersen_commitment* operator[](const size_t index) const noexcept { return m_pointers[index]; }
+
+private:
+	void Parse(const secp256k1_context* pContext, const std::vector<const Commitment*>& commitments, const bool cache)
+	{
+		m_parsed.resize(commitments.size());
+
+		auto parse = [this, pContext, &commitments](const size_t index)
+		{
+			const int parsed_result = secp256k1_pedersen_commitment_parse(pContext, &m_parsed[index], commitments[index]->data());
+			if (parsed_result != 1) {
+				LOG_ERROR_F("secp256k1_pedersen_commitment_parse failed with error {} for commitment {}", parsed_result, *commitments[index]);
+				throw CRYPTO_EXCEPTION_F("secp256k1_pedersen_commitment_parse failed with error: {}", parsed_result);
+			}
+		};
+
+		CommitmentCache& commitmentCache = CommitmentCache::GetInstance();
+		if (cache && !commitments.empty() && commitments.size() <= commitmentCache.GetMaxSize() / 2)
+		{
+			const std::vector<size_t> missing = commitmentCache.Get(commitments, m_parsed.data());
+			for (const size_t index : missing)
+			{
+				parse(index);
+			}
+
+			if (!missing.empty())
+			{
+				commitmentCache.Put(commitments, m_parsed.data(), missing);
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < commitments.size(); i++)
+			{
+				parse(i);
+			}
+		}
+
+		BuildPointers();
+	}
+
+	void BuildPointers()
+	{
+		m_pointers.clear();
+		m_pointers.reserve(m_parsed.size());
+		for (const secp256k1_pedersen_commitment& parsed : m_parsed)
+		{
+			m_pointers.push_back(&parsed);
+		}
+	}
+
+	std::vector<secp256k1_pedersen_commitment> m_parsed;
+	std::vector<const secp256k1_pedersen_commitment*> m_pointers;
+};
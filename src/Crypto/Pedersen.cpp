@@ -1,4 +1,6 @@
 #include "Pedersen.h"
+#include "Context.h"
+#include "ParsedCommitments.h"
 #include "SwitchGeneratorPoint.h"
 
 #include <secp256k1-zkp/secp256k1_commitment.h>
@@ -13,26 +15,16 @@ Pedersen& Pedersen::GetInstance()
 	return instance;
 }
 
-Pedersen::Pedersen()
-{
-	m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-}
-
-Pedersen::~Pedersen()
-{
-	secp256k1_context_destroy(m_pContext);
-}
-
 Commitment Pedersen::PedersenCommit(const uint64_t value, const BlindingFactor& blindingFactor) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	secp256k1_pedersen_commitment commitment;
-	const int result = secp256k1_pedersen_commit(m_pContext, &commitment, &blindingFactor.GetBytes()[0], value, &secp256k1_generator_const_h, &secp256k1_generator_const_g);
+	const int result = secp256k1_pedersen_commit(pContext->Get(), &commitment, &blindingFactor.GetBytes()[0], value, &secp256k1_generator_const_h, &secp256k1_generator_const_g);
 	if (result == 1)
 	{
 		Commitment commitment_out;
-		secp256k1_pedersen_commitment_serialize(m_pContext, commitment_out.data(), &commitment);
+		secp256k1_pedersen_commitment_serialize(pContext->Get(), commitment_out.data(), &commitment);
 
 		return commitment_out;
 	}
@@ -41,26 +33,47 @@ Commitment Pedersen::PedersenCommit(const uint64_t value, const BlindingFactor&
 	throw CryptoException("Failed to create commitment.");
 }
 
-Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative) const
+Commitment Pedersen::PedersenCommitSum(const std::vector<const Commitment*>& positive, const std::vector<const Commitment*>& negative, const int64_t value, const BlindingFactor& blindingFactor) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
+
+	ParsedCommitments positiveCommitments(pContext->Get(), positive);
+	ParsedCommitments negativeCommitments(pContext->Get(), negative);
 
-	std::vector<secp256k1_pedersen_commitment*> positiveCommitments = Pedersen::ConvertCommitments(*m_pContext, positive);
-	std::vector<secp256k1_pedersen_commitment*> negativeCommitments = Pedersen::ConvertCommitments(*m_pContext, negative);
+	const bool zeroBlind = blindingFactor == BlindingFactor(ZERO_HASH);
+	if (value != 0 || !zeroBlind)
+	{
+		// v*H + b*G is subtracted as |v|*H - b*G when v is negative.
+		CBigInteger<32> blind = blindingFactor.GetBytes();
+		if (value < 0 && !zeroBlind)
+		{
+			const unsigned char* pBlind = blindingFactor.data();
+			const int negateResult = secp256k1_pedersen_blind_sum(pContext->Get(), blind.data(), &pBlind, 1, 0);
+			if (negateResult != 1) {
+				throw CRYPTO_EXCEPTION_F("secp256k1_pedersen_blind_sum failed with error: {}", negateResult);
+			}
+		}
+
+		const uint64_t magnitude = value < 0 ? (0 - (uint64_t)value) : (uint64_t)value;
+		secp256k1_pedersen_commitment extra;
+		const int commitResult = secp256k1_pedersen_commit(pContext->Get(), &extra, blind.data(), magnitude, &secp256k1_generator_const_h, &secp256k1_generator_const_g);
+		if (commitResult != 1) {
+			throw CRYPTO_EXCEPTION_F("secp256k1_pedersen_commit failed with error: {}", commitResult);
+		}
+
+		(value < 0 ? negativeCommitments : positiveCommitments).Append(extra);
+	}
 
 	secp256k1_pedersen_commitment commitment;
 	const int result = secp256k1_pedersen_commit_sum(
-		m_pContext,
+		pContext->Get(),
 		&commitment,
-		positiveCommitments.empty() ? nullptr : &positiveCommitments[0],
+		positiveCommitments.data(),
 		positiveCommitments.size(),
-		negativeCommitments.empty() ? nullptr : &negativeCommitments[0],
+		negativeCommitments.data(),
 		negativeCommitments.size()
 	);
 
-	Pedersen::CleanupCommitments(positiveCommitments);
-	Pedersen::CleanupCommitments(negativeCommitments);
-
 	if (result != 1)
 	{
 		LOG_ERROR_F("secp256k1_pedersen_commit_sum returned result: {}", result);
@@ -69,7 +82,7 @@ Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive,
 
 
 	std::vector<unsigned char> serializedCommitment(33);
-	const int serializeResult = secp256k1_pedersen_commitment_serialize(m_pContext, &serializedCommitment[0], &commitment);
+	const int serializeResult = secp256k1_pedersen_commitment_serialize(pContext->Get(), &serializedCommitment[0], &commitment);
 	if (serializeResult != 1)
 	{
 		LOG_ERROR_F("secp256k1_pedersen_commitment_serialize returned result: {}", serializeResult);
@@ -81,7 +94,7 @@ Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive,
 
 BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	std::vector<const unsigned char*> blindingFactors;
 	for (const BlindingFactor& positiveFactor : positive)
@@ -96,7 +109,7 @@ BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& pos
 
 	CBigInteger<32> blindingFactorBytes;
 	const int result = secp256k1_pedersen_blind_sum(
-		m_pContext,
+		pContext->Get(),
 		blindingFactorBytes.data(),
 		blindingFactors.data(),
 		blindingFactors.size(),
@@ -114,11 +127,11 @@ BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& pos
 
 SecretKey Pedersen::BlindSwitch(const SecretKey& blindingFactor, const uint64_t amount) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	std::vector<unsigned char> blindSwitch(32);
 	const int result = secp256k1_blind_switch(
-		m_pContext,
+		pContext->Get(),
 		blindSwitch.data(),
 		blindingFactor.data(),
 		amount,
@@ -136,55 +149,26 @@ SecretKey Pedersen::BlindSwitch(const SecretKey& blindingFactor, const uint64_t
 
 Commitment Pedersen::ToCommitment(const PublicKey& publicKey) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	secp256k1_pubkey secp_pubkey;
-	const int pubKeyParsed = secp256k1_ec_pubkey_parse(m_pContext, &secp_pubkey, publicKey.data(), publicKey.size());
+	const int pubKeyParsed = secp256k1_ec_pubkey_parse(pContext->Get(), &secp_pubkey, publicKey.data(), publicKey.size());
 	if (pubKeyParsed != 1) {
 		throw CryptoException("secp256k1_ec_pubkey_parse failed");
 	}
 
 	secp256k1_pedersen_commitment secp_commitment;
-	const int converted = secp256k1_pubkey_to_pedersen_commitment(m_pContext, &secp_commitment, &secp_pubkey);
+	const int converted = secp256k1_pubkey_to_pedersen_commitment(pContext->Get(), &secp_commitment, &secp_pubkey);
 	if (converted != 1) {
 		throw CryptoException("secp256k1_pubkey_to_pedersen_commitment failed");
 	}
 
 	Commitment commitment;
-	const int serialized = secp256k1_pedersen_commitment_serialize(m_pContext, commitment.data(), &secp_commitment);
+	const int serialized = secp256k1_pedersen_commitment_serialize(pContext->Get(), commitment.data(), &secp_commitment);
 	if (serialized != 1) {
 		throw CryptoException("secp256k1_pedersen_commitment_serialize failed");
 	}
 
 	return commitment;
 
-}
-
-std::vector<secp256k1_pedersen_commitment*> Pedersen::ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments)
-{
-	std::vector<secp256k1_pedersen_commitment*> convertedCommitments(commitments.size(), NULL);
-	for (int i = 0; i < commitments.size(); i++)
-	{
-		secp256k1_pedersen_commitment* pCommitment = new secp256k1_pedersen_commitment();
-		const int parsed_result = secp256k1_pedersen_commitment_parse(&context, pCommitment, commitments[i].data());
-		convertedCommitments[i] = pCommitment;
-
-		if (parsed_result != 1) {
-			CleanupCommitments(convertedCommitments);
-			LOG_ERROR_F("secp256k1_pedersen_commitment_parse failed with error {} for commitment {}", parsed_result, commitments[i]);
-			throw CRYPTO_EXCEPTION_F("secp256k1_pedersen_commitment_parse failed with error: {}", parsed_result);
-		}
-	}
-
-	return convertedCommitments;
-}
-
-void Pedersen::CleanupCommitments(std::vector<secp256k1_pedersen_commitment*>& commitments)
-{
-	for (secp256k1_pedersen_commitment* pCommitment : commitments)
-	{
-		delete pCommitment;
-	}
-
-	commitments.clear();
 }
\ No newline at end of file
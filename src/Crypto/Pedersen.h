@@ -6,7 +6,6 @@
 #include <Crypto/SecretKey.h>
 #include <Crypto/Commitment.h>
 #include <Crypto/PublicKey.h>
-#include <shared_mutex>
 
 // Forward Declarations
 typedef struct secp256k1_context_struct secp256k1_context;
@@ -15,21 +14,24 @@ class Pedersen
 {
 public:
 	static Pedersen& GetInstance();
-	Pedersen();
-	~Pedersen();
 
 	Commitment PedersenCommit(const uint64_t value, const BlindingFactor& blindingFactor) const;
-	Commitment PedersenCommitSum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative) const;
+
+	//
+	// Sums the commitments, plus a commitment to value and blindingFactor, which is built as a parsed point and never serialized.
+	// A negative value is committed to with the negated blinding factor, and subtracted.
+	// The commitments are taken by pointer, so callers can filter them without copying.
+	//
+	Commitment PedersenCommitSum(
+		const std::vector<const Commitment*>& positive,
+		const std::vector<const Commitment*>& negative,
+		const int64_t value,
+		const BlindingFactor& blindingFactor
+	) const;
+
 	BlindingFactor PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const;
 
 	SecretKey BlindSwitch(const SecretKey& secretKey, const uint64_t amount) const;
 
 	Commitment ToCommitment(const PublicKey& publicKey) const;
-
-	static std::vector<secp256k1_pedersen_commitment*> ConvertCommitments(const secp256k1_context& context, const std::vector<Commitment>& commitments);
-	static void CleanupCommitments(std::vector<secp256k1_pedersen_commitment*>& commitments);
-
-private:
-	mutable std::shared_mutex m_mutex;
-	secp256k1_context* m_pContext;
 };
\ No newline at end of file
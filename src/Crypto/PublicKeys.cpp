@@ -1,4 +1,5 @@
 #include "PublicKeys.h"
+#include "Context.h"
 
 #include <Crypto/CryptoException.h>
 
@@ -11,22 +12,22 @@ PublicKeys& PublicKeys::GetInstance()
 
 PublicKey PublicKeys::CalculatePublicKey(const SecretKey& privateKey) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
-	const int verify_result = secp256k1_ec_seckey_verify(m_pContext, privateKey.data());
+	const int verify_result = secp256k1_ec_seckey_verify(pContext->Get(), privateKey.data());
 	if (verify_result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_seckey_verify failed with error {}", verify_result);
 	}
 
 	secp256k1_pubkey pubkey;
-	const int create_result = secp256k1_ec_pubkey_create(m_pContext, &pubkey, privateKey.data());
+	const int create_result = secp256k1_ec_pubkey_create(pContext->Get(), &pubkey, privateKey.data());
 	if (create_result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_pubkey_create failed with error {}", create_result);
 	}
 
 	PublicKey serialized_pubkey;
 	size_t pubkey_len = serialized_pubkey.size();
-	const int serialize_result = secp256k1_ec_pubkey_serialize(m_pContext, serialized_pubkey.data(), &pubkey_len, &pubkey, SECP256K1_EC_COMPRESSED);
+	const int serialize_result = secp256k1_ec_pubkey_serialize(pContext->Get(), serialized_pubkey.data(), &pubkey_len, &pubkey, SECP256K1_EC_COMPRESSED);
 	if (serialize_result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_pubkey_serialize failed with error {}", serialize_result);
 	}
@@ -36,13 +37,13 @@ PublicKey PublicKeys::CalculatePublicKey(const SecretKey& privateKey) const
 
 PublicKey PublicKeys::PublicKeySum(const std::vector<PublicKey>& publicKeys) const
 {
-	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+	secp256k1::ContextPool::Handle pContext = secp256k1::ContextPool::GetInstance().Checkout();
 
 	std::vector<secp256k1_pubkey> parsed_pubkeys;
 	for (const PublicKey& publicKey : publicKeys)
 	{
 		secp256k1_pubkey parsed_pubkey;
-		int parse_result = secp256k1_ec_pubkey_parse(m_pContext, &parsed_pubkey, publicKey.data(), publicKey.size());
+		int parse_result = secp256k1_ec_pubkey_parse(pContext->Get(), &parsed_pubkey, publicKey.data(), publicKey.size());
 		if (parse_result != 1) {
 			throw CRYPTO_EXCEPTION_F("secp256k1_ec_pubkey_parse failed with error {}", parse_result);
 		}
@@ -59,7 +60,7 @@ PublicKey PublicKeys::PublicKeySum(const std::vector<PublicKey>& publicKeys) con
 
 	secp256k1_pubkey publicKey;
 	const int combined_result = secp256k1_ec_pubkey_combine(
-		m_pContext,
+		pContext->Get(),
 		&publicKey,
 		parsed_pubkey_ptrs.data(),
 		parsed_pubkey_ptrs.size()
@@ -70,7 +71,7 @@ PublicKey PublicKeys::PublicKeySum(const std::vector<PublicKey>& publicKeys) con
 
 	PublicKey serialized_pubkey;
 	size_t pubkey_len = serialized_pubkey.size();
-	const int serialize_result = secp256k1_ec_pubkey_serialize(m_pContext, serialized_pubkey.data(), &pubkey_len, &publicKey, SECP256K1_EC_COMPRESSED);
+	const int serialize_result = secp256k1_ec_pubkey_serialize(pContext->Get(), serialized_pubkey.data(), &pubkey_len, &publicKey, SECP256K1_EC_COMPRESSED);
 	if (serialize_result != 1) {
 		throw CRYPTO_EXCEPTION_F("secp256k1_ec_pubkey_serialize failed with error {}", serialize_result);
 	}
@@ -42,11 +42,19 @@ void BlockDB::Commit()
 	}
 
 	m_uncommitted.clear();
+
+	for (const auto& blockSums : m_uncommittedSums)
+	{
+		m_blockSumsCache.Put(blockSums.first, blockSums.second);
+	}
+
+	m_uncommittedSums.clear();
 }
 
 void BlockDB::Rollback() noexcept
 {
 	m_uncommitted.clear();
+	m_uncommittedSums.clear();
 	m_pRocksDB->Rollback();
 }
 
@@ -131,11 +139,25 @@ void BlockDB::AddBlockSums(const Hash& blockHash, const BlockSums& blockSums)
 	LOG_TRACE_F("Adding BlockSums for block {}", blockHash);
 
 	rocksdb::Slice key((const char*)blockHash.data(), blockHash.size());
-	 m_pRocksDB->Put("BLOCK_SUMS", DBEntry<BlockSums>(key, blockSums));
+	m_pRocksDB->Put("BLOCK_SUMS", DBEntry<BlockSums>(key, blockSums));
+
+	if (m_pRocksDB->IsTransactional())
+	{
+		m_uncommittedSums.push_back({ blockHash, blockSums });
+	}
+	else
+	{
+		m_blockSumsCache.Put(blockHash, blockSums);
+	}
 }
 
 std::unique_ptr<BlockSums> BlockDB::GetBlockSums(const Hash& blockHash) const
 {
+	if (m_blockSumsCache.Cached(blockHash))
+	{
+		return std::make_unique<BlockSums>(m_blockSumsCache.Get(blockHash));
+	}
+
 	rocksdb::Slice key((const char*)blockHash.data(), blockHash.size());
 	return m_pRocksDB->Get<BlockSums>("BLOCK_SUMS", key);
 }
@@ -145,6 +167,8 @@ void BlockDB::ClearBlockSums()
 	LOG_WARNING("Deleting all block sums.");
 
 	m_pRocksDB->DeleteAll("BLOCK_SUMS");
+	m_blockSumsCache.Clear();
+	m_uncommittedSums.clear();
 }
 
 void BlockDB::AddOutputPosition(const Commitment& outputCommitment, const OutputLocation& location)
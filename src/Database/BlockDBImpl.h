@@ -2,6 +2,7 @@
 
 #include <Database/BlockDb.h>
 #include <Config/Config.h>
+#include <Core/Models/BlockSums.h>
 #include <caches/Cache.h>
 #include <mutex>
 #include <set>
@@ -13,7 +14,7 @@ class BlockDB : public IBlockDB
 {
 public:
 	BlockDB(const Config& config, const std::shared_ptr<RocksDB>& pRocksDB)
-		: m_config(config), m_pRocksDB(pRocksDB), m_blockHeadersCache(128) { }
+		: m_config(config), m_pRocksDB(pRocksDB), m_blockHeadersCache(128), m_blockSumsCache(128) { }
 	virtual ~BlockDB() = default;
 
 	static std::shared_ptr<BlockDB> OpenDB(const Config& config);
@@ -49,6 +50,8 @@ private:
 	const Config& m_config;
 	std::shared_ptr<RocksDB> m_pRocksDB;
 	FIFOCache<Hash, BlockHeaderPtr> m_blockHeadersCache;
+	FIFOCache<Hash, BlockSums> m_blockSumsCache;
 
 	std::vector<BlockHeaderPtr> m_uncommitted;
+	std::vector<std::pair<Hash, BlockSums>> m_uncommittedSums;
 };
\ No newline at end of file
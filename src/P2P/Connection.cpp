@@ -86,7 +86,10 @@ bool Connection::IsConnectionActive() const
 
 void Connection::AddToSendQueue(const IMessage& message)
 {
-	m_sendQueue.push_back(message.Clone());
+	if (!m_sendQueue.try_push(message.Clone()))
+	{
+		LOG_WARNING_F("Send queue full. Dropping message for {}.", GetIPAddress());
+	}
 }
 
 bool Connection::ExceedsRateLimit() const
@@ -188,10 +191,8 @@ void Connection::Run()
 			}
 
 			// Send the next message in the queue, if one exists.
-			auto pMessageToSend = m_sendQueue.copy_front();
-			if (pMessageToSend != nullptr) {
-				IMessagePtr pMessage = *pMessageToSend;
-				m_sendQueue.pop_front(1);
+			IMessagePtr pMessage;
+			if (m_sendQueue.try_pop(pMessage)) {
 				SendMsg(*pMessage);
 				messageSentOrReceived = true;
 			}
@@ -3,7 +3,7 @@
 #include "Messages/Message.h"
 
 #include <Core/Enums/ProtocolVersion.h>
-#include <Common/ConcurrentQueue.h>
+#include <Common/MPMCQueue.h>
 #include <Net/Socket.h>
 #include <P2P/ConnectedPeer.h>
 #include <P2P/SyncStatus.h>
@@ -42,7 +42,8 @@ public:
 		m_connectedPeer(connectedPeer),
 		m_pSyncStatus(pSyncStatus),
 		m_pMessageProcessor(pMessageProcessor),
-		m_terminate(false) { }
+		m_terminate(false),
+		m_sendQueue(MAX_SEND_QUEUE_SIZE) { }
 
 	Connection(const Connection&) = delete;
 	Connection& operator=(const Connection&) = delete;
@@ -112,7 +113,9 @@ private:
 	std::shared_ptr<asio::io_context> m_pContext;
 	mutable SocketPtr m_pSocket;
 
-	ConcurrentQueue<IMessagePtr> m_sendQueue;
+	// The max number of messages waiting to be sent. Any more than that are dropped, since the peer isn't keeping up.
+	static constexpr size_t MAX_SEND_QUEUE_SIZE = 4096;
+	MPMCQueue<IMessagePtr> m_sendQueue;
 };
 
 typedef std::shared_ptr<Connection> ConnectionPtr;
\ No newline at end of file
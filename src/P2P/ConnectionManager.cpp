@@ -17,6 +17,7 @@
 
 ConnectionManager::ConnectionManager()
 	: m_connections(std::make_shared<std::vector<ConnectionPtr>>()),
+	m_sendQueue(MAX_BROADCAST_QUEUE_SIZE),
 	m_numOutbound(0),
 	m_numInbound(0)
 {
@@ -188,7 +189,10 @@ bool ConnectionManager::SendMessageToPeer(const IMessage& message, PeerConstPtr
 
 void ConnectionManager::BroadcastMessage(const IMessage& message, const uint64_t sourceId)
 {
-	m_sendQueue.push_back(MessageToBroadcast(sourceId, message.Clone()));
+	if (!m_sendQueue.try_push(MessageToBroadcast(sourceId, message.Clone())))
+	{
+		LOG_WARNING_F("Broadcast queue full. Dropping {} message.", MessageTypes::ToString(message.GetMessageType()));
+	}
 }
 
 void ConnectionManager::AddConnection(ConnectionPtr pConnection)
@@ -299,25 +303,21 @@ void ConnectionManager::Thread_Broadcast(ConnectionManager& connectionManager)
 {
 	while (!ShutdownManagerAPI::WasShutdownRequested()) 
 	{
-		std::unique_ptr<MessageToBroadcast> pBroadcastMessage = connectionManager.m_sendQueue.copy_front();
-		if (pBroadcastMessage != nullptr)
+		std::vector<MessageToBroadcast> messages;
+		connectionManager.m_sendQueue.wait_pop_batch(messages, 32, std::chrono::milliseconds(100));
+		for (const MessageToBroadcast& broadcastMessage : messages)
 		{
-			connectionManager.m_sendQueue.pop_front(1);
-			LOG_DEBUG_F("Broadcasting message: {}", MessageTypes::ToString(pBroadcastMessage->m_pMessage->GetMessageType()));
+			LOG_DEBUG_F("Broadcasting message: {}", MessageTypes::ToString(broadcastMessage.m_pMessage->GetMessageType()));
 
 			// TODO: This should only broadcast to 8(?) peers. Should maybe be configurable.
 			auto pConnections = connectionManager.m_connections.Read();
 			for (ConnectionPtr pConnection : *pConnections)
 			{
-				if (pConnection->GetId() != pBroadcastMessage->m_sourceId)
+				if (pConnection->GetId() != broadcastMessage.m_sourceId)
 				{
-					pConnection->AddToSendQueue(*pBroadcastMessage->m_pMessage);
+					pConnection->AddToSendQueue(*broadcastMessage.m_pMessage);
 				}
 			}
 		}
-		else
-		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(100), ShutdownManagerAPI::WasShutdownRequested());
-		}
 	}
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include "Connection.h"
 
-#include <Common/ConcurrentQueue.h>
+#include <Common/MPMCQueue.h>
 #include <Core/Traits/Lockable.h>
 #include <memory>
 #include <vector>
@@ -57,7 +57,9 @@ private:
 		std::shared_ptr<IMessage> m_pMessage;
 	};
 
-	ConcurrentQueue<MessageToBroadcast> m_sendQueue;
+	// The max number of messages waiting to be broadcast.
+	static constexpr size_t MAX_BROADCAST_QUEUE_SIZE = 4096;
+	MPMCQueue<MessageToBroadcast> m_sendQueue;
 	std::thread m_broadcastThread;
 
 	std::atomic<size_t> m_numOutbound;
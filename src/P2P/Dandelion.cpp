@@ -9,6 +9,7 @@
 #include <Crypto/CSPRNG.h>
 #include <Common/ThreadManager.h>
 #include <Common/Logger.h>
+#include <algorithm>
 
 Dandelion::Dandelion(
 	const Config& config,
@@ -17,15 +18,18 @@ Dandelion::Dandelion(
 	std::shared_ptr<Locked<TxHashSetManager>> pTxHashSetManager,
 	const ITransactionPool::Ptr& pTransactionPool,
 	std::shared_ptr<const Locked<IBlockDB>> pBlockDB)
-	: m_config(config), 
-	m_connectionManager(connectionManager), 
+	: m_config(config),
+	m_connectionManager(connectionManager),
 	m_pBlockChain(pBlockChain),
 	m_pTxHashSetManager(pTxHashSetManager),
 	m_pTransactionPool(pTransactionPool),
 	m_pBlockDB(pBlockDB),
-	m_relayPeer(nullptr),
-	m_relayExpirationTime(std::chrono::system_clock::now()),
-	m_terminate(false)
+	m_terminate(false),
+	m_stemQueue(MAX_STEM_QUEUE_SIZE),
+	m_timers(NUM_TIMER_SLOTS, std::chrono::seconds(1)),
+	m_fluffScheduled(false),
+	m_epochExpiration(std::chrono::steady_clock::now()),
+	m_fluffEpoch(false)
 {
 
 }
@@ -33,6 +37,7 @@ Dandelion::Dandelion(
 Dandelion::~Dandelion()
 {
 	m_terminate = true;
+	m_stemQueue.notify_all();
 	ThreadUtil::Join(m_dandelionThread);
 }
 
@@ -57,46 +62,46 @@ std::shared_ptr<Dandelion> Dandelion::Create(
 	return pDandelion;
 }
 
-// A process to monitor transactions in the stempool.
-// With Dandelion, transactions can be broadcasted in stem or fluff phase.
-// When sent in stem phase, the transaction is relayed to only 1 node: the dandelion relay.
-// In order to maintain reliability a timer is started for each transaction sent in stem phase.
-// This function will monitor the stempool and test if the timer is expired for each transaction. 
-// In that case  the transaction will be sent in fluff phase (to multiple peers) instead of sending only to the peer relay.
+void Dandelion::AddStemTransaction(const uint64_t sourceId, const TransactionPtr& pTransaction)
+{
+	// If the queue is full, the embargo timer never gets started, so fluff it right away instead of dropping it.
+	if (!m_stemQueue.try_emplace(sourceId, pTransaction))
+	{
+		LOG_WARNING_F("Stem queue full, fluffing {}", *pTransaction);
+		Fluff(pTransaction);
+	}
+}
+
+// A process to relay stem transactions, and fire the patience and embargo timers.
+// The thread sleeps until either a stem transaction is added, or the next tick of the timer wheel.
 void Dandelion::Thread_Monitor(Dandelion& dandelion)
 {
 	ThreadManagerAPI::SetCurrentThreadName("DANDELION");
 	LOG_DEBUG("BEGIN");
 
-	const DandelionConfig& config = dandelion.m_config.GetNodeConfig().GetDandelion();
 	while (!dandelion.m_terminate)
 	{
-		// This is the patience timer, we loop every n secs.
-		const uint8_t patience = config.GetPatienceSeconds();
-		ThreadUtil::SleepFor(std::chrono::seconds(patience), dandelion.m_terminate);
+		const auto timeUntilNextTick = std::chrono::duration_cast<std::chrono::milliseconds>(
+			dandelion.m_timers.GetNextTick() - std::chrono::steady_clock::now()
+		);
+
+		std::vector<StemEntry> stemEntries;
+		dandelion.m_stemQueue.wait_pop_batch(
+			stemEntries,
+			MAX_BATCH_SIZE,
+			(std::max)(timeUntilNextTick, std::chrono::milliseconds(0))
+		);
 
 		try
 		{
-			// Step 1: find all "ToStem" entries in stempool from last run.
-			// Aggregate them up to give a single (valid) aggregated tx and propagate it
-			// to the next Dandelion relay along the stem.
-			if (!dandelion.ProcessStemPhase())
-			{
-				LOG_TRACE("Problem with stem phase");
-			}
-
-			// Step 2: find all "ToFluff" entries in stempool from last run.
-			// Aggregate them up to give a single (valid) aggregated tx and (re)add it
-			// to our pool with stem=false (which will then broadcast it).
-			if (!dandelion.ProcessFluffPhase())
+			for (const StemEntry& entry : stemEntries)
 			{
-				LOG_TRACE("Problem with fluff phase");
+				dandelion.ProcessStemTransaction(entry);
 			}
 
-			// Step 3: now find all expired entries based on embargo timer.
-			if (!dandelion.ProcessExpiredEntries())
+			for (const Timer& timer : dandelion.m_timers.Advance())
 			{
-				LOG_TRACE("Problem processing expired pool entries");
+				dandelion.ProcessTimer(timer);
 			}
 		}
 		catch (std::exception& e)
@@ -108,62 +113,62 @@ void Dandelion::Thread_Monitor(Dandelion& dandelion)
 	LOG_DEBUG("END");
 }
 
-bool Dandelion::ProcessStemPhase()
+void Dandelion::ProcessStemTransaction(const StemEntry& entry)
 {
-	if (m_relayPeer == nullptr || m_relayExpirationTime < std::chrono::system_clock::now())
-	{
-		const std::vector<PeerPtr> mostWorkPeers = m_connectionManager.GetMostWorkPeers();
-		if (mostWorkPeers.empty())
-		{
-			return false;
-		}
+	const DandelionConfig& config = m_config.GetNodeConfig().GetDandelion();
+	const TransactionPtr& pTransaction = entry.pTransaction;
 
-		const uint16_t relaySeconds = m_config.GetNodeConfig().GetDandelion().GetRelaySeconds();
-		m_relayExpirationTime = std::chrono::system_clock::now() + std::chrono::seconds(relaySeconds);
-		const size_t index = CSPRNG::GenerateRandom(0, mostWorkPeers.size() - 1);
-		m_relayPeer = mostWorkPeers[index];
-	}
+	// Fluff it if it's still in the stempool once the embargo expires, in case a node along the stem drops it.
+	const uint16_t embargoSeconds = config.GetEmbargoSeconds() + (uint16_t)CSPRNG::GenerateRandom(0, 30);
+	m_timers.Schedule(std::chrono::seconds(embargoSeconds), Timer{ ETimerType::EMBARGO, pTransaction->GetHash() });
 
-	TransactionPtr pTransactionToStem = nullptr;
+	RefreshEpoch();
 
+	PeerPtr pRelay = m_fluffEpoch ? nullptr : GetRelay(entry.sourceId);
+	if (pRelay != nullptr)
 	{
-		auto locked = MultiLocker().LockShared(*m_pBlockDB, *m_pTxHashSetManager);
-		auto pBlockDBReader = std::get<0>(locked);
-		auto pTxHashSetManager = std::get<1>(locked);
+		LOG_DEBUG_F("Stemming transaction ({}) to {}", *pTransaction, pRelay->GetIPAddress());
 
-		auto pTxHashSet = pTxHashSetManager->GetTxHashSet();
-		if (pTxHashSet == nullptr)
+		const StemTransactionMessage stemTransactionMessage(pTransaction);
+		if (m_connectionManager.SendMessageToPeer(stemTransactionMessage, pRelay))
 		{
-			return false;
+			m_pTransactionPool->ChangeStemStatus({ pTransaction }, EDandelionStatus::STEMMED);
+			return;
 		}
 
-		pTransactionToStem = m_pTransactionPool->GetTransactionToStem(
-			pBlockDBReader.GetShared(),
-			pTxHashSet
-		);
+		// The relay is gone, so sources mapped to it get a new one.
+		LOG_WARNING("Failed to stem, fluffing instead");
+		m_relays.erase(std::remove(m_relays.begin(), m_relays.end(), pRelay), m_relays.end());
+		for (auto iter = m_relayBySource.begin(); iter != m_relayBySource.end();)
+		{
+			iter = iter->second == pRelay ? m_relayBySource.erase(iter) : std::next(iter);
+		}
 	}
 
-	if (pTransactionToStem != nullptr)
+	m_pTransactionPool->ChangeStemStatus({ pTransaction }, EDandelionStatus::TO_FLUFF);
+
+	// Everything marked to fluff before the patience timer fires gets aggregated together.
+	if (!m_fluffScheduled)
 	{
-		LOG_DEBUG_F("Stemming transaction ({})", *pTransactionToStem);
+		m_timers.Schedule(std::chrono::seconds(config.GetPatienceSeconds()), Timer{ ETimerType::FLUFF, ZERO_HASH });
+		m_fluffScheduled = true;
+	}
+}
 
-		// Send Transaction to next Dandelion Relay.
-		const StemTransactionMessage stemTransactionMessage(pTransactionToStem);
-		const bool success = m_connectionManager.SendMessageToPeer(stemTransactionMessage, m_relayPeer);
-		
-		// If failed to send, fluff instead.
-		if (!success)
+void Dandelion::ProcessTimer(const Timer& timer)
+{
+	if (timer.type == ETimerType::FLUFF)
+	{
+		m_fluffScheduled = false;
+		if (!ProcessFluffPhase())
 		{
-			LOG_WARNING("Failed to stem, fluffing instead");
-			const bool added = m_pBlockChain->AddTransaction(pTransactionToStem, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS;
-			if (added)
-			{
-				m_connectionManager.BroadcastMessage(TransactionMessage(pTransactionToStem), 0);
-			}
+			LOG_TRACE("Problem with fluff phase");
 		}
 	}
-
-	return true;
+	else if (!ProcessExpiredTransaction(timer.txHash))
+	{
+		LOG_TRACE("Problem processing expired transaction");
+	}
 }
 
 bool Dandelion::ProcessFluffPhase()
@@ -196,24 +201,87 @@ bool Dandelion::ProcessFluffPhase()
 	return true;
 }
 
-bool Dandelion::ProcessExpiredEntries()
+bool Dandelion::ProcessExpiredTransaction(const Hash& txHash)
+{
+	// Already fluffed, or seen in the mempool or a block.
+	TransactionPtr pTransaction = m_pTransactionPool->GetStemTransaction(txHash);
+	if (pTransaction == nullptr)
+	{
+		return true;
+	}
+
+	LOG_INFO_F("Embargo expired for {}, fluffing now", *pTransaction);
+	Fluff(pTransaction);
+	return true;
+}
+
+void Dandelion::Fluff(const TransactionPtr& pTransaction)
+{
+	if (m_pBlockChain->AddTransaction(pTransaction, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS)
+	{
+		m_connectionManager.BroadcastMessage(TransactionMessage(pTransaction), 0);
+	}
+	else
+	{
+		LOG_INFO_F("Failed to add {} to mempool", *pTransaction);
+	}
+}
+
+// Starts a new epoch once the current one expires, and picks new relays if all of the current ones are gone.
+void Dandelion::RefreshEpoch()
 {
-	const std::vector<TransactionPtr> expiredTransactions = m_pTransactionPool->GetExpiredTransactions();
-	if (!expiredTransactions.empty())
+	const DandelionConfig& config = m_config.GetNodeConfig().GetDandelion();
+
+	const auto now = std::chrono::steady_clock::now();
+	if (now >= m_epochExpiration)
+	{
+		m_epochExpiration = now + std::chrono::seconds(config.GetRelaySeconds());
+		m_fluffEpoch = (uint8_t)CSPRNG::GenerateRandom(1, 100) > config.GetStemProbability();
+		m_relays.clear();
+		m_relayBySource.clear();
+
+		LOG_DEBUG_F("New dandelion epoch. Fluffing: {}", m_fluffEpoch);
+	}
+
+	if (m_fluffEpoch || !m_relays.empty())
 	{
-		LOG_INFO_F("{} transactions expired, fluffing now", expiredTransactions.size());
-		for (auto& pTransaction : expiredTransactions)
+		return;
+	}
+
+	std::vector<ConnectedPeer> connectedPeers = m_connectionManager.GetConnectedPeers();
+
+	std::vector<PeerPtr> outboundPeers;
+	for (ConnectedPeer& connectedPeer : connectedPeers)
+	{
+		if (connectedPeer.GetDirection() == EDirection::OUTBOUND)
 		{
-			if (m_pBlockChain->AddTransaction(pTransaction, EPoolType::MEMPOOL) == EBlockChainStatus::SUCCESS)
-			{
-				m_connectionManager.BroadcastMessage(TransactionMessage(pTransaction), 0);
-			}
-			else
-			{
-				LOG_INFO_F("Failed to add {} to mempool", *pTransaction);
-			}
+			outboundPeers.push_back(connectedPeer.GetPeer());
 		}
 	}
 
-	return true;
-}
\ No newline at end of file
+	while (m_relays.size() < NUM_RELAYS && !outboundPeers.empty())
+	{
+		const size_t index = (size_t)CSPRNG::GenerateRandom(0, outboundPeers.size() - 1);
+		m_relays.push_back(outboundPeers[index]);
+		outboundPeers.erase(outboundPeers.begin() + index);
+	}
+}
+
+// Each source keeps the same relay for the whole epoch.
+PeerPtr Dandelion::GetRelay(const uint64_t sourceId)
+{
+	auto iter = m_relayBySource.find(sourceId);
+	if (iter != m_relayBySource.end())
+	{
+		return iter->second;
+	}
+
+	if (m_relays.empty())
+	{
+		return nullptr;
+	}
+
+	PeerPtr pRelay = m_relays[(size_t)CSPRNG::GenerateRandom(0, m_relays.size() - 1)];
+	m_relayBySource.insert({ sourceId, pRelay });
+	return pRelay;
+}
@@ -4,14 +4,30 @@
 #include <BlockChain/BlockChain.h>
 #include <TxPool/TransactionPool.h>
 #include <P2P/Peer.h>
+#include <Common/MPMCQueue.h>
+#include <Common/TimerWheel.h>
+#include <Crypto/Hash.h>
 
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <unordered_map>
+#include <vector>
 
 // Forward Declarations
 class ConnectionManager;
 
+//
+// Relays stem transactions using Dandelion++.
+//
+// Time is split into epochs. At the start of each epoch, the node randomly becomes either a stem node or a fluff node,
+// and picks a couple of outbound peers as its relays. Each inbound connection is mapped to one of those relays for the whole epoch,
+// so transactions from the same source always take the same path.
+//
+// Stem nodes forward each stem transaction to its relay as soon as it's added to the stempool.
+// Fluff nodes wait for the patience timer, and then aggregate all the transactions waiting to be fluffed and broadcast them.
+// Every stem transaction also gets an embargo timer, and is fluffed if it's still in the stempool when the timer fires.
+//
 class Dandelion
 {
 public:
@@ -25,6 +41,12 @@ public:
 	);
 	~Dandelion();
 
+	//
+	// Called once a stem transaction has been added to the stempool.
+	// sourceId is the id of the connection it was received from, or 0 if it was submitted locally.
+	//
+	void AddStemTransaction(const uint64_t sourceId, const TransactionPtr& pTransaction);
+
 private:
 	Dandelion(
 		const Config& config,
@@ -35,11 +57,52 @@ private:
 		std::shared_ptr<const Locked<IBlockDB>> pBlockDB
 	);
 
+	struct StemEntry
+	{
+		StemEntry(const uint64_t sourceId_, TransactionPtr pTransaction_)
+			: sourceId(sourceId_), pTransaction(pTransaction_) { }
+
+		uint64_t sourceId;
+		TransactionPtr pTransaction;
+	};
+
+	enum class ETimerType
+	{
+		// The patience timer. Fluffs all the transactions waiting to be fluffed.
+		FLUFF,
+
+		// Fluffs the transaction if it's still in the stempool.
+		EMBARGO
+	};
+
+	struct Timer
+	{
+		ETimerType type;
+		Hash txHash;
+	};
+
+	// The number of outbound peers picked as relays each epoch.
+	static constexpr size_t NUM_RELAYS = 2;
+
+	// The max number of stem transactions waiting to be relayed.
+	static constexpr size_t MAX_STEM_QUEUE_SIZE = 1024;
+
+	// The max number of stem transactions relayed before checking the timers.
+	static constexpr size_t MAX_BATCH_SIZE = 64;
+
+	// Each slot of the timer wheel is 1 second, so the default embargo fits within a single turn.
+	static constexpr size_t NUM_TIMER_SLOTS = 256;
+
 	static void Thread_Monitor(Dandelion& dandelion);
 
-	bool ProcessStemPhase();
+	void ProcessStemTransaction(const StemEntry& entry);
+	void ProcessTimer(const Timer& timer);
 	bool ProcessFluffPhase();
-	bool ProcessExpiredEntries();
+	bool ProcessExpiredTransaction(const Hash& txHash);
+
+	void Fluff(const TransactionPtr& pTransaction);
+	void RefreshEpoch();
+	PeerPtr GetRelay(const uint64_t sourceId);
 
 	const Config& m_config;
 	ConnectionManager& m_connectionManager;
@@ -51,6 +114,14 @@ private:
 	std::atomic_bool m_terminate = true;
 	std::thread m_dandelionThread;
 
-	PeerPtr m_relayPeer;
-	std::chrono::time_point<std::chrono::system_clock> m_relayExpirationTime;
-};
\ No newline at end of file
+	MPMCQueue<StemEntry> m_stemQueue;
+
+	// Everything below is only accessed by the dandelion thread.
+	TimerWheel<Timer> m_timers;
+	bool m_fluffScheduled;
+
+	std::chrono::steady_clock::time_point m_epochExpiration;
+	bool m_fluffEpoch;
+	std::vector<PeerPtr> m_relays;
+	std::unordered_map<uint64_t, PeerPtr> m_relayBySource;
+};
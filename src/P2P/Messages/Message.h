@@ -14,18 +14,25 @@ public:
 	virtual std::shared_ptr<IMessage> Clone() const = 0;
 
 	virtual MessageTypes::EMessageType GetMessageType() const = 0;
+
+	//
+	// Serialize() calls this twice, once to size the body and once to write it,
+	// so implementations must only append to the serializer, without any other side effects (eg. logging).
+	//
 	virtual void SerializeBody(Serializer& serializer) const = 0;
 
 	std::vector<uint8_t> Serialize(const Environment& environment, const EProtocolVersion protocolVersion) const
 	{
-		Serializer serializer(protocolVersion);
-		serializer.AppendByteVector(environment.GetMagicBytes());
-		serializer.Append<uint8_t>((uint8_t)GetMessageType());
+		// Size the body first, so it can be written straight after the header without resizing.
+		SizeCounter bodySize(protocolVersion);
+		SerializeBody(bodySize);
 
-		Serializer bodySerializer(protocolVersion);
-		SerializeBody(bodySerializer);
-		serializer.Append<uint64_t>(bodySerializer.size());
-		serializer.AppendByteVector(bodySerializer.GetBytes());
+		const std::vector<uint8_t>& magicBytes = environment.GetMagicBytes();
+		Serializer serializer(magicBytes.size() + sizeof(uint8_t) + sizeof(uint64_t) + bodySize.GetSize(), protocolVersion);
+		serializer.AppendByteVector(magicBytes);
+		serializer.Append<uint8_t>((uint8_t)GetMessageType());
+		serializer.Append<uint64_t>(bodySize.GetSize());
+		SerializeBody(serializer);
 
 		return serializer.GetBytes();
 	}
@@ -58,11 +58,22 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 
 	const Config& config = pContext->GetConfig();
 
+	// Dandelion
+	std::shared_ptr<Dandelion> pDandelion = Dandelion::Create(
+		config,
+		*pConnectionManager,
+		pBlockChain,
+		pTxHashSetManager,
+		pTransactionPool,
+		pDatabase->GetBlockDB()
+	);
+
 	// Pipeline
 	std::shared_ptr<Pipeline> pPipeline = Pipeline::Create(
 		config,
 		pConnectionManager,
 		pBlockChain,
+		pDandelion,
 		pSyncStatus
 	);
 
@@ -84,16 +95,6 @@ std::shared_ptr<P2PServer> P2PServer::Create(
 		pSyncStatus
 	);
 
-	// Dandelion
-	std::shared_ptr<Dandelion> pDandelion = Dandelion::Create(
-		config,
-		*pConnectionManager,
-		pBlockChain,
-		pTxHashSetManager,
-		pTransactionPool,
-		pDatabase->GetBlockDB()
-	);
-
 	// P2P Server
 	return std::shared_ptr<P2PServer>(new P2PServer(
 		pSyncStatus,
@@ -114,6 +115,11 @@ std::pair<size_t, size_t> P2PServer::GetNumberOfConnectedPeers() const
 	);
 }
 
+TransactionQueueStats P2PServer::GetTransactionQueueStats() const
+{
+	return m_pPipeline->GetTransactionPipe()->GetQueueStats();
+}
+
 std::vector<PeerConstPtr> P2PServer::GetAllPeers() const
 {
 	return m_pPeerManager->Read()->GetAllPeers();
@@ -175,6 +181,11 @@ void P2PServer::BroadcastTransaction(const TransactionPtr& pTransaction)
 	}
 }
 
+void P2PServer::StemTransaction(const TransactionPtr& pTransaction)
+{
+	m_pDandelion->AddStemTransaction(0, pTransaction);
+}
+
 namespace P2PAPI
 {
 	EXPORT std::shared_ptr<IP2PServer> StartP2PServer(
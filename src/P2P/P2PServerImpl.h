@@ -27,6 +27,7 @@ public:
 	SyncStatusConstPtr GetSyncStatus() const final { return m_pSyncStatus; }
 
 	std::pair<size_t, size_t> GetNumberOfConnectedPeers() const final;
+	TransactionQueueStats GetTransactionQueueStats() const final;
 	std::vector<PeerConstPtr> GetAllPeers() const final;
 	std::vector<ConnectedPeer> GetConnectedPeers() const final;
 	std::optional<PeerConstPtr> GetPeer(const IPAddress& address) const final;
@@ -36,6 +37,7 @@ public:
 	bool UnbanAllPeers() final;
 
 	void BroadcastTransaction(const TransactionPtr& pTransaction) final;
+	void StemTransaction(const TransactionPtr& pTransaction) final;
 
 private:
 	P2PServer(
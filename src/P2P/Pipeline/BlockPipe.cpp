@@ -8,13 +8,14 @@
 #include <BlockChain/BlockChain.h>
 
 BlockPipe::BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain)
-	: m_config(config), m_pBlockChain(pBlockChain), m_terminate(false)
+	: m_config(config), m_pBlockChain(pBlockChain), m_blocksToProcess(MAX_QUEUE_SIZE), m_terminate(false)
 {
 }
 
 BlockPipe::~BlockPipe()
 {
 	m_terminate = true;
+	m_blocksToProcess.notify_all();
 
 	ThreadUtil::Join(m_blockThread);
 	ThreadUtil::Join(m_processThread);
@@ -36,7 +37,8 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 
 	while (!pipeline.m_terminate)
 	{
-		std::vector<BlockEntry> blocksToProcess = pipeline.m_blocksToProcess.copy_front(8); // TODO: Use number of CPU threads.
+		std::vector<BlockEntry> blocksToProcess;
+		pipeline.m_blocksToProcess.wait_pop_batch(blocksToProcess, 8, std::chrono::milliseconds(100)); // TODO: Use number of CPU threads.
 		if (!blocksToProcess.empty())
 		{
 			if (blocksToProcess.size() == 1)
@@ -48,17 +50,17 @@ void BlockPipe::Thread_ProcessNewBlocks(BlockPipe& pipeline)
 				std::vector<std::thread> tasks;
 				for (const BlockEntry& blockEntry : blocksToProcess)
 				{
-					tasks.push_back(std::thread([&pipeline, blockEntry] { ProcessNewBlock(pipeline, blockEntry); }));
+					tasks.push_back(std::thread([&pipeline, &blockEntry] { ProcessNewBlock(pipeline, blockEntry); }));
 				}
 
 				ThreadUtil::JoinAll(tasks);
 			}
 
-			pipeline.m_blocksToProcess.pop_front(blocksToProcess.size());
-		}
-		else
-		{
-			ThreadUtil::SleepFor(std::chrono::milliseconds(5), pipeline.m_terminate);
+			std::unique_lock<std::mutex> lock(pipeline.m_processingMutex);
+			for (const BlockEntry& blockEntry : blocksToProcess)
+			{
+				pipeline.m_processing.erase(blockEntry.m_block.GetHash());
+			}
 		}
 	}
 
@@ -100,20 +102,24 @@ void BlockPipe::Thread_PostProcessBlocks(BlockPipe& pipeline)
 
 bool BlockPipe::AddBlockToProcess(PeerPtr pPeer, const FullBlock& block)
 {
-	std::function<bool(const BlockEntry&, const BlockEntry&)> comparator = [](const BlockEntry& blockEntry1, const BlockEntry& blockEntry2)
+	std::unique_lock<std::mutex> lock(m_processingMutex);
+	if (!m_processing.insert(block.GetHash()).second)
 	{
-		return blockEntry1.m_block.GetHash() == blockEntry2.m_block.GetHash();
-	};
+		return false;
+	}
 
-	return m_blocksToProcess.push_back_unique(BlockEntry(pPeer, block), comparator);
+	if (!m_blocksToProcess.try_push(BlockEntry(pPeer, block)))
+	{
+		LOG_WARNING_F("Queue full. Dropping block {}.", block);
+		m_processing.erase(block.GetHash());
+		return false;
+	}
+
+	return true;
 }
 
 bool BlockPipe::IsProcessingBlock(const Hash& hash) const
 {
-	std::function<bool(const BlockEntry&, const Hash&)> comparator = [](const BlockEntry& blockEntry, const Hash& hash)
-	{
-		return blockEntry.m_block.GetHash() == hash;
-	};
-
-	return m_blocksToProcess.contains<Hash>(hash, comparator);
+	std::unique_lock<std::mutex> lock(m_processingMutex);
+	return m_processing.find(hash) != m_processing.cend();
 }
\ No newline at end of file
@@ -4,11 +4,13 @@
 #include <P2P/Peer.h>
 #include <Core/Models/FullBlock.h>
 #include <BlockChain/BlockChain.h>
-#include <Common/ConcurrentQueue.h>
+#include <Common/MPMCQueue.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
 #include <thread>
+#include <mutex>
+#include <unordered_set>
 
 // Forward Declarations
 class Config;
@@ -30,6 +32,9 @@ public:
 private:
 	BlockPipe(const Config& config, const IBlockChain::Ptr& pBlockChain);
 
+	// The max number of blocks waiting to be processed.
+	static constexpr size_t MAX_QUEUE_SIZE = 1024;
+
 	const Config& m_config;
 	IBlockChain::Ptr m_pBlockChain;
 
@@ -49,7 +54,11 @@ private:
 	static void Thread_ProcessNewBlocks(BlockPipe& pipeline);
 	static void ProcessNewBlock(BlockPipe& pipeline, const BlockEntry& blockEntry);
 	std::thread m_blockThread;
-	ConcurrentQueue<BlockEntry> m_blocksToProcess;
+	MPMCQueue<BlockEntry> m_blocksToProcess;
+
+	// Hashes of the blocks that are queued or being processed.
+	mutable std::mutex m_processingMutex;
+	std::unordered_set<Hash> m_processing;
 
 	// Process Next Block
 	std::thread m_processThread;
@@ -2,6 +2,7 @@
 
 #include "../ConnectionManager.h"
 #include "../Connection.h"
+#include "../Dandelion.h"
 #include "BlockPipe.h"
 #include "TransactionPipe.h"
 #include "TxHashSetPipe.h"
@@ -20,10 +21,11 @@ public:
 		const Config& config,
 		ConnectionManagerPtr pConnectionManager,
 		const IBlockChain::Ptr& pBlockChain,
+		const std::shared_ptr<Dandelion>& pDandelion,
 		SyncStatusPtr pSyncStatus)
 	{
 		std::shared_ptr<BlockPipe> pBlockPipe = BlockPipe::Create(config, pBlockChain);
-		std::shared_ptr<TransactionPipe> pTransactionPipe = TransactionPipe::Create(config, pConnectionManager, pBlockChain);
+		std::shared_ptr<TransactionPipe> pTransactionPipe = TransactionPipe::Create(config, pConnectionManager, pBlockChain, pDandelion);
 		std::shared_ptr<TxHashSetPipe> pTxHashSetPipe = TxHashSetPipe::Create(config, pBlockChain, pSyncStatus);
 
 		return std::shared_ptr<Pipeline>(new Pipeline(pBlockPipe, pTransactionPipe, pTxHashSetPipe));
@@ -1,14 +1,25 @@
 #include "TransactionPipe.h"
 #include "../Messages/TransactionKernelMessage.h"
 #include "../ConnectionManager.h"
+#include "../Dandelion.h"
 
 #include <Common/Util/ThreadUtil.h>
 #include <Common/ThreadManager.h>
 #include <Common/Logger.h>
 #include <BlockChain/BlockChain.h>
+#include <algorithm>
 
-TransactionPipe::TransactionPipe(const Config& config, const std::shared_ptr<ConnectionManager>& pConnectionManager, const std::shared_ptr<IBlockChain>& pBlockChain)
-	: m_config(config), m_pConnectionManager(pConnectionManager), m_pBlockChain(pBlockChain), m_terminate(false)
+TransactionPipe::TransactionPipe(
+	const Config& config,
+	const std::shared_ptr<ConnectionManager>& pConnectionManager,
+	const std::shared_ptr<IBlockChain>& pBlockChain,
+	const std::shared_ptr<Dandelion>& pDandelion)
+	: m_config(config),
+	m_pConnectionManager(pConnectionManager),
+	m_pBlockChain(pBlockChain),
+	m_pDandelion(pDandelion),
+	m_transactionsToProcess(MAX_QUEUE_SIZE, MAX_QUEUE_SIZE_PER_PEER),
+	m_terminate(false)
 {
 
 }
@@ -16,17 +27,25 @@ TransactionPipe::TransactionPipe(const Config& config, const std::shared_ptr<Con
 TransactionPipe::~TransactionPipe()
 {
 	m_terminate = true;
+	m_transactionsToProcess.Shutdown();
 
-	ThreadUtil::Join(m_transactionThread);
+	ThreadUtil::JoinAll(m_workerThreads);
 }
 
 std::shared_ptr<TransactionPipe> TransactionPipe::Create(
 	const Config& config,
 	const std::shared_ptr<ConnectionManager>& pConnectionManager,
-	const std::shared_ptr<IBlockChain>& pBlockChain)
+	const std::shared_ptr<IBlockChain>& pBlockChain,
+	const std::shared_ptr<Dandelion>& pDandelion)
 {
-	std::shared_ptr<TransactionPipe> pTxPipe = std::shared_ptr<TransactionPipe>(new TransactionPipe(config, pConnectionManager, pBlockChain));
-	pTxPipe->m_transactionThread = std::thread(Thread_ProcessTransactions, std::ref(*pTxPipe.get()));
+	std::shared_ptr<TransactionPipe> pTxPipe = std::shared_ptr<TransactionPipe>(new TransactionPipe(config, pConnectionManager, pBlockChain, pDandelion));
+
+	// Each worker validates its own batch, so one slow batch doesn't hold up the rest of the queue.
+	const size_t numWorkers = (std::max)(std::thread::hardware_concurrency() / 2, 1u);
+	for (size_t i = 0; i < numWorkers; i++)
+	{
+		pTxPipe->m_workerThreads.push_back(std::thread(Thread_ProcessTransactions, std::ref(*pTxPipe.get())));
+	}
 
 	return pTxPipe;
 }
@@ -38,50 +57,74 @@ void TransactionPipe::Thread_ProcessTransactions(TransactionPipe& pipeline)
 
 	while (!pipeline.m_terminate)
 	{
+		const std::vector<TxEntry> txEntries = pipeline.m_transactionsToProcess.PopBatch(MAX_BATCH_SIZE, std::chrono::milliseconds(100));
+		if (txEntries.empty())
+		{
+			continue;
+		}
+
 		try
 		{
-			std::unique_ptr<TxEntry> pTxEntry = pipeline.m_transactionsToProcess.copy_front();
-			if (pTxEntry != nullptr)
+			for (const EPoolType poolType : { EPoolType::MEMPOOL, EPoolType::STEMPOOL })
 			{
-				const EBlockChainStatus status = pipeline.m_pBlockChain->AddTransaction(pTxEntry->pTransaction, pTxEntry->poolType);
-				if (status == EBlockChainStatus::SUCCESS && pTxEntry->poolType == EPoolType::MEMPOOL)
-				{
-					// Broacast TransactionKernelMsg
-					const std::vector<TransactionKernel>& kernels = pTxEntry->pTransaction->GetKernels();
-					for (auto& kernel : kernels)
-					{
-						const TransactionKernelMessage message(kernel.GetHash());
-						LOG_DEBUG_F("Broadcasting kernel {}", kernel.GetHash());
-						pipeline.m_pConnectionManager->BroadcastMessage(message, pTxEntry->m_connectionId);
-					}
-				}
-				else if (status == EBlockChainStatus::INVALID)
-				{
-					pTxEntry->m_peer->Ban(EBanReason::BadTransaction);
-				}
-
-				pipeline.m_transactionsToProcess.pop_front(1);
-			}
-			else
-			{
-				ThreadUtil::SleepFor(std::chrono::milliseconds(5), pipeline.m_terminate);
+				ProcessTransactions(pipeline, txEntries, poolType);
 			}
 		}
 		catch (std::exception& e)
 		{
 			LOG_ERROR_F("Exception caught: {}", e.what());
 		}
+
+		pipeline.m_transactionsToProcess.Complete(txEntries);
 	}
 
 	LOG_TRACE("END");
 }
 
-bool TransactionPipe::AddTransactionToProcess(Connection& connection, const TransactionPtr& pTransaction, const EPoolType poolType)
+void TransactionPipe::ProcessTransactions(TransactionPipe& pipeline, const std::vector<TxEntry>& txEntries, const EPoolType poolType)
 {
-	std::function<bool(const TxEntry&, const TxEntry&)> comparator = [](const TxEntry& txEntry1, const TxEntry& txEntry2)
+	std::vector<const TxEntry*> entries;
+	std::vector<TransactionPtr> transactions;
+	for (const TxEntry& txEntry : txEntries)
 	{
-		return txEntry1.pTransaction->GetHash() == txEntry2.pTransaction->GetHash();
-	};
+		if (txEntry.poolType == poolType)
+		{
+			entries.push_back(&txEntry);
+			transactions.push_back(txEntry.pTransaction);
+		}
+	}
 
-	return m_transactionsToProcess.push_back_unique(TxEntry(connection.GetId(), connection.GetPeer(), pTransaction, poolType), comparator);
-}
\ No newline at end of file
+	if (transactions.empty())
+	{
+		return;
+	}
+
+	const std::vector<EBlockChainStatus> statuses = pipeline.m_pBlockChain->AddTransactions(transactions, poolType);
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		if (statuses[i] == EBlockChainStatus::SUCCESS && poolType == EPoolType::MEMPOOL)
+		{
+			// Broacast TransactionKernelMsg
+			const std::vector<TransactionKernel>& kernels = entries[i]->pTransaction->GetKernels();
+			for (auto& kernel : kernels)
+			{
+				const TransactionKernelMessage message(kernel.GetHash());
+				LOG_DEBUG_F("Broadcasting kernel {}", kernel.GetHash());
+				pipeline.m_pConnectionManager->BroadcastMessage(message, entries[i]->m_connectionId);
+			}
+		}
+		else if (statuses[i] == EBlockChainStatus::SUCCESS && poolType == EPoolType::STEMPOOL)
+		{
+			pipeline.m_pDandelion->AddStemTransaction(entries[i]->m_connectionId, entries[i]->pTransaction);
+		}
+		else if (statuses[i] == EBlockChainStatus::INVALID)
+		{
+			entries[i]->m_peer->Ban(EBanReason::BadTransaction);
+		}
+	}
+}
+
+bool TransactionPipe::AddTransactionToProcess(Connection& connection, const TransactionPtr& pTransaction, const EPoolType poolType)
+{
+	return m_transactionsToProcess.Push(TxEntry(connection.GetId(), connection.GetPeer(), pTransaction, poolType));
+}
@@ -1,20 +1,23 @@
 #pragma once
 
+#include "TransactionQueue.h"
+
 #include <Crypto/Hash.h>
 #include <P2P/Peer.h>
+#include <P2P/TransactionQueueStats.h>
 #include <TxPool/PoolType.h>
 #include <Core/Models/Transaction.h>
-#include <Common/ConcurrentQueue.h>
 #include <string>
 #include <cstdint>
 #include <atomic>
 #include <thread>
-#include <deque>
+#include <vector>
 
 // Forward Declarations
 class Config;
 class Connection;
 class ConnectionManager;
+class Dandelion;
 class IBlockChain;
 class TxHashSetArchiveMessage;
 
@@ -24,40 +27,40 @@ public:
 	static std::shared_ptr<TransactionPipe> Create(
 		const Config& config,
 		const std::shared_ptr<ConnectionManager>& pConnectionManager,
-		const std::shared_ptr<IBlockChain>& pBlockChain
+		const std::shared_ptr<IBlockChain>& pBlockChain,
+		const std::shared_ptr<Dandelion>& pDandelion
 	);
 	~TransactionPipe();
 
 	bool AddTransactionToProcess(Connection& connection, const TransactionPtr& pTransaction, const EPoolType poolType);
 
+	TransactionQueueStats GetQueueStats() const { return m_transactionsToProcess.GetStats(); }
+
 private:
 	TransactionPipe(
 		const Config& config,
 		const std::shared_ptr<ConnectionManager>& pConnectionManager,
-		const std::shared_ptr<IBlockChain>& pBlockChain
+		const std::shared_ptr<IBlockChain>& pBlockChain,
+		const std::shared_ptr<Dandelion>& pDandelion
 	);
 
+	// The max number of queued transactions validated together.
+	static constexpr size_t MAX_BATCH_SIZE = 64;
+
+	// The max number of transactions waiting to be processed, in total and from any one peer.
+	static constexpr size_t MAX_QUEUE_SIZE = 10'000;
+	static constexpr size_t MAX_QUEUE_SIZE_PER_PEER = 1'000;
+
 	const Config& m_config;
 	std::shared_ptr<ConnectionManager> m_pConnectionManager;
 	std::shared_ptr<IBlockChain> m_pBlockChain;
+	std::shared_ptr<Dandelion> m_pDandelion;
 
 	static void Thread_ProcessTransactions(TransactionPipe& pipeline);
-	std::thread m_transactionThread;
-	struct TxEntry
-	{
-		TxEntry(const uint64_t connectionId, PeerPtr pPeer, TransactionPtr txn, const EPoolType type)
-			: m_connectionId(connectionId), m_peer(pPeer), pTransaction(txn), poolType(type)
-		{
-
-		}
-
-		uint64_t m_connectionId;
-		PeerPtr m_peer;
-		TransactionPtr pTransaction;
-		EPoolType poolType;
-	};
+	static void ProcessTransactions(TransactionPipe& pipeline, const std::vector<TxEntry>& txEntries, const EPoolType poolType);
+	std::vector<std::thread> m_workerThreads;
 
-	ConcurrentQueue<TxEntry> m_transactionsToProcess;
+	TransactionQueue m_transactionsToProcess;
 
 	std::atomic_bool m_terminate;
-};
\ No newline at end of file
+};
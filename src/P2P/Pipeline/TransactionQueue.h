@@ -0,0 +1,173 @@
+#pragma once
+
+#include <P2P/Peer.h>
+#include <P2P/TransactionQueueStats.h>
+#include <TxPool/PoolType.h>
+#include <Core/Models/Transaction.h>
+#include <Crypto/Hash.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct TxEntry
+{
+	TxEntry(const uint64_t connectionId, PeerPtr pPeer, TransactionPtr txn, const EPoolType type)
+		: m_connectionId(connectionId), m_peer(pPeer), pTransaction(txn), poolType(type)
+	{
+
+	}
+
+	uint64_t m_connectionId;
+	PeerPtr m_peer;
+	TransactionPtr pTransaction;
+	EPoolType poolType;
+};
+
+//
+// A bounded queue of transactions received from peers, which is drained in batches by the TransactionPipe's workers.
+// Each connection gets its own lane, and batches are filled round-robin across the lanes,
+// so a peer flooding transactions only fills up its own lane instead of starving the others.
+// Transactions are deduplicated by hash from the time they're queued until they're done being processed.
+//
+class TransactionQueue
+{
+public:
+	TransactionQueue(const size_t maxSize, const size_t maxPerPeer)
+		: m_maxSize(maxSize),
+		m_maxPerPeer(maxPerPeer),
+		m_size(0),
+		m_inFlight(0),
+		m_numProcessed(0),
+		m_numDuplicates(0),
+		m_numDropped(0),
+		m_shutdown(false)
+	{
+
+	}
+
+	//
+	// Returns false if the transaction is already queued or being processed,
+	// or if the queue or the peer's lane is full.
+	//
+	bool Push(TxEntry&& entry)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		const Hash& hash = entry.pTransaction->GetHash();
+		if (m_hashes.find(hash) != m_hashes.cend())
+		{
+			++m_numDuplicates;
+			return false;
+		}
+
+		auto iter = m_lanes.find(entry.m_connectionId);
+		if (m_size >= m_maxSize || (iter != m_lanes.end() && iter->second.size() >= m_maxPerPeer))
+		{
+			++m_numDropped;
+			return false;
+		}
+
+		if (iter == m_lanes.end())
+		{
+			iter = m_lanes.insert({ entry.m_connectionId, std::deque<TxEntry>() }).first;
+			m_laneOrder.push_back(entry.m_connectionId);
+		}
+
+		m_hashes.insert(hash);
+		iter->second.push_back(std::move(entry));
+		++m_size;
+
+		lock.unlock();
+		m_condition.notify_one();
+		return true;
+	}
+
+	//
+	// Waits up to the timeout for transactions to be queued, and then takes up to maxItems of them, one from each lane at a time.
+	// Complete() must be called once they're processed.
+	//
+	std::vector<TxEntry> PopBatch(const size_t maxItems, const std::chrono::milliseconds& timeout)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_condition.wait_for(lock, timeout, [this] { return m_size > 0 || m_shutdown; });
+
+		std::vector<TxEntry> batch;
+		while (batch.size() < maxItems && m_size > 0)
+		{
+			const uint64_t connectionId = m_laneOrder.front();
+			m_laneOrder.pop_front();
+
+			auto iter = m_lanes.find(connectionId);
+			batch.push_back(std::move(iter->second.front()));
+			iter->second.pop_front();
+			--m_size;
+
+			if (iter->second.empty())
+			{
+				m_lanes.erase(iter);
+			}
+			else
+			{
+				m_laneOrder.push_back(connectionId);
+			}
+		}
+
+		m_inFlight += batch.size();
+		return batch;
+	}
+
+	void Complete(const std::vector<TxEntry>& batch)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		for (const TxEntry& entry : batch)
+		{
+			m_hashes.erase(entry.pTransaction->GetHash());
+		}
+
+		m_inFlight -= batch.size();
+		m_numProcessed += batch.size();
+	}
+
+	//
+	// Wakes up all workers waiting in PopBatch().
+	//
+	void Shutdown()
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_shutdown = true;
+		}
+
+		m_condition.notify_all();
+	}
+
+	TransactionQueueStats GetStats() const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		return TransactionQueueStats(m_size, m_inFlight, m_lanes.size(), m_numProcessed, m_numDuplicates, m_numDropped);
+	}
+
+private:
+	const size_t m_maxSize;
+	const size_t m_maxPerPeer;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+
+	std::unordered_map<uint64_t, std::deque<TxEntry>> m_lanes;
+	std::deque<uint64_t> m_laneOrder;
+	std::unordered_set<Hash> m_hashes;
+
+	size_t m_size;
+	size_t m_inFlight;
+	uint64_t m_numProcessed;
+	uint64_t m_numDuplicates;
+	uint64_t m_numDropped;
+	bool m_shutdown;
+};
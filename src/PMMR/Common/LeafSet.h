@@ -31,6 +31,9 @@ public:
 
 	void Rewind(const uint64_t numLeaves, const std::vector<uint64_t>& leavesToAdd) { m_pBitmap->Rewind(numLeaves, leavesToAdd); }
 	void Commit() { m_pBitmap->Commit(); }
+	void Commit(std::vector<WriteAheadLog::Entry>& entries) { m_pBitmap->Commit(entries); }
+	void BeginFlush() { m_pBitmap->BeginFlush(); }
+	void EndFlush(const bool sync) { m_pBitmap->EndFlush(sync); }
 	void Rollback() noexcept { m_pBitmap->Rollback(); }
 	void Snapshot(const Hash& blockHash)
 	{
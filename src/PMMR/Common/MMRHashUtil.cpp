@@ -2,7 +2,7 @@
 #include "MMRUtil.h"
 #include "LeafSet.h"
 
-#include <Crypto/Hasher.h>
+#include <Crypto/Blake2bHasher.h>
 #include <Core/Serialization/Serializer.h>
 
 void MMRHashUtil::AddHashes(
@@ -142,17 +142,17 @@ std::vector<Hash> MMRHashUtil::GetLastLeafHashes(
 
 Hash MMRHashUtil::HashLeafWithIndex(const std::vector<unsigned char>& serializedLeaf, const uint64_t mmrIndex)
 {
-	Serializer hashSerializer;
-	hashSerializer.Append<uint64_t>(mmrIndex);
-	hashSerializer.AppendByteVector(serializedLeaf);
-	return Hasher::Blake2b(hashSerializer.GetBytes());
+	Blake2bHasher hasher;
+	hasher.Append<uint64_t>(mmrIndex);
+	hasher.AppendByteVector(serializedLeaf);
+	return hasher.Finalize();
 }
 
 Hash MMRHashUtil::HashParentWithIndex(const Hash& leftChild, const Hash& rightChild, const uint64_t parentIndex)
 {
-	Serializer serializer;
-	serializer.Append<uint64_t>(parentIndex);
-	serializer.AppendBigInteger<32>(leftChild);
-	serializer.AppendBigInteger<32>(rightChild);
-	return Hasher::Blake2b(serializer.GetBytes());
+	Blake2bHasher hasher;
+	hasher.Append<uint64_t>(parentIndex);
+	hasher.AppendBigInteger<32>(leftChild);
+	hasher.AppendBigInteger<32>(rightChild);
+	return hasher.Finalize();
 }
\ No newline at end of file
@@ -0,0 +1,344 @@
+#pragma once
+
+#include "HashFile.h"
+#include "LeafSet.h"
+#include "PruneList.h"
+#include "MMRUtil.h"
+
+#include <Core/File/DataFile.h>
+#include <Core/Exceptions/FileException.h>
+#include <Common/Util/FileUtil.h>
+#include <Common/Logger.h>
+#include <filesystem.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//
+// Handles the compacted copies of a PMMR's files.
+// A marker file is written before any of the live files are replaced, so a swap that's interrupted by a crash
+// is finished by Recover() on the next startup, and one that never started is discarded.
+//
+class CompactionFiles
+{
+public:
+	static fs::path GetCompactPath(const fs::path& path)
+	{
+		return fs::u8path(path.u8string() + ".compact");
+	}
+
+	static void Swap(const fs::path& directory, const std::vector<fs::path>& paths)
+	{
+		const fs::path markerPath = GetMarkerPath(directory);
+		std::ofstream marker(markerPath, std::ios::out | std::ios::binary | std::ios::trunc);
+		marker.close();
+		if (!FileUtil::SyncFile(markerPath))
+		{
+			throw FILE_EXCEPTION_F("Failed to sync {}", markerPath);
+		}
+
+		for (const fs::path& path : paths)
+		{
+			const fs::path compactPath = GetCompactPath(path);
+			if (FileUtil::Exists(compactPath))
+			{
+				FileUtil::RenameFile(compactPath, path);
+			}
+		}
+
+		FileUtil::RemoveFile(markerPath);
+	}
+
+	static void Recover(const fs::path& directory)
+	{
+		if (!FileUtil::Exists(directory))
+		{
+			return;
+		}
+
+		const bool finishSwap = FileUtil::Exists(GetMarkerPath(directory));
+
+		std::vector<fs::path> compactPaths;
+		for (const auto& entry : fs::directory_iterator(directory))
+		{
+			if (entry.path().extension() == ".compact")
+			{
+				compactPaths.push_back(entry.path());
+			}
+		}
+
+		for (const fs::path& compactPath : compactPaths)
+		{
+			if (finishSwap)
+			{
+				LOG_INFO_F("Finishing interrupted compaction of {}", compactPath);
+				FileUtil::RenameFile(compactPath, fs::path(compactPath).replace_extension());
+			}
+			else
+			{
+				FileUtil::RemoveFile(compactPath);
+			}
+		}
+
+		FileUtil::RemoveFile(GetMarkerPath(directory));
+	}
+
+private:
+	static fs::path GetMarkerPath(const fs::path& directory) { return directory / "pmmr_compact.commit"; }
+};
+
+//
+// Compacts a PruneableMMR by rewriting its hash and data files without the spent leaves below a cutoff,
+// along with the hashes that are no longer needed once those leaves are pruned.
+//
+// The expensive part happens in Write(), which only reads the parts of the files below the cutoff.
+// Those don't change unless the MMR is rewound past the cutoff, which the PruneableMMR checks for,
+// so Write() can run without holding the TxHashSet lock.
+// Stage() then copies everything from the cutoff onward while the lock is held.
+//
+template<size_t DATA_SIZE>
+class PMMRCompaction
+{
+	static constexpr uint64_t ENTRIES_PER_CHUNK = 16 * 1024;
+
+public:
+	using Ptr = std::shared_ptr<PMMRCompaction<DATA_SIZE>>;
+
+	PMMRCompaction(
+		const uint64_t cutoffSize,
+		const std::shared_ptr<HashFile>& pHashFile,
+		const std::shared_ptr<DataFile<DATA_SIZE>>& pDataFile,
+		const std::shared_ptr<LeafSet>& pLeafSet,
+		const std::shared_ptr<PruneList>& pPruneList)
+		: m_cutoffSize(cutoffSize),
+		m_hashCutoff(cutoffSize - pPruneList->GetShift(cutoffSize - 1)),
+		m_dataCutoff(MMRUtil::GetNumLeaves(cutoffSize - 1) - pPruneList->GetLeafShift(cutoffSize - 1)),
+		m_pHashFile(pHashFile),
+		m_pDataFile(pDataFile),
+		m_pLeafSet(pLeafSet),
+		m_pPruneList(pPruneList),
+		m_pruneList(*pPruneList),
+		m_reclaimedBytes(0)
+	{
+
+	}
+
+	~PMMRCompaction()
+	{
+		if (m_pNewHashFile != nullptr)
+		{
+			Abort();
+		}
+	}
+
+	uint64_t GetCutoffSize() const noexcept { return m_cutoffSize; }
+	uint64_t GetTotalBytes() const noexcept { return (m_hashCutoff * 32) + (m_dataCutoff * DATA_SIZE); }
+	uint64_t GetReclaimedBytes() const noexcept { return m_reclaimedBytes; }
+
+	//
+	// Prunes the spent leaves below the cutoff, and writes copies of the hash and data files up to the cutoff without them.
+	// Returns false if there was nothing to compact, or if terminate was set before it finished.
+	//
+	bool Write(const std::function<void(const uint64_t)>& onProgress, const std::atomic_bool& terminate)
+	{
+		const uint64_t numLeaves = MMRUtil::GetNumLeaves(m_cutoffSize - 1);
+		for (uint64_t leafIndex = 0; leafIndex < numLeaves; leafIndex++)
+		{
+			const uint64_t mmrIndex = MMRUtil::GetPMMRIndex(leafIndex);
+			if (!m_pLeafSet->Contains(leafIndex) && !m_pruneList.IsPruned(mmrIndex))
+			{
+				m_pruneList.Add(mmrIndex);
+				m_prunedLeaves.push_back(leafIndex);
+			}
+		}
+
+		if (m_prunedLeaves.empty() || terminate)
+		{
+			return false;
+		}
+
+		const Roaring removed = m_pruneList.GetCompacted() - m_pPruneList->GetCompacted();
+
+		FileUtil::RemoveFile(CompactionFiles::GetCompactPath(m_pHashFile->GetPath()));
+		FileUtil::RemoveFile(CompactionFiles::GetCompactPath(m_pDataFile->GetPath()));
+		m_pNewHashFile = HashFile::Load(CompactionFiles::GetCompactPath(m_pHashFile->GetPath()));
+		m_pNewDataFile = DataFile<DATA_SIZE>::Load(CompactionFiles::GetCompactPath(m_pDataFile->GetPath()));
+
+		// Positions that were already compacted aren't in the files, so they're skipped when mapping file entries to positions.
+		uint64_t mmrIndex = 0;
+		const bool hashesWritten = CopyEntries(*m_pHashFile, *m_pNewHashFile, m_hashCutoff, onProgress, terminate, [this, &removed, &mmrIndex] {
+			while (m_pPruneList->IsCompacted(mmrIndex))
+			{
+				++mmrIndex;
+			}
+
+			return !removed.contains((uint32_t)(mmrIndex++ + 1));
+		});
+
+		uint64_t leafIndex = 0;
+		const bool dataWritten = hashesWritten && CopyEntries(*m_pDataFile, *m_pNewDataFile, m_dataCutoff, onProgress, terminate, [this, &removed, &leafIndex] {
+			while (m_pPruneList->IsCompacted(MMRUtil::GetPMMRIndex(leafIndex)))
+			{
+				++leafIndex;
+			}
+
+			return !removed.contains((uint32_t)(MMRUtil::GetPMMRIndex(leafIndex++) + 1));
+		});
+
+		if (!dataWritten)
+		{
+			Abort();
+		}
+
+		return dataWritten;
+	}
+
+	//
+	// Copies everything written since the cutoff, and writes the new prune list, so the files are ready to be swapped in.
+	// Must be called while holding the TxHashSet write lock, with all changes flushed.
+	// Returns false if any of the pruned leaves were unspent by changes that were rolled back after Write() saw them.
+	//
+	bool Stage()
+	{
+		if (m_pNewHashFile == nullptr)
+		{
+			return false;
+		}
+
+		for (const uint64_t leafIndex : m_prunedLeaves)
+		{
+			if (m_pLeafSet->Contains(leafIndex))
+			{
+				LOG_WARNING_F("Leaf {} is unspent. Discarding compaction of {}.", leafIndex, m_pHashFile->GetPath());
+				Abort();
+				return false;
+			}
+		}
+
+		const std::atomic_bool terminate(false);
+		CopyEntries(*m_pHashFile, *m_pNewHashFile, m_hashCutoff, m_pHashFile->GetSize(), nullptr, terminate, [] { return true; });
+		CopyEntries(*m_pDataFile, *m_pNewDataFile, m_dataCutoff, m_pDataFile->GetSize(), nullptr, terminate, [] { return true; });
+
+		const fs::path prunePath = CompactionFiles::GetCompactPath(m_pPruneList->GetFilePath());
+		m_pruneList.WriteTo(prunePath);
+
+		for (const fs::path& path : { m_pNewHashFile->GetPath(), m_pNewDataFile->GetPath(), prunePath })
+		{
+			if (!FileUtil::SyncFile(path))
+			{
+				throw FILE_EXCEPTION_F("Failed to sync {}", path);
+			}
+		}
+
+		m_reclaimedBytes = ((m_pHashFile->GetSize() - m_pNewHashFile->GetSize()) * 32)
+			+ ((m_pDataFile->GetSize() - m_pNewDataFile->GetSize()) * DATA_SIZE);
+
+		// Close the new files, and release the old ones so they can be replaced.
+		Release();
+		return true;
+	}
+
+	void Abort()
+	{
+		std::vector<fs::path> paths;
+		if (m_pNewHashFile != nullptr)
+		{
+			paths.push_back(m_pNewHashFile->GetPath());
+			paths.push_back(m_pNewDataFile->GetPath());
+			paths.push_back(CompactionFiles::GetCompactPath(m_pPruneList->GetFilePath()));
+		}
+
+		Release();
+
+		for (const fs::path& path : paths)
+		{
+			FileUtil::RemoveFile(path);
+		}
+	}
+
+private:
+	void Release()
+	{
+		m_pNewHashFile.reset();
+		m_pNewDataFile.reset();
+		m_pHashFile.reset();
+		m_pDataFile.reset();
+		m_pLeafSet.reset();
+		m_pPruneList.reset();
+	}
+
+	template<size_t NUM_BYTES>
+	static bool CopyEntries(
+		const DataFile<NUM_BYTES>& source,
+		DataFile<NUM_BYTES>& destination,
+		const uint64_t numEntries,
+		const std::function<void(const uint64_t)>& onProgress,
+		const std::atomic_bool& terminate,
+		const std::function<bool()>& keepNext)
+	{
+		return CopyEntries(source, destination, 0, numEntries, onProgress, terminate, keepNext);
+	}
+
+	// Copies the source entries in [begin, end) that keepNext() returns true for, one chunk at a time.
+	template<size_t NUM_BYTES>
+	static bool CopyEntries(
+		const DataFile<NUM_BYTES>& source,
+		DataFile<NUM_BYTES>& destination,
+		const uint64_t begin,
+		const uint64_t end,
+		const std::function<void(const uint64_t)>& onProgress,
+		const std::atomic_bool& terminate,
+		const std::function<bool()>& keepNext)
+	{
+		for (uint64_t position = begin; position < end; position += ENTRIES_PER_CHUNK)
+		{
+			if (terminate)
+			{
+				return false;
+			}
+
+			const uint64_t numEntries = (std::min)(ENTRIES_PER_CHUNK, end - position);
+			const std::vector<unsigned char> chunk = source.GetDataRange(position, numEntries);
+
+			std::vector<unsigned char> kept;
+			kept.reserve(chunk.size());
+			for (uint64_t i = 0; i < numEntries; i++)
+			{
+				if (keepNext())
+				{
+					kept.insert(kept.end(), chunk.cbegin() + (i * NUM_BYTES), chunk.cbegin() + ((i + 1) * NUM_BYTES));
+				}
+			}
+
+			destination.AddData(kept);
+			destination.Commit();
+
+			if (onProgress)
+			{
+				onProgress(chunk.size());
+			}
+		}
+
+		return true;
+	}
+
+	uint64_t m_cutoffSize;
+	uint64_t m_hashCutoff;
+	uint64_t m_dataCutoff;
+
+	std::shared_ptr<HashFile> m_pHashFile;
+	std::shared_ptr<DataFile<DATA_SIZE>> m_pDataFile;
+	std::shared_ptr<LeafSet> m_pLeafSet;
+	std::shared_ptr<const PruneList> m_pPruneList;
+
+	// A copy of the prune list, with the newly pruned leaves added.
+	PruneList m_pruneList;
+	std::vector<uint64_t> m_prunedLeaves;
+
+	std::shared_ptr<HashFile> m_pNewHashFile;
+	std::shared_ptr<DataFile<DATA_SIZE>> m_pNewDataFile;
+	uint64_t m_reclaimedBytes;
+};
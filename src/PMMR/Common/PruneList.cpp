@@ -30,24 +30,33 @@ std::shared_ptr<PruneList> PruneList::Load(const fs::path& filePath)
 }
 
 void PruneList::Flush()
+{
+	if (WriteTo(m_filePath))
+	{
+		// Rebuild our "shift caches" here as we are flushing changes to disk
+		// and the contents of our prune_list has likely changed.
+		BuildPrunedCache();
+		BuildShiftCaches();
+	}
+}
+
+bool PruneList::WriteTo(const fs::path& filePath)
 {
 	// Run the optimization step on the bitmap.
 	m_prunedRoots.runOptimize();
 
 	// Write the updated bitmap file to disk.
 	const size_t size = m_prunedRoots.getSizeInBytes();
-	if (size > 0)
+	if (size == 0)
 	{
-		std::vector<unsigned char> buffer(size);
-		m_prunedRoots.write((char*)&buffer[0]);
+		return false;
+	}
 
-		FileUtil::SafeWriteToFile(m_filePath, buffer);
+	std::vector<unsigned char> buffer(size);
+	m_prunedRoots.write((char*)&buffer[0]);
 
-		// Rebuild our "shift caches" here as we are flushing changes to disk
-		// and the contents of our prune_list has likely changed.
-		BuildPrunedCache();
-		BuildShiftCaches();
-	}
+	FileUtil::SafeWriteToFile(filePath, buffer);
+	return true;
 }
 
 // Push the node at the provided position in the prune list.
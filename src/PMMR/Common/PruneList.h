@@ -15,6 +15,12 @@ public:
 
 	void Flush();
 
+	// Writes the pruned roots to the given path, leaving the prune list's own file untouched.
+	// Returns false if there's nothing to write.
+	bool WriteTo(const fs::path& filePath);
+
+	const fs::path& GetFilePath() const noexcept { return m_filePath; }
+
 	// Adds the node to the prune list.
 	// Compacts if pruning the node means a parent can get pruned as well.
 	void Add(const uint64_t mmrIndex);
@@ -27,6 +33,10 @@ public:
 
 	bool IsCompacted(const uint64_t mmrIndex) const;
 
+	// Returns every position that's pruned, but not the root of a pruned subtree.
+	// These are the positions that are removed from the hash file.
+	Roaring GetCompacted() const { return m_prunedCache - m_prunedRoots; }
+
 	uint64_t GetTotalShift() const;
 	uint64_t GetShift(const uint64_t mmrIndex) const;
 	uint64_t GetLeafShift(const uint64_t mmrIndex) const;
@@ -4,6 +4,7 @@
 #include "HashFile.h"
 #include "LeafSet.h"
 #include "PruneList.h"
+#include "PMMRCompaction.h"
 
 #include "MMRUtil.h"
 #include "MMRHashUtil.h"
@@ -28,7 +29,8 @@ public:
 		: m_pHashFile(pHashFile),
 		m_pLeafSet(pLeafSet),
 		m_pPruneList(pPruneList),
-		m_pDataFile(pDataFile)
+		m_pDataFile(pDataFile),
+		m_compactionCutoff(0)
 	{
 
 	}
@@ -78,6 +80,12 @@ public:
 	{
 		SetDirty(true);
 
+		// Rewinding below the cutoff invalidates any compaction in progress.
+		if (size < m_compactionCutoff)
+		{
+			m_compactionCutoff = 0;
+		}
+
 		m_pHashFile->Rewind(size - m_pPruneList->GetShift(size - 1));
 		m_pDataFile->Rewind(MMRUtil::GetNumLeaves(size - 1) - m_pPruneList->GetLeafShift(size - 1));
 		m_pLeafSet->Rewind(MMRUtil::GetNumLeaves(size - 1), leavesToAdd);
@@ -167,6 +175,35 @@ public:
 		}
 	}
 
+	//
+	// Commits all working changes to memory and the log batch, without writing them to disk.
+	//
+	void Commit(std::vector<WriteAheadLog::Entry>& entries)
+	{
+		if (IsDirty())
+		{
+			LOG_TRACE_F("Committing with size ({})", GetSize());
+			m_pHashFile->Commit(entries);
+			m_pDataFile->Commit(entries);
+			m_pLeafSet->Commit(entries);
+			SetDirty(false);
+		}
+	}
+
+	void BeginFlush()
+	{
+		m_pHashFile->BeginFlush();
+		m_pDataFile->BeginFlush();
+		m_pLeafSet->BeginFlush();
+	}
+
+	void EndFlush(const bool sync)
+	{
+		m_pHashFile->EndFlush(sync);
+		m_pDataFile->EndFlush(sync);
+		m_pLeafSet->EndFlush(sync);
+	}
+
 	void Rollback() noexcept final
 	{
 		if (IsDirty())
@@ -179,9 +216,67 @@ public:
 		}
 	}
 
+	//
+	// Starts compacting everything before the given MMR size. See PMMRCompaction for details.
+	// Must be called while holding the TxHashSet write lock.
+	//
+	typename PMMRCompaction<DATA_SIZE>::Ptr PrepareCompaction(const uint64_t cutoffSize)
+	{
+		if (cutoffSize == 0 || cutoffSize > GetSize())
+		{
+			return nullptr;
+		}
+
+		m_compactionCutoff = cutoffSize;
+		return std::make_shared<PMMRCompaction<DATA_SIZE>>(cutoffSize, m_pHashFile, m_pDataFile, m_pLeafSet, m_pPruneList);
+	}
+
+	//
+	// Swaps in the files written by the compaction, and reloads them along with the updated prune list.
+	// Must be called while holding the TxHashSet write lock, with all changes flushed.
+	// Returns the number of bytes reclaimed, or 0 if the MMR was rewound below the cutoff since PrepareCompaction().
+	//
+	uint64_t FinishCompaction(PMMRCompaction<DATA_SIZE>& compaction)
+	{
+		const bool rewound = compaction.GetCutoffSize() != m_compactionCutoff;
+		m_compactionCutoff = 0;
+
+		if (rewound)
+		{
+			LOG_INFO_F("Discarding compaction of {}, since it was rewound", m_pHashFile->GetPath());
+			compaction.Abort();
+			return 0;
+		}
+
+		if (!compaction.Stage())
+		{
+			return 0;
+		}
+
+		const fs::path hashPath = m_pHashFile->GetPath();
+		const fs::path dataPath = m_pDataFile->GetPath();
+		const fs::path prunePath = m_pPruneList->GetFilePath();
+
+		// The files must be closed before they can be replaced on Windows.
+		m_pHashFile.reset();
+		m_pDataFile.reset();
+		m_pPruneList.reset();
+
+		CompactionFiles::Swap(hashPath.parent_path(), { hashPath, dataPath, prunePath });
+
+		m_pHashFile = HashFile::Load(hashPath);
+		m_pDataFile = DataFile<DATA_SIZE>::Load(dataPath);
+		m_pPruneList = PruneList::Load(prunePath);
+
+		return compaction.GetReclaimedBytes();
+	}
+
 private:
 	std::shared_ptr<HashFile> m_pHashFile;
 	std::shared_ptr<LeafSet> m_pLeafSet;
 	std::shared_ptr<PruneList> m_pPruneList;
 	std::shared_ptr<DataFile<DATA_SIZE>> m_pDataFile;
+
+	// The cutoff of the compaction in progress, or 0 if there isn't one.
+	uint64_t m_compactionCutoff;
 };
\ No newline at end of file
@@ -69,6 +69,24 @@ void KernelMMR::Commit()
 	m_pDataFile->Commit();
 }
 
+void KernelMMR::Commit(std::vector<WriteAheadLog::Entry>& entries)
+{
+	m_pHashFile->Commit(entries);
+	m_pDataFile->Commit(entries);
+}
+
+void KernelMMR::BeginFlush()
+{
+	m_pHashFile->BeginFlush();
+	m_pDataFile->BeginFlush();
+}
+
+void KernelMMR::EndFlush(const bool sync)
+{
+	m_pHashFile->EndFlush(sync);
+	m_pDataFile->EndFlush(sync);
+}
+
 void KernelMMR::Rollback() noexcept
 {
 	m_pHashFile->Rollback();
@@ -28,6 +28,9 @@ public:
 	std::vector<Hash> GetLastLeafHashes(const uint64_t numHashes) const final;
 
 	void Commit() final;
+	void Commit(std::vector<WriteAheadLog::Entry>& entries);
+	void BeginFlush();
+	void EndFlush(const bool sync);
 	void Rollback() noexcept final;
 
 	void ApplyKernel(const TransactionKernel& kernel);
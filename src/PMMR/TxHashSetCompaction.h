@@ -0,0 +1,46 @@
+#pragma once
+
+#include "OutputPMMR.h"
+#include "RangeProofPMMR.h"
+
+#include <PMMR/TxHashSet.h>
+
+class TxHashSetCompaction : public ITxHashSetCompaction
+{
+public:
+	TxHashSetCompaction(
+		const ITxHashSet* pTxHashSet,
+		const uint64_t horizonHeight,
+		PMMRCompaction<OUTPUT_SIZE>::Ptr pOutputCompaction,
+		PMMRCompaction<RANGE_PROOF_SIZE>::Ptr pRangeProofCompaction)
+		: m_pTxHashSet(pTxHashSet),
+		m_horizonHeight(horizonHeight),
+		m_pOutputCompaction(pOutputCompaction),
+		m_pRangeProofCompaction(pRangeProofCompaction) { }
+
+	virtual ~TxHashSetCompaction() = default;
+
+	uint64_t GetTotalBytes() const noexcept final
+	{
+		return m_pOutputCompaction->GetTotalBytes() + m_pRangeProofCompaction->GetTotalBytes();
+	}
+
+	bool Write(const std::function<void(const uint64_t)>& onProgress, const std::atomic_bool& terminate) final
+	{
+		const bool outputWritten = m_pOutputCompaction->Write(onProgress, terminate);
+		const bool rangeProofWritten = m_pRangeProofCompaction->Write(onProgress, terminate);
+
+		return (outputWritten || rangeProofWritten) && !terminate;
+	}
+
+	const ITxHashSet* GetTxHashSet() const noexcept { return m_pTxHashSet; }
+	uint64_t GetHorizonHeight() const noexcept { return m_horizonHeight; }
+	PMMRCompaction<OUTPUT_SIZE>& GetOutputCompaction() { return *m_pOutputCompaction; }
+	PMMRCompaction<RANGE_PROOF_SIZE>& GetRangeProofCompaction() { return *m_pRangeProofCompaction; }
+
+private:
+	const ITxHashSet* m_pTxHashSet;
+	uint64_t m_horizonHeight;
+	PMMRCompaction<OUTPUT_SIZE>::Ptr m_pOutputCompaction;
+	PMMRCompaction<RANGE_PROOF_SIZE>::Ptr m_pRangeProofCompaction;
+};
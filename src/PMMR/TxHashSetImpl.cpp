@@ -4,9 +4,12 @@
 #include "Common/MMRHashUtil.h"
 
 #include <Common/Util/ThreadUtil.h>
+#include <Common/ThreadManager.h>
 #include <Common/Util/HexUtil.h>
 #include <Common/Util/FileUtil.h>
 #include <Common/Util/StringUtil.h>
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
 #include <BlockChain/BlockChain.h>
 #include <Database/BlockDb.h>
 #include <Common/Logger.h>
@@ -18,56 +21,92 @@ TxHashSet::TxHashSet(
 	std::shared_ptr<KernelMMR> pKernelMMR,
 	std::shared_ptr<OutputPMMR> pOutputPMMR,
 	std::shared_ptr<RangeProofPMMR> pRangeProofPMMR,
-	BlockHeaderPtr pBlockHeader)
+	BlockHeaderPtr pBlockHeader,
+	WriteAheadLog::Ptr pWAL)
 	: m_config(config),
 	m_pKernelMMR(pKernelMMR),
 	m_pOutputPMMR(pOutputPMMR),
 	m_pRangeProofPMMR(pRangeProofPMMR),
 	m_pBlockHeader(pBlockHeader),
-	m_pBlockHeaderBackup(pBlockHeader)
+	m_pBlockHeaderBackup(pBlockHeader),
+	m_pWAL(pWAL),
+	m_flushInProgress(false),
+	m_terminate(false)
 {
+	if (m_pWAL != nullptr)
+	{
+		m_flushThread = std::thread(Thread_Flush, std::ref(*this));
+	}
+}
+
+TxHashSet::~TxHashSet()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_commitMutex);
+		m_terminate = true;
+	}
 
+	m_flushCondition.notify_all();
+	ThreadUtil::Join(m_flushThread);
 }
 
 bool TxHashSet::IsValid(std::shared_ptr<const IBlockDB> pBlockDB, const Transaction& transaction) const
 {
-	// Validate inputs
-	const uint64_t maximumBlockHeight = Consensus::GetMaxCoinbaseHeight(
-		m_config.GetEnvironment().GetType(),
-		m_pBlockHeader->GetHeight() + 1 // Add one since this is used by TransactionPool
-	);
 	for (const TransactionInput& input : transaction.GetInputs())
 	{
-		const Commitment& commitment = input.GetCommitment();
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(commitment);
-		if (pOutputPosition == nullptr) {
+		if (!IsUnspent(pBlockDB, input))
+		{
 			return false;
 		}
+	}
 
-		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
-		if (pOutput == nullptr || pOutput->GetCommitment() != commitment || pOutput->GetFeatures() != input.GetFeatures()) {
-			LOG_DEBUG_F("Output ({}) not found at mmrIndex ({})",  commitment, pOutputPosition->GetMMRIndex());
+	for (const TransactionOutput& output : transaction.GetOutputs())
+	{
+		if (!IsUnique(pBlockDB, output))
+		{
 			return false;
 		}
+	}
 
-		if (input.IsCoinbase()) {
-			if (pOutputPosition->GetBlockHeight() > maximumBlockHeight) {
-				LOG_INFO_F("Coinbase {} not mature", input.GetCommitment());
-				return false;
-			}
+	return true;
+}
+
+bool TxHashSet::IsUnspent(std::shared_ptr<const IBlockDB> pBlockDB, const TransactionInput& input) const
+{
+	const Commitment& commitment = input.GetCommitment();
+	std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(commitment);
+	if (pOutputPosition == nullptr) {
+		return false;
+	}
+
+	std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
+	if (pOutput == nullptr || pOutput->GetCommitment() != commitment || pOutput->GetFeatures() != input.GetFeatures()) {
+		LOG_DEBUG_F("Output ({}) not found at mmrIndex ({})",  commitment, pOutputPosition->GetMMRIndex());
+		return false;
+	}
+
+	if (input.IsCoinbase()) {
+		const uint64_t maximumBlockHeight = Consensus::GetMaxCoinbaseHeight(
+			m_config.GetEnvironment().GetType(),
+			m_pBlockHeader->GetHeight() + 1 // Add one since this is used by TransactionPool
+		);
+		if (pOutputPosition->GetBlockHeight() > maximumBlockHeight) {
+			LOG_INFO_F("Coinbase {} not mature", input.GetCommitment());
+			return false;
 		}
 	}
 
-	// Validate outputs
-	for (const TransactionOutput& output : transaction.GetOutputs())
-	{
-		std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(output.GetCommitment());
-		if (pOutputPosition != nullptr) {
-			std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
-			if (pOutput != nullptr && pOutput->GetCommitment() == output.GetCommitment())
-			{
-				return false;
-			}
+	return true;
+}
+
+bool TxHashSet::IsUnique(std::shared_ptr<const IBlockDB> pBlockDB, const TransactionOutput& output) const
+{
+	std::unique_ptr<OutputLocation> pOutputPosition = pBlockDB->GetOutputPosition(output.GetCommitment());
+	if (pOutputPosition != nullptr) {
+		std::unique_ptr<OutputIdentifier> pOutput = m_pOutputPMMR->GetAt(pOutputPosition->GetMMRIndex());
+		if (pOutput != nullptr && pOutput->GetCommitment() == output.GetCommitment())
+		{
+			return false;
 		}
 	}
 
@@ -381,15 +420,120 @@ void TxHashSet::Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& he
 
 void TxHashSet::Commit()
 {
-	std::vector<std::thread> threads;
-	threads.emplace_back(std::thread([this] { this->m_pKernelMMR->Commit(); }));
-	threads.emplace_back(std::thread([this] { this->m_pOutputPMMR->Commit(); }));
-	threads.emplace_back(std::thread([this] { this->m_pRangeProofPMMR->Commit(); }));
-	ThreadUtil::JoinAll(threads);
+	if (m_pWAL == nullptr)
+	{
+		std::vector<std::thread> threads;
+		threads.emplace_back(std::thread([this] { this->m_pKernelMMR->Commit(); }));
+		threads.emplace_back(std::thread([this] { this->m_pOutputPMMR->Commit(); }));
+		threads.emplace_back(std::thread([this] { this->m_pRangeProofPMMR->Commit(); }));
+		ThreadUtil::JoinAll(threads);
+	}
+	else
+	{
+		std::unique_lock<std::mutex> lock(m_commitMutex);
+
+		std::vector<WriteAheadLog::Entry> entries;
+		m_pKernelMMR->Commit(entries);
+		m_pOutputPMMR->Commit(entries);
+		m_pRangeProofPMMR->Commit(entries);
+
+		if (!entries.empty())
+		{
+			m_pWAL->Append(entries);
+		}
+
+		if (m_pWAL->GetActiveSize() >= WAL_FLUSH_THRESHOLD)
+		{
+			m_flushCondition.notify_one();
+		}
+	}
 
 	m_pBlockHeaderBackup = m_pBlockHeader;
 }
 
+void TxHashSet::Flush()
+{
+	if (m_pWAL == nullptr)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> flushLock(m_flushMutex);
+	FlushChanges();
+}
+
+void TxHashSet::FlushAndCopy(const fs::path& destination)
+{
+	std::unique_lock<std::mutex> flushLock(m_flushMutex);
+	if (m_pWAL != nullptr)
+	{
+		FlushChanges();
+	}
+
+	FileUtil::CopyDirectory(m_config.GetNodeConfig().GetTxHashSetPath(), destination);
+}
+
+// Writes every committed change to the PMMR files. Requires m_flushMutex.
+void TxHashSet::FlushChanges()
+{
+	// If the previous attempt failed, its changes are still sealed and being flushed, so just retry writing them.
+	if (!m_flushInProgress)
+	{
+		std::unique_lock<std::mutex> commitLock(m_commitMutex);
+		if (m_pWAL->GetActiveSize() == 0)
+		{
+			return;
+		}
+
+		// Sealing the log and snapshotting the committed changes must happen atomically,
+		// so that the sealed segment contains exactly the changes being flushed.
+		m_pWAL->Rotate();
+		m_pKernelMMR->BeginFlush();
+		m_pOutputPMMR->BeginFlush();
+		m_pRangeProofPMMR->BeginFlush();
+		m_flushInProgress = true;
+	}
+
+	m_pKernelMMR->EndFlush(true);
+	m_pOutputPMMR->EndFlush(true);
+	m_pRangeProofPMMR->EndFlush(true);
+
+	m_pWAL->RemoveSealed();
+	m_flushInProgress = false;
+}
+
+void TxHashSet::Thread_Flush(TxHashSet& txHashSet)
+{
+	ThreadManagerAPI::SetCurrentThreadName("TXHASHSET_FLUSH");
+	LOG_TRACE("BEGIN");
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(txHashSet.m_commitMutex);
+			txHashSet.m_flushCondition.wait_for(lock, WAL_FLUSH_INTERVAL, [&txHashSet] {
+				return txHashSet.m_terminate || txHashSet.m_pWAL->GetActiveSize() >= WAL_FLUSH_THRESHOLD;
+			});
+		}
+
+		try
+		{
+			txHashSet.Flush();
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Failed to flush TxHashSet: {}", e.what());
+		}
+
+		if (txHashSet.m_terminate)
+		{
+			break;
+		}
+	}
+
+	LOG_TRACE("END");
+}
+
 void TxHashSet::Rollback() noexcept
 {
 	m_pKernelMMR->Rollback();
@@ -398,7 +542,56 @@ void TxHashSet::Rollback() noexcept
 	m_pBlockHeader = m_pBlockHeaderBackup;
 }
 
-void TxHashSet::Compact()
+ITxHashSetCompaction::Ptr TxHashSet::PrepareCompaction(const BlockHeader& horizonHeader)
 {
-	// TODO: Implement
-}
\ No newline at end of file
+	// The output and rangeproof PMMRs always have the same size.
+	auto pOutputCompaction = m_pOutputPMMR->PrepareCompaction(horizonHeader.GetOutputMMRSize());
+	auto pRangeProofCompaction = m_pRangeProofPMMR->PrepareCompaction(horizonHeader.GetOutputMMRSize());
+	if (pOutputCompaction == nullptr || pRangeProofCompaction == nullptr)
+	{
+		return nullptr;
+	}
+
+	return std::make_shared<TxHashSetCompaction>(this, horizonHeader.GetHeight(), pOutputCompaction, pRangeProofCompaction);
+}
+
+uint64_t TxHashSet::FinishCompaction(const ITxHashSetCompaction::Ptr& pCompaction)
+{
+	auto pTxHashSetCompaction = std::dynamic_pointer_cast<TxHashSetCompaction>(pCompaction);
+	if (pTxHashSetCompaction == nullptr || pTxHashSetCompaction->GetTxHashSet() != this)
+	{
+		throw TXHASHSET_EXCEPTION("Compaction was not prepared by this TxHashSet");
+	}
+
+	// The files are about to be replaced, so the flusher can't be allowed to write to them,
+	// and any changes still in the write-ahead log must be written to the old files first.
+	std::unique_lock<std::mutex> flushLock(m_flushMutex);
+	if (m_pWAL != nullptr)
+	{
+		FlushChanges();
+	}
+
+	uint64_t reclaimedBytes = m_pOutputPMMR->FinishCompaction(pTxHashSetCompaction->GetOutputCompaction());
+	reclaimedBytes += m_pRangeProofPMMR->FinishCompaction(pTxHashSetCompaction->GetRangeProofCompaction());
+
+	if (reclaimedBytes > 0)
+	{
+		Serializer serializer;
+		serializer.Append<uint64_t>(pTxHashSetCompaction->GetHorizonHeight());
+		FileUtil::SafeWriteToFile(GetCompactedHeightPath(m_config.GetNodeConfig().GetTxHashSetPath()), serializer.GetBytes());
+	}
+
+	return reclaimedBytes;
+}
+
+uint64_t TxHashSet::GetCompactedHeight() const
+{
+	std::vector<uint8_t> bytes;
+	if (!FileUtil::ReadFile(GetCompactedHeightPath(m_config.GetNodeConfig().GetTxHashSetPath()), bytes) || bytes.size() != 8)
+	{
+		return 0;
+	}
+
+	ByteBuffer byteBuffer(std::move(bytes));
+	return byteBuffer.ReadU64();
+}
@@ -3,10 +3,17 @@
 #include "KernelMMR.h"
 #include "OutputPMMR.h"
 #include "RangeProofPMMR.h"
+#include "TxHashSetCompaction.h"
 
 #include <PMMR/TxHashSet.h>
 #include <Config/Config.h>
+#include <Core/File/WriteAheadLog.h>
+#include <condition_variable>
 #include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
 #include <string>
 
 class TxHashSet : public ITxHashSet
@@ -17,13 +24,16 @@ public:
 		std::shared_ptr<KernelMMR> pKernelMMR,
 		std::shared_ptr<OutputPMMR> pOutputPMMR,
 		std::shared_ptr<RangeProofPMMR> pRangeProofPMMR,
-		BlockHeaderPtr pBlockHeader
+		BlockHeaderPtr pBlockHeader,
+		WriteAheadLog::Ptr pWAL
 	);
-	virtual ~TxHashSet() = default;
+	virtual ~TxHashSet();
 
 	BlockHeaderPtr GetFlushedBlockHeader() const noexcept final { return m_pBlockHeaderBackup; }
 
 	bool IsValid(std::shared_ptr<const IBlockDB> pBlockDB, const Transaction& transaction) const final;
+	bool IsUnspent(std::shared_ptr<const IBlockDB> pBlockDB, const TransactionInput& input) const final;
+	bool IsUnique(std::shared_ptr<const IBlockDB> pBlockDB, const TransactionOutput& output) const final;
 	std::unique_ptr<BlockSums> ValidateTxHashSet(const BlockHeader& header, const IBlockChain& blockChain, SyncStatus& syncStatus) final;
 	bool ApplyBlock(std::shared_ptr<IBlockDB> pBlockDB, const FullBlock& block) final;
 	bool ValidateRoots(const BlockHeader& blockHeader) const final;
@@ -38,8 +48,17 @@ public:
 
 	void Rewind(std::shared_ptr<IBlockDB> pBlockDB, const BlockHeader& header) final;
 	void Commit() final;
+	void Flush() final;
+	void FlushAndCopy(const fs::path& destination) final;
 	void Rollback() noexcept final;
-	void Compact() final;
+	ITxHashSetCompaction::Ptr PrepareCompaction(const BlockHeader& horizonHeader) final;
+	uint64_t FinishCompaction(const ITxHashSetCompaction::Ptr& pCompaction) final;
+	uint64_t GetCompactedHeight() const final;
+
+	//
+	// The file the compacted height is saved in. It's kept outside of the PMMR folders, so it's never included in snapshots.
+	//
+	static fs::path GetCompactedHeightPath(const fs::path& txHashSetPath) { return txHashSetPath / "pmmr_compacted.bin"; }
 
 	std::shared_ptr<KernelMMR> GetKernelMMR() { return m_pKernelMMR; }
 	std::shared_ptr<OutputPMMR> GetOutputPMMR() { return m_pOutputPMMR; }
@@ -53,4 +72,20 @@ private:
 
 	BlockHeaderPtr m_pBlockHeader;
 	BlockHeaderPtr m_pBlockHeaderBackup;
+
+	// When a write-ahead log is provided, Commit() only appends to it,
+	// and the PMMR files are written by the flusher thread once the log grows beyond
+	// WAL_FLUSH_THRESHOLD bytes, or once WAL_FLUSH_INTERVAL has passed, whichever comes first.
+	static const uint64_t WAL_FLUSH_THRESHOLD = 64 * 1024 * 1024;
+	static constexpr std::chrono::seconds WAL_FLUSH_INTERVAL = std::chrono::seconds(30);
+
+	static void Thread_Flush(TxHashSet& txHashSet);
+	void FlushChanges();
+	WriteAheadLog::Ptr m_pWAL;
+	std::mutex m_commitMutex;
+	std::mutex m_flushMutex;
+	std::condition_variable m_flushCondition;
+	bool m_flushInProgress;
+	std::atomic_bool m_terminate;
+	std::thread m_flushThread;
 };
@@ -21,11 +21,18 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::Open(BlockHeaderPtr pConfirmedTip,
 {
 	Close();
 
+	// Finishes or discards any compaction that was interrupted by the last shutdown.
+	CompactionFiles::Recover(m_config.GetNodeConfig().GetTxHashSetPath() / "output");
+	CompactionFiles::Recover(m_config.GetNodeConfig().GetTxHashSetPath() / "rangeproof");
+
+	// Replays any changes that were committed, but not yet written to the PMMR files, before the last shutdown.
+	WriteAheadLog::Ptr pWAL = WriteAheadLog::Open(m_config.GetNodeConfig().GetTxHashSetPath());
+
 	std::shared_ptr<KernelMMR> pKernelMMR = KernelMMR::Load(m_config.GetNodeConfig().GetTxHashSetPath(), genesisBlock);
 	std::shared_ptr<OutputPMMR> pOutputPMMR = OutputPMMR::Load(m_config.GetNodeConfig().GetTxHashSetPath(), genesisBlock);
 	std::shared_ptr<RangeProofPMMR> pRangeProofPMMR = RangeProofPMMR::Load(m_config.GetNodeConfig().GetTxHashSetPath(), genesisBlock);
 
-	m_pTxHashSet = std::shared_ptr<TxHashSet>(new TxHashSet(m_config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pConfirmedTip));
+	m_pTxHashSet = std::shared_ptr<TxHashSet>(new TxHashSet(m_config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pConfirmedTip, pWAL));
 
 	return m_pTxHashSet;
 }
@@ -40,6 +47,10 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config,
 
 	try
 	{
+		// Any logged changes, and the compacted height, belong to the TxHashSet being replaced.
+		WriteAheadLog::Discard(txHashSetPath);
+		FileUtil::RemoveFile(TxHashSet::GetCompactedHeightPath(txHashSetPath));
+
 		if (zip.Extract(zipFilePath, *pHeader))
 		{
 			LOG_INFO_F("{} extracted successfully", zipFilePath);
@@ -80,7 +91,8 @@ std::shared_ptr<ITxHashSet> TxHashSetManager::LoadFromZip(const Config& config,
 			pRangeProofPMMR->Rewind(pHeader->GetOutputMMRSize(), {});
 			pRangeProofPMMR->Commit();
 
-			return std::shared_ptr<TxHashSet>(new TxHashSet(config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pHeader));
+			WriteAheadLog::Ptr pWAL = WriteAheadLog::Open(txHashSetPath);
+			return std::shared_ptr<TxHashSet>(new TxHashSet(config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pHeader, pWAL));
 		}
 	}
 	catch (std::exception& e)
@@ -109,8 +121,12 @@ fs::path TxHashSetManager::SaveSnapshot(std::shared_ptr<IBlockDB> pBlockDB, Bloc
 		BlockHeaderPtr pFlushedHeader = nullptr;
 
 		{
+			// Write out committed changes first, so the copy doesn't depend on the write-ahead log.
 			// Copy to Snapshots/Hash // TODO: If already exists, just use that.
-			FileUtil::CopyDirectory(m_config.GetNodeConfig().GetTxHashSetPath(), snapshotDir);
+			m_pTxHashSet->FlushAndCopy(snapshotDir);
+			WriteAheadLog::Recover(snapshotDir);
+			CompactionFiles::Recover(snapshotDir / "output");
+			CompactionFiles::Recover(snapshotDir / "rangeproof");
 
 			pFlushedHeader = m_pTxHashSet->GetFlushedBlockHeader();
 		}
@@ -122,7 +138,7 @@ fs::path TxHashSetManager::SaveSnapshot(std::shared_ptr<IBlockDB> pBlockDB, Bloc
 			auto pKernelMMR = KernelMMR::Load(snapshotDir, genesisBlock);
 			auto pOutputPMMR = OutputPMMR::Load(snapshotDir, genesisBlock);
 			auto pRangeProofPMMR = RangeProofPMMR::Load(snapshotDir, genesisBlock);
-			TxHashSet snapshotTxHashSet(m_config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pFlushedHeader);
+			TxHashSet snapshotTxHashSet(m_config, pKernelMMR, pOutputPMMR, pRangeProofPMMR, pFlushedHeader, nullptr);
 
 			// Rewind Snapshot TxHashSet
 			snapshotTxHashSet.Rewind(pBlockDB, *pHeader);
@@ -237,8 +237,8 @@ BlockSums TxHashSetValidator::ValidateKernelSums(TxHashSet& txHashSet, const Blo
 
 	return KernelSumValidator::ValidateKernelSums(
 		std::vector<Commitment>(),
-		outputCommitments,
-		excessCommitments,
+		std::move(outputCommitments),
+		std::move(excessCommitments),
 		overage,
 		blockHeader.GetTotalKernelOffset(),
 		std::nullopt
@@ -27,19 +27,20 @@ static const char* errstr[] = { "OK", "wrong header length", "edge too big", "ed
 #define EDGE_BLOCK_SIZE (1 << EDGE_BLOCK_BITS)
 #define EDGE_BLOCK_MASK (EDGE_BLOCK_SIZE - 1)
 
-// fills buffer with EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
-// return siphash output for given edge
-template <int rotE = 21>
-static u64 sipblock(siphash_keys& keys, const word_t edge, u64* buf)
+// fills nonces with the first siphash nonce of the block containing each edge in cuckaroo graph
+// the siphash state carries over between the EDGE_BLOCK_SIZE nonces of a block, so each block is hashed as a single lane
+inline void sipblock_nonces(const word_t edges[PROOFSIZE], u64* nonces)
 {
-    siphash_state<rotE> shs(keys);
-    word_t edge0 = edge & ~EDGE_BLOCK_MASK;
-    for (u32 i = 0; i < EDGE_BLOCK_SIZE; i++)
+    for (u32 n = 0; n < PROOFSIZE; n++)
     {
-        shs.hash24(edge0 + i);
-        buf[i] = shs.xor_lanes();
+        nonces[n] = edges[n] & ~EDGE_BLOCK_MASK;
     }
+}
 
+// buf holds the EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
+// return siphash output for given edge
+inline u64 sipblock(u64* buf, const word_t edge)
+{
     const u64 last = buf[EDGE_BLOCK_MASK];
     for (u32 i = 0; i < EDGE_BLOCK_MASK; i++)
     {
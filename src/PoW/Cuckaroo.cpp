@@ -1,13 +1,11 @@
 #include "Cuckaroo.h"
 #include "Common.h"
 
-#include <Crypto/Hasher.h>
-
 // verify that edges are ascending and form a cycle in header-generated graph
-int verify_cuckaroo(const uint64_t edges[PROOFSIZE], siphash_keys& keys, const uint8_t edgeBits)
+// sips holds the siphash outputs for the block containing each edge, in the order given by Cuckaroo::GetSipNonces
+int verify_cuckaroo(const uint64_t edges[PROOFSIZE], u64* sips, const uint8_t edgeBits)
 {
     uint64_t xor0 = 0, xor1 = 0;
-    uint64_t sips[EDGE_BLOCK_SIZE];
     uint64_t uvs[2 * PROOFSIZE];
 
     // number of edges
@@ -26,7 +24,7 @@ int verify_cuckaroo(const uint64_t edges[PROOFSIZE], siphash_keys& keys, const u
             return POW_TOO_SMALL;
         }
 
-        uint64_t edge = sipblock(keys, edges[n], sips);
+        uint64_t edge = sipblock(sips + n * EDGE_BLOCK_SIZE, edges[n]);
         xor0 ^= uvs[2 * n] = edge & edgeMask;
         xor1 ^= uvs[2 * n + 1] = (edge >> 32) & edgeMask;
     }
@@ -63,17 +61,14 @@ int verify_cuckaroo(const uint64_t edges[PROOFSIZE], siphash_keys& keys, const u
     return n == PROOFSIZE ? POW_OK : POW_SHORT_CYCLE;
 }
 
-bool Cuckaroo::Validate(const BlockHeader& blockHeader)
+void Cuckaroo::GetSipNonces(const ProofOfWork& proofOfWork, uint64_t* pNonces)
 {
-	const ProofOfWork& proofOfWork = blockHeader.GetProofOfWork();
-	const std::vector<uint64_t> proofNonces = proofOfWork.GetProofNonces();
-	if (proofNonces.size() != PROOFSIZE) {
-		return false;
-	}
+	sipblock_nonces(proofOfWork.GetProofNonces().data(), pNonces);
+}
 
-    Hash prePoWHash = Hasher::Blake2b(blockHeader.GetPreProofOfWork());
-    siphash_keys keys((const char*)prePoWHash.data());
-	const int result = verify_cuckaroo(proofNonces.data(), keys, proofOfWork.GetEdgeBits());
+bool Cuckaroo::Verify(const ProofOfWork& proofOfWork, uint64_t* pSips)
+{
+	const int result = verify_cuckaroo(proofOfWork.GetProofNonces().data(), pSips, proofOfWork.GetEdgeBits());
 	if (result != POW_OK) {
 		LOG_ERROR_F("Failed with result: {}", errstr[result]);
 	}
@@ -1,8 +1,6 @@
 #include "Cuckarood.h"
 #include "Common.h"
 
-#include <Crypto/Hasher.h>
-
 // the main parameter is the number of bits in an edge index,
 // i.e. the 2-log of the number of edges
 #define EDGEBITS 29
@@ -15,10 +13,10 @@
 #define NODE1MASK ((word_t)NNODES1 - 1)
 
 // verify that edges are ascending and form a cycle in header-generated graph
-int verify_cuckarood(const word_t edges[PROOFSIZE], siphash_keys& keys)
+// sips holds the siphash outputs for the block containing each edge, in the order given by Cuckarood::GetSipNonces
+int verify_cuckarood(const word_t edges[PROOFSIZE], u64* sips)
 {
     word_t xor0 = 0, xor1 = 0;
-    u64 sips[EDGE_BLOCK_SIZE];
     word_t uvs[2 * PROOFSIZE];
     u32 ndir[2] = { 0, 0 };
 
@@ -30,7 +28,7 @@ int verify_cuckarood(const word_t edges[PROOFSIZE], siphash_keys& keys)
             return POW_TOO_BIG;
         if (n && edges[n] <= edges[n - 1])
             return POW_TOO_SMALL;
-        u64 edge = sipblock<25>(keys, edges[n], sips);
+        u64 edge = sipblock(sips + n * EDGE_BLOCK_SIZE, edges[n]);
         xor0 ^= uvs[4 * ndir[dir] + 2 * dir] = edge & NODE1MASK;
         // printf("%2d %8x\t", 4 * ndir[dir] + 2 * dir , edge        & NODE1MASK);
         xor1 ^= uvs[4 * ndir[dir] + 2 * dir + 1] = (edge >> 32) & NODE1MASK;
@@ -55,18 +53,14 @@ int verify_cuckarood(const word_t edges[PROOFSIZE], siphash_keys& keys)
     return n == PROOFSIZE ? POW_OK : POW_SHORT_CYCLE;
 }
 
-bool Cuckarood::Validate(const BlockHeader& blockHeader)
+void Cuckarood::GetSipNonces(const ProofOfWork& proofOfWork, uint64_t* pNonces)
 {
-	const ProofOfWork& proofOfWork = blockHeader.GetProofOfWork();
-	const std::vector<uint64_t> proofNonces = proofOfWork.GetProofNonces();
-	if (proofNonces.size() != PROOFSIZE) {
-		LOG_ERROR("Invalid proof size");
-		return false;
-	}
+	sipblock_nonces(proofOfWork.GetProofNonces().data(), pNonces);
+}
 
-    Hash prePoWHash = Hasher::Blake2b(blockHeader.GetPreProofOfWork());
-    siphash_keys keys((const char*)prePoWHash.data());
-	const int result = verify_cuckarood((const word_t*)proofNonces.data(), keys);
+bool Cuckarood::Verify(const ProofOfWork& proofOfWork, uint64_t* pSips)
+{
+	const int result = verify_cuckarood((const word_t*)proofOfWork.GetProofNonces().data(), pSips);
 	if (result != POW_OK) {
 		LOG_ERROR_F("Failed with result: {}", errstr[result]);
 	}
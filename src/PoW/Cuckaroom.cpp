@@ -1,8 +1,6 @@
 #include "Cuckaroom.h"
 #include "Common.h"
 
-#include <Crypto/Hasher.h>
-
 // the main parameter is the number of bits in an edge index,
 // i.e. the 2-log of the number of edges
 #define EDGEBITS 29
@@ -15,19 +13,10 @@
 #define NODEMASK ((word_t)NNODES - 1)
 
 
-// fills buffer with EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
+// buf holds the EDGE_BLOCK_SIZE siphash outputs for block containing edge in cuckaroo graph
 // return siphash output for given edge
-uint64_t cuckaroom_sipblock(siphash_keys& keys, const word_t edge, uint64_t* buf)
+uint64_t cuckaroom_sipblock(uint64_t* buf, const word_t edge)
 {
-	siphash_state<> shs(keys);
-	word_t edge0 = edge & ~EDGE_BLOCK_MASK;
-
-	for (uint32_t i = 0; i < EDGE_BLOCK_SIZE; i++)
-	{
-		shs.hash24(edge0 + i);
-		buf[i] = shs.xor_lanes();
-	}
-
 	for (uint32_t i = EDGE_BLOCK_MASK; i; i--)
 	{
 		buf[i - 1] ^= buf[i];
@@ -37,10 +26,10 @@ uint64_t cuckaroom_sipblock(siphash_keys& keys, const word_t edge, uint64_t* buf
 }
 
 // verify that edges are ascending and form a cycle in header-generated graph
-int verify_cuckaroom(const word_t edges[PROOFSIZE], siphash_keys& keys)
+// sips holds the siphash outputs for the block containing each edge, in the order given by Cuckaroom::GetSipNonces
+int verify_cuckaroom(const word_t edges[PROOFSIZE], u64* sips)
 {
 	word_t xorfrom = 0, xorto = 0;
-	u64 sips[EDGE_BLOCK_SIZE];
 	word_t from[PROOFSIZE], to[PROOFSIZE], visited[PROOFSIZE];
 
 	for (u32 n = 0; n < PROOFSIZE; n++)
@@ -53,7 +42,7 @@ int verify_cuckaroom(const word_t edges[PROOFSIZE], siphash_keys& keys)
 			return POW_TOO_SMALL;
 		}
 
-		u64 edge = cuckaroom_sipblock(keys, edges[n], sips);
+		u64 edge = cuckaroom_sipblock(sips + n * EDGE_BLOCK_SIZE, edges[n]);
 		xorfrom ^= from[n] = edge & EDGEMASK;
 		xorto ^= to[n] = (edge >> 32) & EDGEMASK;
 		visited[n] = false;
@@ -79,18 +68,14 @@ int verify_cuckaroom(const word_t edges[PROOFSIZE], siphash_keys& keys)
 	return n == PROOFSIZE ? POW_OK : POW_SHORT_CYCLE;
 }
 
-bool Cuckaroom::Validate(const BlockHeader& blockHeader)
+void Cuckaroom::GetSipNonces(const ProofOfWork& proofOfWork, uint64_t* pNonces)
 {
-	const ProofOfWork& proofOfWork = blockHeader.GetProofOfWork();
-	const std::vector<uint64_t> proofNonces = proofOfWork.GetProofNonces();
-	if (proofNonces.size() != PROOFSIZE) {
-		LOG_ERROR("Invalid proof size");
-		return false;
-	}
+	sipblock_nonces(proofOfWork.GetProofNonces().data(), pNonces);
+}
 
-	Hash prePoWHash = Hasher::Blake2b(blockHeader.GetPreProofOfWork());
-	siphash_keys keys((const char*)prePoWHash.data());
-	const int result = verify_cuckaroom((const word_t*)proofNonces.data(), keys);
+bool Cuckaroom::Verify(const ProofOfWork& proofOfWork, uint64_t* pSips)
+{
+	const int result = verify_cuckaroom((const word_t*)proofOfWork.GetProofNonces().data(), pSips);
 	if (result != POW_OK) {
 		LOG_ERROR_F("Failed with result: {}", errstr[result]);
 	}
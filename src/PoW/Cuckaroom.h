@@ -1,9 +1,26 @@
 #pragma once
 
-#include <Core/Models/BlockHeader.h>
+#include <Core/Models/ProofOfWork.h>
+
+#include "Common.h"
 
 class Cuckaroom
 {
 public:
-	static bool Validate(const BlockHeader& blockHeader);
+	// The siphashes needed to verify a proof are split into NUM_LANES lanes of LANE_LENGTH consecutive nonces each.
+	// See SipHasher::Hash24.
+	static constexpr size_t NUM_LANES = PROOFSIZE;
+	static constexpr size_t LANE_LENGTH = EDGE_BLOCK_SIZE;
+	static constexpr int ROT_E = 21;
+
+	//
+	// Fills pNonces with the first nonce of each of the NUM_LANES lanes.
+	// The proof must have PROOFSIZE nonces.
+	//
+	static void GetSipNonces(const ProofOfWork& proofOfWork, uint64_t* pNonces);
+
+	//
+	// Verifies the cycle, given the NUM_LANES * LANE_LENGTH siphash outputs for the lanes from GetSipNonces. pSips gets overwritten.
+	//
+	static bool Verify(const ProofOfWork& proofOfWork, uint64_t* pSips);
 };
\ No newline at end of file
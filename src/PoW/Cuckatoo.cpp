@@ -1,18 +1,9 @@
 #include "Cuckatoo.h"
 #include "Common.h"
 
-#include <Crypto/Hasher.h>
-
-// generate edge endpoint in cuck(at)oo graph without partition bit
-word_t sipnode(siphash_keys* keys, word_t edge, u32 uorv, const word_t edgeMask)
-{
-    siphash_state v(*keys);
-    v.hash24(2 * edge + uorv);
-    return v.xor_lanes() & edgeMask;
-}
-
 // verify that edges are ascending and form a cycle in header-generated graph
-int verify_cuckatoo(const word_t edges[PROOFSIZE], siphash_keys* keys, const uint8_t edgeBits)
+// sips holds the siphash outputs for the endpoints of each edge, in the order given by Cuckatoo::GetSipNonces
+int verify_cuckatoo(const word_t edges[PROOFSIZE], const u64* sips, const uint8_t edgeBits)
 {
     word_t uvs[2 * PROOFSIZE], xor0, xor1;
     xor0 = xor1 = (PROOFSIZE / 2) & 1;
@@ -33,8 +24,9 @@ int verify_cuckatoo(const word_t edges[PROOFSIZE], siphash_keys* keys, const uin
             return POW_TOO_SMALL;
         }
 
-        xor0 ^= uvs[2 * n] = sipnode(keys, edges[n], 0, edgeMask);
-        xor1 ^= uvs[2 * n + 1] = sipnode(keys, edges[n], 1, edgeMask);
+        // edge endpoints in cuck(at)oo graph without partition bit
+        xor0 ^= uvs[2 * n] = sips[2 * n] & edgeMask;
+        xor1 ^= uvs[2 * n + 1] = sips[2 * n + 1] & edgeMask;
     }
 
     // optional check for obviously bad proofs
@@ -71,17 +63,19 @@ int verify_cuckatoo(const word_t edges[PROOFSIZE], siphash_keys* keys, const uin
     return n == PROOFSIZE ? POW_OK : POW_SHORT_CYCLE;
 }
 
-bool Cuckatoo::Validate(const BlockHeader& blockHeader)
+void Cuckatoo::GetSipNonces(const ProofOfWork& proofOfWork, uint64_t* pNonces)
 {
-	const ProofOfWork& proofOfWork = blockHeader.GetProofOfWork();
-	const std::vector<uint64_t> proofNonces = proofOfWork.GetProofNonces();
-	if (proofNonces.size() != PROOFSIZE) {
-		return false;
+	const std::vector<uint64_t>& edges = proofOfWork.GetProofNonces();
+	for (size_t n = 0; n < PROOFSIZE; n++)
+	{
+		pNonces[2 * n] = 2 * edges[n];
+		pNonces[2 * n + 1] = 2 * edges[n] + 1;
 	}
+}
 
-    Hash prePoWHash = Hasher::Blake2b(blockHeader.GetPreProofOfWork());
-    siphash_keys keys((const char*)prePoWHash.data());
-	const int result = verify_cuckatoo(proofNonces.data(), &keys, proofOfWork.GetEdgeBits());
+bool Cuckatoo::Verify(const ProofOfWork& proofOfWork, uint64_t* pSips)
+{
+	const int result = verify_cuckatoo(proofOfWork.GetProofNonces().data(), pSips, proofOfWork.GetEdgeBits());
 	if (result != POW_OK) {
 		LOG_ERROR_F("Failed with result: {}", errstr[result]);
 	}
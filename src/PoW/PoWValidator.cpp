@@ -7,9 +7,95 @@
 #include "Cuckaroom.h"
 #include "Cuckarooz.h"
 #include "Cuckatoo.h"
+#include "SipHasher.h"
 
 #include <Consensus/BlockTime.h>
 #include <Consensus/BlockDifficulty.h>
+#include <Crypto/Blake2bHasher.h>
+#include <algorithm>
+
+// The number of proofs whose siphashes are computed together.
+// Each cuckaroo proof needs 2,688 siphashes, so this keeps the buffers for a batch under 1MB.
+static const size_t PROOF_BATCH_SIZE = 16;
+
+struct PendingProof
+{
+	const ProofOfWork* pProofOfWork;
+	EPoWType powType;
+	siphash_keys keys;
+
+	// The position of the proof's first lane in its SipBatch.
+	size_t lane;
+};
+
+// The siphash lanes for all of the proofs that use the same rotation and lane length.
+// Each lane refers to its proof by index, since the proofs may move while the batch is being filled.
+struct SipBatch
+{
+	std::vector<size_t> proofIndices;
+	std::vector<uint64_t> nonces;
+	std::vector<uint64_t> sips;
+
+	void Clear()
+	{
+		proofIndices.clear();
+		nonces.clear();
+		sips.clear();
+	}
+};
+
+// Cuckatoo lanes are single hashes, the cuckaroo variants hash a whole edge block per lane, and cuckarood also uses a different rotation.
+enum EBatch
+{
+	CUCKATOO_BATCH,
+	CUCKAROO_BATCH,
+	CUCKAROOD_BATCH,
+	NUM_BATCHES
+};
+
+template <typename ALGO>
+static SipBatch& GetBatch(SipBatch* pBatches)
+{
+	if (ALGO::LANE_LENGTH == 1)
+	{
+		return pBatches[CUCKATOO_BATCH];
+	}
+
+	return pBatches[ALGO::ROT_E == 21 ? CUCKAROO_BATCH : CUCKAROOD_BATCH];
+}
+
+template <typename ALGO>
+static void AddToBatch(std::vector<PendingProof>& proofs, const size_t proofIndex, SipBatch* pBatches)
+{
+	PendingProof& proof = proofs[proofIndex];
+	SipBatch& batch = GetBatch<ALGO>(pBatches);
+	proof.lane = batch.nonces.size();
+	batch.proofIndices.resize(proof.lane + ALGO::NUM_LANES, proofIndex);
+	batch.nonces.resize(proof.lane + ALGO::NUM_LANES);
+	ALGO::GetSipNonces(*proof.pProofOfWork, batch.nonces.data() + proof.lane);
+}
+
+template <typename ALGO>
+static void HashBatch(SipBatch& batch, const std::vector<PendingProof>& proofs)
+{
+	std::vector<const siphash_keys*> keys(batch.proofIndices.size());
+	std::transform(
+		batch.proofIndices.cbegin(),
+		batch.proofIndices.cend(),
+		keys.begin(),
+		[&proofs](const size_t proofIndex) { return &proofs[proofIndex].keys; }
+	);
+
+	batch.sips.resize(batch.nonces.size() * ALGO::LANE_LENGTH);
+	SipHasher::Hash24<ALGO::ROT_E>(keys.data(), batch.nonces.data(), batch.sips.data(), batch.nonces.size(), ALGO::LANE_LENGTH);
+}
+
+template <typename ALGO>
+static bool VerifyFromBatch(const PendingProof& proof, SipBatch* pBatches)
+{
+	SipBatch& batch = GetBatch<ALGO>(pBatches);
+	return ALGO::Verify(*proof.pProofOfWork, batch.sips.data() + (proof.lane * ALGO::LANE_LENGTH));
+}
 
 PoWValidator::PoWValidator(const Config& config, std::shared_ptr<const IBlockDB> pBlockDB)
 	: m_config(config), m_pBlockDB(pBlockDB)
@@ -18,6 +104,11 @@ PoWValidator::PoWValidator(const Config& config, std::shared_ptr<const IBlockDB>
 }
 
 bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const
+{
+	return IsDifficultyValid(header, previousHeader) && AreProofsValid(std::vector<const BlockHeader*>({ &header }));
+}
+
+bool PoWValidator::IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const
 {
 	// Validate Total Difficulty
 	if (header.GetTotalDifficulty() <= previousHeader.GetTotalDifficulty())
@@ -48,32 +139,99 @@ bool PoWValidator::IsPoWValid(const BlockHeader& header, const BlockHeader& prev
 		return false;
 	}
 
-	const ProofOfWork& proofOfWork = header.GetProofOfWork();
-	const EPoWType powType = PoWUtil(m_config).DeterminePoWType(header.GetVersion(), proofOfWork.GetEdgeBits());
-	if (powType == EPoWType::CUCKAROO)
-	{
-		return Cuckaroo::Validate(header);
-	}
-	else if (powType == EPoWType::CUCKAROOD)
-	{
-		return Cuckarood::Validate(header);
-	}
-	else if (powType == EPoWType::CUCKAROOM)
-	{
-		return Cuckaroom::Validate(header);
-	}
-	else if (powType == EPoWType::CUCKAROOZ)
-	{
-		return Cuckarooz::Validate(header);
-	}
-	else if (powType == EPoWType::CUCKATOO)
-	{
-		return Cuckatoo::Validate(header);
-	}
-	else
+	return true;
+}
+
+bool PoWValidator::AreProofsValid(const std::vector<BlockHeaderPtr>& headers) const
+{
+	std::vector<const BlockHeader*> headerPtrs(headers.size());
+	std::transform(
+		headers.cbegin(),
+		headers.cend(),
+		headerPtrs.begin(),
+		[](const BlockHeaderPtr& pHeader) { return pHeader.get(); }
+	);
+
+	return AreProofsValid(headerPtrs);
+}
+
+bool PoWValidator::AreProofsValid(const std::vector<const BlockHeader*>& headers) const
+{
+	const PoWUtil powUtil(m_config);
+
+	std::vector<PendingProof> proofs;
+	proofs.reserve(PROOF_BATCH_SIZE);
+
+	SipBatch batches[NUM_BATCHES];
+
+	for (size_t begin = 0; begin < headers.size(); begin += PROOF_BATCH_SIZE)
 	{
-		return false;
+		const size_t end = (std::min)(headers.size(), begin + PROOF_BATCH_SIZE);
+
+		proofs.clear();
+		for (SipBatch& batch : batches)
+		{
+			batch.Clear();
+		}
+
+		for (size_t i = begin; i < end; i++)
+		{
+			const BlockHeader& header = *headers[i];
+			const ProofOfWork& proofOfWork = header.GetProofOfWork();
+			if (proofOfWork.GetProofNonces().size() != PROOFSIZE)
+			{
+				LOG_WARNING_F("Invalid proof size for header {}", header);
+				return false;
+			}
+
+			Blake2bHasher prePoWHasher;
+			header.SerializePreProofOfWork(prePoWHasher);
+			const Hash prePoWHash = prePoWHasher.Finalize();
+			proofs.push_back(PendingProof{
+				&proofOfWork,
+				powUtil.DeterminePoWType(header.GetVersion(), proofOfWork.GetEdgeBits()),
+				siphash_keys((const char*)prePoWHash.data()),
+				0
+			});
+
+			const size_t proofIndex = proofs.size() - 1;
+			switch (proofs[proofIndex].powType)
+			{
+				case EPoWType::CUCKAROO: AddToBatch<Cuckaroo>(proofs, proofIndex, batches); break;
+				case EPoWType::CUCKAROOD: AddToBatch<Cuckarood>(proofs, proofIndex, batches); break;
+				case EPoWType::CUCKAROOM: AddToBatch<Cuckaroom>(proofs, proofIndex, batches); break;
+				case EPoWType::CUCKAROOZ: AddToBatch<Cuckarooz>(proofs, proofIndex, batches); break;
+				case EPoWType::CUCKATOO: AddToBatch<Cuckatoo>(proofs, proofIndex, batches); break;
+			}
+		}
+
+		HashBatch<Cuckatoo>(batches[CUCKATOO_BATCH], proofs);
+		HashBatch<Cuckaroo>(batches[CUCKAROO_BATCH], proofs);
+		HashBatch<Cuckarood>(batches[CUCKAROOD_BATCH], proofs);
+
+		for (size_t i = 0; i < proofs.size(); i++)
+		{
+			const PendingProof& proof = proofs[i];
+
+			bool valid = false;
+			switch (proof.powType)
+			{
+				case EPoWType::CUCKAROO: valid = VerifyFromBatch<Cuckaroo>(proof, batches); break;
+				case EPoWType::CUCKAROOD: valid = VerifyFromBatch<Cuckarood>(proof, batches); break;
+				case EPoWType::CUCKAROOM: valid = VerifyFromBatch<Cuckaroom>(proof, batches); break;
+				case EPoWType::CUCKAROOZ: valid = VerifyFromBatch<Cuckarooz>(proof, batches); break;
+				case EPoWType::CUCKATOO: valid = VerifyFromBatch<Cuckatoo>(proof, batches); break;
+			}
+
+			if (!valid)
+			{
+				LOG_WARNING_F("Invalid cuckoo cycle for header {}", *headers[begin + i]);
+				return false;
+			}
+		}
 	}
+
+	return true;
 }
 
 // Maximum difficulty this proof of work can achieve
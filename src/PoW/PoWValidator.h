@@ -10,8 +10,16 @@ public:
 	PoWValidator(const Config& config, std::shared_ptr<const IBlockDB> pBlockDB);
 
 	bool IsPoWValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
+	bool IsDifficultyValid(const BlockHeader& header, const BlockHeader& previousHeader) const;
+
+	//
+	// Verifies the cuckoo cycles of all of the headers.
+	// The siphashes for the edges of many proofs are computed together, so they can be spread across SIMD lanes.
+	//
+	bool AreProofsValid(const std::vector<BlockHeaderPtr>& headers) const;
 
 private:
+	bool AreProofsValid(const std::vector<const BlockHeader*>& headers) const;
 	uint64_t GetMaximumDifficulty(const BlockHeader& header) const;
 
 	const Config& m_config;
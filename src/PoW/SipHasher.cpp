@@ -0,0 +1,302 @@
+#include "SipHasher.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define POW_SIMD_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and clang only generate AVX2 instructions for functions marked with the target, unless the whole file is built with -mavx2.
+#if defined(POW_SIMD_X64) && defined(__GNUC__)
+#define POW_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define POW_TARGET_AVX2
+#endif
+
+// The SIMD implementations load each key as one block of 4 words.
+static_assert(sizeof(siphash_keys) == 4 * sizeof(uint64_t), "siphash_keys must only hold k0-k3");
+
+enum class EImplementation
+{
+	SCALAR,
+	SSE2,
+	AVX2
+};
+
+static EImplementation DetectImplementation()
+{
+#if defined(POW_SIMD_X64) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+
+	// AVX2 also needs the OS to save the upper halves of the ymm registers.
+	__cpuid(info, 1);
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+	{
+		__cpuidex(info, 7, 0);
+		if ((info[1] & (1 << 5)) != 0)
+		{
+			return EImplementation::AVX2;
+		}
+	}
+
+	return EImplementation::SSE2;
+#elif defined(POW_SIMD_X64)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? EImplementation::AVX2 : EImplementation::SSE2;
+#else
+	return EImplementation::SCALAR;
+#endif
+}
+
+static EImplementation GetImplementationType()
+{
+	static const EImplementation implementation = DetectImplementation();
+	return implementation;
+}
+
+template <int rotE>
+static void Hash24Scalar(const siphash_keys* const* keys, const uint64_t* nonces, uint64_t* results, const size_t count, const size_t length)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		siphash_state<rotE> state(*keys[i]);
+		for (size_t j = 0; j < length; j++)
+		{
+			state.hash24(nonces[i] + j);
+			results[(i * length) + j] = state.xor_lanes();
+		}
+	}
+}
+
+#ifdef POW_SIMD_X64
+template <int B>
+static inline __m128i RotlSSE2(const __m128i x)
+{
+	return _mm_or_si128(_mm_slli_epi64(x, B), _mm_srli_epi64(x, 64 - B));
+}
+
+// Rotating by 32 just swaps the 32-bit halves of each lane.
+template <>
+inline __m128i RotlSSE2<32>(const __m128i x)
+{
+	return _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+template <int rotE>
+static inline void SipRoundSSE2(__m128i& v0, __m128i& v1, __m128i& v2, __m128i& v3)
+{
+	v0 = _mm_add_epi64(v0, v1); v2 = _mm_add_epi64(v2, v3); v1 = RotlSSE2<13>(v1);
+	v3 = RotlSSE2<16>(v3); v1 = _mm_xor_si128(v1, v0); v3 = _mm_xor_si128(v3, v2);
+	v0 = RotlSSE2<32>(v0); v2 = _mm_add_epi64(v2, v1); v0 = _mm_add_epi64(v0, v3);
+	v1 = RotlSSE2<17>(v1); v3 = RotlSSE2<rotE>(v3);
+	v1 = _mm_xor_si128(v1, v2); v3 = _mm_xor_si128(v3, v0); v2 = RotlSSE2<32>(v2);
+}
+
+// Runs 2 lanes at a time, and returns the number of lanes done.
+template <int rotE>
+static size_t Hash24SSE2(const siphash_keys* const* keys, const uint64_t* nonces, uint64_t* results, const size_t count, const size_t length)
+{
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		// Transpose the keys, so each register holds the same key word for both lanes.
+		const __m128i keys01A = _mm_loadu_si128((const __m128i*)&keys[i]->k0);
+		const __m128i keys23A = _mm_loadu_si128((const __m128i*)&keys[i]->k2);
+		const __m128i keys01B = _mm_loadu_si128((const __m128i*)&keys[i + 1]->k0);
+		const __m128i keys23B = _mm_loadu_si128((const __m128i*)&keys[i + 1]->k2);
+		__m128i v0 = _mm_unpacklo_epi64(keys01A, keys01B);
+		__m128i v1 = _mm_unpackhi_epi64(keys01A, keys01B);
+		__m128i v2 = _mm_unpacklo_epi64(keys23A, keys23B);
+		__m128i v3 = _mm_unpackhi_epi64(keys23A, keys23B);
+		__m128i nonce = _mm_loadu_si128((const __m128i*)(nonces + i));
+
+		for (size_t j = 0; j < length; j++)
+		{
+			v3 = _mm_xor_si128(v3, nonce);
+			SipRoundSSE2<rotE>(v0, v1, v2, v3);
+			SipRoundSSE2<rotE>(v0, v1, v2, v3);
+			v0 = _mm_xor_si128(v0, nonce);
+			v2 = _mm_xor_si128(v2, _mm_set1_epi64x(0xff));
+			SipRoundSSE2<rotE>(v0, v1, v2, v3);
+			SipRoundSSE2<rotE>(v0, v1, v2, v3);
+			SipRoundSSE2<rotE>(v0, v1, v2, v3);
+			SipRoundSSE2<rotE>(v0, v1, v2, v3);
+
+			alignas(16) uint64_t result[2];
+			_mm_store_si128((__m128i*)result, _mm_xor_si128(_mm_xor_si128(v0, v1), _mm_xor_si128(v2, v3)));
+			results[(i * length) + j] = result[0];
+			results[((i + 1) * length) + j] = result[1];
+
+			nonce = _mm_add_epi64(nonce, _mm_set1_epi64x(1));
+		}
+	}
+
+	return i;
+}
+
+template <int B>
+POW_TARGET_AVX2 static inline __m256i RotlAVX2(const __m256i x)
+{
+	return _mm256_or_si256(_mm256_slli_epi64(x, B), _mm256_srli_epi64(x, 64 - B));
+}
+
+template <>
+POW_TARGET_AVX2 inline __m256i RotlAVX2<16>(const __m256i x)
+{
+	const __m256i rotate16 = _mm256_set_epi8(
+		13, 12, 11, 10, 9, 8, 15, 14, 5, 4, 3, 2, 1, 0, 7, 6,
+		13, 12, 11, 10, 9, 8, 15, 14, 5, 4, 3, 2, 1, 0, 7, 6
+	);
+	return _mm256_shuffle_epi8(x, rotate16);
+}
+
+template <>
+POW_TARGET_AVX2 inline __m256i RotlAVX2<32>(const __m256i x)
+{
+	return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+// The state of 4 lanes.
+struct StateAVX2
+{
+	__m256i v0;
+	__m256i v1;
+	__m256i v2;
+	__m256i v3;
+	__m256i nonce;
+};
+
+template <int rotE>
+POW_TARGET_AVX2 static inline void SipRoundAVX2(StateAVX2& state)
+{
+	state.v0 = _mm256_add_epi64(state.v0, state.v1); state.v2 = _mm256_add_epi64(state.v2, state.v3); state.v1 = RotlAVX2<13>(state.v1);
+	state.v3 = RotlAVX2<16>(state.v3); state.v1 = _mm256_xor_si256(state.v1, state.v0); state.v3 = _mm256_xor_si256(state.v3, state.v2);
+	state.v0 = RotlAVX2<32>(state.v0); state.v2 = _mm256_add_epi64(state.v2, state.v1); state.v0 = _mm256_add_epi64(state.v0, state.v3);
+	state.v1 = RotlAVX2<17>(state.v1); state.v3 = RotlAVX2<rotE>(state.v3);
+	state.v1 = _mm256_xor_si256(state.v1, state.v2); state.v3 = _mm256_xor_si256(state.v3, state.v0); state.v2 = RotlAVX2<32>(state.v2);
+}
+
+// Transposes the 4x4 matrix of keys, so each register holds the same key word for all 4 lanes.
+POW_TARGET_AVX2 static inline void LoadAVX2(StateAVX2& state, const siphash_keys* const* keys, const uint64_t* nonces)
+{
+	const __m256i keysA = _mm256_loadu_si256((const __m256i*)&keys[0]->k0);
+	const __m256i keysB = _mm256_loadu_si256((const __m256i*)&keys[1]->k0);
+	const __m256i keysC = _mm256_loadu_si256((const __m256i*)&keys[2]->k0);
+	const __m256i keysD = _mm256_loadu_si256((const __m256i*)&keys[3]->k0);
+	const __m256i evenAB = _mm256_unpacklo_epi64(keysA, keysB);
+	const __m256i oddAB = _mm256_unpackhi_epi64(keysA, keysB);
+	const __m256i evenCD = _mm256_unpacklo_epi64(keysC, keysD);
+	const __m256i oddCD = _mm256_unpackhi_epi64(keysC, keysD);
+	state.v0 = _mm256_permute2x128_si256(evenAB, evenCD, 0x20);
+	state.v1 = _mm256_permute2x128_si256(oddAB, oddCD, 0x20);
+	state.v2 = _mm256_permute2x128_si256(evenAB, evenCD, 0x31);
+	state.v3 = _mm256_permute2x128_si256(oddAB, oddCD, 0x31);
+	state.nonce = _mm256_loadu_si256((const __m256i*)nonces);
+}
+
+// Runs NUM_GROUPS sets of 4 lanes through a whole chain of length nonces.
+// A round only depends on the one before it, so interleaving groups keeps more instructions in flight.
+template <int rotE, size_t NUM_GROUPS>
+POW_TARGET_AVX2 static inline void HashGroupsAVX2(const siphash_keys* const* keys, const uint64_t* nonces, uint64_t* results, const size_t length)
+{
+	StateAVX2 states[NUM_GROUPS];
+	for (size_t g = 0; g < NUM_GROUPS; g++)
+	{
+		LoadAVX2(states[g], keys + (g * 4), nonces + (g * 4));
+	}
+
+	const __m256i one = _mm256_set1_epi64x(1);
+	const __m256i ff = _mm256_set1_epi64x(0xff);
+	for (size_t j = 0; j < length; j++)
+	{
+		for (StateAVX2& state : states) { state.v3 = _mm256_xor_si256(state.v3, state.nonce); }
+		for (StateAVX2& state : states) { SipRoundAVX2<rotE>(state); }
+		for (StateAVX2& state : states) { SipRoundAVX2<rotE>(state); }
+		for (StateAVX2& state : states)
+		{
+			state.v0 = _mm256_xor_si256(state.v0, state.nonce);
+			state.v2 = _mm256_xor_si256(state.v2, ff);
+		}
+		for (StateAVX2& state : states) { SipRoundAVX2<rotE>(state); }
+		for (StateAVX2& state : states) { SipRoundAVX2<rotE>(state); }
+		for (StateAVX2& state : states) { SipRoundAVX2<rotE>(state); }
+		for (StateAVX2& state : states) { SipRoundAVX2<rotE>(state); }
+
+		for (size_t g = 0; g < NUM_GROUPS; g++)
+		{
+			StateAVX2& state = states[g];
+
+			alignas(32) uint64_t result[4];
+			_mm256_store_si256((__m256i*)result, _mm256_xor_si256(_mm256_xor_si256(state.v0, state.v1), _mm256_xor_si256(state.v2, state.v3)));
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				results[(((g * 4) + lane) * length) + j] = result[lane];
+			}
+
+			state.nonce = _mm256_add_epi64(state.nonce, one);
+		}
+	}
+}
+
+// Runs 4 lanes at a time, 8 when there are enough, and returns the number of lanes done.
+template <int rotE>
+POW_TARGET_AVX2 static size_t Hash24AVX2(const siphash_keys* const* keys, const uint64_t* nonces, uint64_t* results, const size_t count, const size_t length)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		HashGroupsAVX2<rotE, 2>(keys + i, nonces + i, results + (i * length), length);
+	}
+
+	for (; i + 4 <= count; i += 4)
+	{
+		HashGroupsAVX2<rotE, 1>(keys + i, nonces + i, results + (i * length), length);
+	}
+
+	return i;
+}
+#endif
+
+template <int rotE>
+void SipHasher::Hash24(const siphash_keys* const* keys, const uint64_t* nonces, uint64_t* results, const size_t count, const size_t length)
+{
+	size_t done = 0;
+
+#ifdef POW_SIMD_X64
+	const EImplementation implementation = GetImplementationType();
+	if (implementation == EImplementation::AVX2)
+	{
+		done = Hash24AVX2<rotE>(keys, nonces, results, count, length);
+	}
+
+	// Whatever doesn't fill a full set of lanes goes through the narrower implementations.
+	if (implementation != EImplementation::SCALAR)
+	{
+		done += Hash24SSE2<rotE>(keys + done, nonces + done, results + (done * length), count - done, length);
+	}
+#endif
+
+	Hash24Scalar<rotE>(keys + done, nonces + done, results + (done * length), count - done, length);
+}
+
+template void SipHasher::Hash24<21>(const siphash_keys* const*, const uint64_t*, uint64_t*, const size_t, const size_t);
+template void SipHasher::Hash24<25>(const siphash_keys* const*, const uint64_t*, uint64_t*, const size_t, const size_t);
+
+const char* SipHasher::GetImplementation()
+{
+	switch (GetImplementationType())
+	{
+		case EImplementation::AVX2:
+			return "AVX2";
+		case EImplementation::SSE2:
+			return "SSE2";
+		default:
+			return "Scalar";
+	}
+}
\ No newline at end of file
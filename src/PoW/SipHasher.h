@@ -0,0 +1,32 @@
+#pragma once
+
+#include "siphash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+//
+// Computes many SipHash-2-4 outputs at once, spreading them across SIMD lanes.
+//
+// Each lane gets its own keys, so a batch can mix the edges of one proof with the edges of proofs from other headers.
+// AVX2 (4 lanes) or SSE2 (2 lanes) is picked at runtime, and other CPUs fall back to one lane at a time.
+//
+class SipHasher
+{
+public:
+	//
+	// For each of the count lanes, starts a siphash_state<rotE> from *keys[i], and calls hash24 with nonces[i], nonces[i] + 1, ...
+	// up to nonces[i] + length - 1, keeping the state between calls like the cuckaroo sipblocks do.
+	// The output of each call, xor'd down to 64 bits, goes in results[(i * length) + j].
+	//
+	// A length of 1 gives independent hashes, like the cuckatoo sipnodes.
+	// Only rotE values of 21 (cuckatoo, cuckaroo, cuckaroom, cuckarooz) and 25 (cuckarood) are supported.
+	//
+	template <int rotE>
+	static void Hash24(const siphash_keys* const* keys, const uint64_t* nonces, uint64_t* results, const size_t count, const size_t length);
+
+	//
+	// The name of the implementation picked for this CPU, eg. "AVX2".
+	//
+	static const char* GetImplementation();
+};
\ No newline at end of file
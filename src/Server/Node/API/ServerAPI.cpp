@@ -83,6 +83,8 @@ int ServerAPI::GetStatus_Handler(struct mg_connection* conn, void* pNodeContext)
 	networkNode["num_outbound"] = Json::UInt64(numConnections.second);
 	statusNode["network"] = networkNode;
 
+	statusNode["tx_queue"] = pServer->m_pP2PServer->GetTransactionQueueStats().ToJSON();
+
 	Json::Value tipNode;
 	tipNode["height"] = pTip->GetHeight();
 	tipNode["hash"] = pTip->GetHash().ToHex();
@@ -136,6 +136,8 @@ public:
 					if (result == EAddTransactionStatus::ADDED) {
 						if (poolType == EPoolType::MEMPOOL) {
 							m_pP2PServer->BroadcastTransaction(pTransaction);
+						} else {
+							m_pP2PServer->StemTransaction(pTransaction);
 						}
 
 						return true;
@@ -1,10 +1,10 @@
 #include "Pool.h"
-#include "ValidTransactionFinder.h"
 
-#include <Core/Util/TransactionUtil.h>
+#include <Crypto/Crypto.h>
 #include <Common/Util/VectorUtil.h>
 #include <Common/Logger.h>
 #include <algorithm>
+#include <iterator>
 #include <unordered_map>
 
 std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
@@ -32,35 +32,55 @@ std::vector<TransactionPtr> Pool::GetTransactionsByShortId(const Hash& hash, con
 
 void Pool::AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status)
 {
+	if (m_txsByHash.find(pTransaction->GetHash()) != m_txsByHash.end())
+	{
+		LOG_DEBUG_F("Transaction already in pool: {}", pTransaction->GetHash());
+		return;
+	}
+
 	LOG_DEBUG_F("Transaction added: {}", pTransaction->GetHash());
 
-	m_transactions.emplace_back(TxPoolEntry(pTransaction, status, std::time_t()));
-}
+	const EntryIter iter = m_transactions.emplace(m_transactions.end(), TxPoolEntry(pTransaction, status, std::time_t(), m_nextSequence++));
 
-bool Pool::ContainsTransaction(const Transaction& transaction) const
-{
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	m_totalOffset = Crypto::AddBlindingFactors({ m_totalOffset, pTransaction->GetOffset() }, {});
+	m_txsByHash.emplace(pTransaction->GetHash(), iter);
+	m_txsByStatus.emplace(std::make_pair(status, iter->GetSequence()), iter);
+	for (const TransactionKernel& kernel : pTransaction->GetKernels())
 	{
-		if (*txPoolEntry.GetTransaction() == transaction)
-		{
-			return true;
-		}
+		m_txsByKernelHash.emplace(kernel.GetHash(), iter);
+	}
+
+	for (const TransactionInput& input : pTransaction->GetInputs())
+	{
+		m_txsByInput.emplace(input.GetCommitment(), iter);
+	}
+
+	for (const TransactionOutput& output : pTransaction->GetOutputs())
+	{
+		m_txsByOutput.emplace(output.GetCommitment(), iter);
 	}
 
-	return false;
+	UpdatePackage(iter);
+	for (const EntryIter& descendant : GetDescendants(iter))
+	{
+		UpdatePackage(descendant);
+	}
+}
+
+bool Pool::ContainsTransaction(const Transaction& transaction) const
+{
+	return m_txsByHash.find(transaction.GetHash()) != m_txsByHash.end();
 }
 
 std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const
 {
 	std::set<TransactionPtr> transactionSet;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	for (const TransactionKernel& kernel : kernels)
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
+		auto range = m_txsByKernelHash.equal_range(kernel.GetHash());
+		for (auto iter = range.first; iter != range.second; iter++)
 		{
-			if (kernels.count(kernel) > 0)
-			{
-				transactionSet.insert(txPoolEntry.GetTransaction());
-			}
+			transactionSet.insert(iter->second->GetTransaction());
 		}
 	}
 
@@ -72,15 +92,21 @@ std::vector<TransactionPtr> Pool::FindTransactionsByKernel(const std::set<Transa
 
 TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 {
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+	auto iter = m_txsByKernelHash.find(kernelHash);
+	if (iter != m_txsByKernelHash.end())
 	{
-		for (const TransactionKernel& kernel : txPoolEntry.GetTransaction()->GetKernels())
-		{
-			if (kernel.GetHash() == kernelHash)
-			{
-				return txPoolEntry.GetTransaction();
-			}
-		}
+		return iter->second->GetTransaction();
+	}
+
+	return nullptr;
+}
+
+TransactionPtr Pool::FindTransactionByHash(const Hash& txHash) const
+{
+	auto iter = m_txsByHash.find(txHash);
+	if (iter != m_txsByHash.end())
+	{
+		return iter->second->GetTransaction();
 	}
 
 	return nullptr;
@@ -89,114 +115,464 @@ TransactionPtr Pool::FindTransactionByKernelHash(const Hash& kernelHash) const
 std::vector<TransactionPtr> Pool::FindTransactionsByStatus(const EDandelionStatus status) const
 {
 	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+
+	auto iter = m_txsByStatus.lower_bound(std::make_pair(status, (uint64_t)0));
+	for (; iter != m_txsByStatus.end() && iter->first.first == status; iter++)
 	{
-		if (txPoolEntry.GetStatus() == status)
-		{
-			transactions.push_back(txPoolEntry.GetTransaction());
-		}
+		transactions.push_back(iter->second->GetTransaction());
 	}
 
 	return transactions;
 }
 
-std::vector<TransactionPtr> Pool::GetExpiredTransactions(const uint16_t embargoSeconds) const
+void Pool::RemoveTransaction(const Transaction& transaction)
 {
-	const std::time_t cutoff = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() - std::chrono::seconds(embargoSeconds));
+	auto iter = m_txsByHash.find(transaction.GetHash());
+	if (iter != m_txsByHash.end())
+	{
+		Erase(iter->second);
+	}
+}
 
-	std::vector<TransactionPtr> transactions;
-	for (const TxPoolEntry& txPoolEntry : m_transactions)
+void Pool::Clear()
+{
+	m_txsByHash.clear();
+	m_txsByKernelHash.clear();
+	m_txsByInput.clear();
+	m_txsByOutput.clear();
+	m_txsByFeeRate.clear();
+	m_txsByStatus.clear();
+	m_transactions.clear();
+	m_totalOffset = BlindingFactor();
+}
+
+void Pool::Erase(const EntryIter iter)
+{
+	const Transaction& transaction = *iter->GetTransaction();
+	const std::vector<EntryIter> descendants = GetDescendants(iter);
+
+	m_txsByFeeRate.erase(FeeRateKey(*iter));
+	m_txsByStatus.erase(std::make_pair(iter->GetStatus(), iter->GetSequence()));
+	m_txsByHash.erase(transaction.GetHash());
+	m_totalOffset = Crypto::AddBlindingFactors({ m_totalOffset }, { transaction.GetOffset() });
+	for (const TransactionKernel& kernel : transaction.GetKernels())
+	{
+		EraseFromIndex(m_txsByKernelHash, kernel.GetHash(), iter);
+	}
+
+	for (const TransactionInput& input : transaction.GetInputs())
+	{
+		EraseFromIndex(m_txsByInput, input.GetCommitment(), iter);
+	}
+
+	for (const TransactionOutput& output : transaction.GetOutputs())
+	{
+		EraseFromIndex(m_txsByOutput, output.GetCommitment(), iter);
+	}
+
+	m_transactions.erase(iter);
+
+	for (const EntryIter& descendant : descendants)
+	{
+		UpdatePackage(descendant);
+	}
+}
+
+void Pool::Erase(const EntryIter iter, std::unordered_set<Commitment>& removedOutputs)
+{
+	for (const TransactionOutput& output : iter->GetTransaction()->GetOutputs())
+	{
+		removedOutputs.insert(output.GetCommitment());
+	}
+
+	Erase(iter);
+}
+
+std::unordered_set<Commitment> Pool::ReconcileBlock(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const FullBlock& block,
+	const Pool* pBasePool,
+	const std::unordered_set<Commitment>& removedBaseOutputs)
+{
+	const bool reorg = block.GetPreviousHash() != m_lastBlockHash;
+	m_lastBlockHash = block.GetHash();
+
+	std::unordered_set<Commitment> removedOutputs;
+	RemoveConflicts(block, removedOutputs);
+	if (pBasePool != nullptr)
 	{
-		if (txPoolEntry.GetTimestamp() < cutoff)
+		RemoveConflicts(*pBasePool, removedOutputs);
+	}
+
+	if (reorg)
+	{
+		RemoveUnspendable(pBlockDB, pTxHashSet, pBasePool, removedOutputs);
+	}
+
+	// Outputs of removed txs may have made it into the block, in which case the txs spending them are still valid.
+	std::unordered_set<Commitment> spentOutputs = removedOutputs;
+	spentOutputs.insert(removedBaseOutputs.cbegin(), removedBaseOutputs.cend());
+	RemoveDependents(pBlockDB, pTxHashSet, pBasePool, spentOutputs, removedOutputs);
+
+	return removedOutputs;
+}
+
+// Removes any txs in the pool that conflict with the block. That includes txs that:
+// * have a kernel that's in the block, since they were likely included in it.
+// * spend an input that the block spends.
+// * create an output that the block creates.
+// Only the indexes are consulted, so this is proportional to the size of the block rather than the pool.
+size_t Pool::RemoveConflicts(const FullBlock& block)
+{
+	const size_t size = m_transactions.size();
+
+	std::unordered_set<Commitment> removedOutputs;
+	RemoveConflicts(block, removedOutputs);
+
+	return size - m_transactions.size();
+}
+
+void Pool::RemoveConflicts(const FullBlock& block, std::unordered_set<Commitment>& removedOutputs)
+{
+	std::unordered_map<Hash, EntryIter> conflicts;
+	auto addConflicts = [&conflicts](auto range) {
+		for (auto iter = range.first; iter != range.second; iter++)
 		{
-			transactions.push_back(txPoolEntry.GetTransaction());
+			conflicts.emplace(iter->second->GetTransaction()->GetHash(), iter->second);
 		}
+	};
+
+	for (const TransactionKernel& kernel : block.GetKernels())
+	{
+		addConflicts(m_txsByKernelHash.equal_range(kernel.GetHash()));
 	}
 
-	return transactions;
+	for (const TransactionInput& input : block.GetInputs())
+	{
+		addConflicts(m_txsByInput.equal_range(input.GetCommitment()));
+	}
+
+	for (const TransactionOutput& output : block.GetOutputs())
+	{
+		addConflicts(m_txsByOutput.equal_range(output.GetCommitment()));
+	}
+
+	for (auto& conflict : conflicts)
+	{
+		Erase(conflict.second, removedOutputs);
+	}
 }
 
-void Pool::RemoveTransaction(const Transaction& transaction)
+// Removes any txs that spend the same input as a tx in the base pool.
+// This walks every input in the pool, so it's only used for the stempool, which is small.
+void Pool::RemoveConflicts(const Pool& basePool, std::unordered_set<Commitment>& removedOutputs)
+{
+	std::unordered_map<Hash, EntryIter> conflicts;
+	for (const auto& input : m_txsByInput)
+	{
+		if (basePool.m_txsByInput.find(input.first) != basePool.m_txsByInput.end())
+		{
+			conflicts.emplace(input.second->GetTransaction()->GetHash(), input.second);
+		}
+	}
+
+	for (auto& conflict : conflicts)
+	{
+		Erase(conflict.second, removedOutputs);
+	}
+}
+
+// Rechecks every input and output of every tx against the UTXO set.
+void Pool::RemoveUnspendable(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const Pool* pBasePool,
+	std::unordered_set<Commitment>& removedOutputs)
 {
 	auto iter = m_transactions.begin();
 	while (iter != m_transactions.end())
 	{
-		if (transaction == *iter->GetTransaction())
+		auto next = std::next(iter);
+
+		const Transaction& transaction = *iter->GetTransaction();
+		const bool inputsSpendable = std::all_of(
+			transaction.GetInputs().cbegin(), transaction.GetInputs().cend(),
+			[this, &pBlockDB, &pTxHashSet, pBasePool](const TransactionInput& input) {
+				return IsSpendable(pBlockDB, pTxHashSet, pBasePool, input);
+			}
+		);
+		const bool outputsUnique = std::all_of(
+			transaction.GetOutputs().cbegin(), transaction.GetOutputs().cend(),
+			[&pBlockDB, &pTxHashSet](const TransactionOutput& output) { return pTxHashSet->IsUnique(pBlockDB, output); }
+		);
+
+		if (!inputsSpendable || !outputsUnique)
 		{
-			m_transactions.erase(iter);
-			break;
+			Erase(iter, removedOutputs);
 		}
 
-		++iter;
+		iter = next;
 	}
 }
 
-// Quick reconciliation step - we can evict any txs in the pool where
-// inputs or kernels intersect with the block.
-void Pool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block, TransactionPtr pMemPoolAggTx)
+// Removes the txs that spend any of the given outputs, unless the output is still available.
+// Removing a tx can make its own dependents unspendable, so this keeps going until nothing else is removed.
+void Pool::RemoveDependents(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const Pool* pBasePool,
+	const std::unordered_set<Commitment>& spentOutputs,
+	std::unordered_set<Commitment>& removedOutputs)
 {
-	std::vector<TransactionPtr> filteredTransactions;
-	std::unordered_map<Hash, TxPoolEntry> filteredEntriesByHash;
-
-	// Filter txs in the pool based on the latest block.
-	// Reject any txs where we see a matching tx kernel in the block.
-	// Also reject any txs where we see a conflicting tx,
-	// where an input is spent in a different tx.
-	for (auto& txPoolEntry : m_transactions)
+	std::vector<Commitment> outputsToCheck(spentOutputs.cbegin(), spentOutputs.cend());
+	while (!outputsToCheck.empty())
 	{
-		if (!ShouldEvict(*txPoolEntry.GetTransaction(), block))
+		const Commitment commitment = outputsToCheck.back();
+		outputsToCheck.pop_back();
+
+		std::vector<EntryIter> dependents;
+		auto range = m_txsByInput.equal_range(commitment);
+		for (auto iter = range.first; iter != range.second; iter++)
 		{
-			filteredTransactions.push_back(txPoolEntry.GetTransaction());
-			filteredEntriesByHash.insert(std::pair<Hash, TxPoolEntry>(txPoolEntry.GetTransaction()->GetHash(), txPoolEntry));
+			dependents.push_back(iter->second);
+		}
+
+		for (const EntryIter& dependent : dependents)
+		{
+			const std::vector<TransactionInput>& inputs = dependent->GetTransaction()->GetInputs();
+			auto inputIter = std::find_if(
+				inputs.cbegin(), inputs.cend(),
+				[&commitment](const TransactionInput& input) { return input.GetCommitment() == commitment; }
+			);
+
+			if (!IsSpendable(pBlockDB, pTxHashSet, pBasePool, *inputIter))
+			{
+				for (const TransactionOutput& output : dependent->GetTransaction()->GetOutputs())
+				{
+					outputsToCheck.push_back(output.GetCommitment());
+				}
+
+				Erase(dependent, removedOutputs);
+			}
 		}
 	}
+}
 
-	m_transactions.clear();
+// An input is spendable if it spends an output of a tx in this pool or the base pool, or an output in the UTXO set.
+bool Pool::IsSpendable(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const Pool* pBasePool,
+	const TransactionInput& input) const
+{
+	const Commitment& commitment = input.GetCommitment();
+	if (m_txsByOutput.find(commitment) != m_txsByOutput.end())
+	{
+		return true;
+	}
 
-	std::vector<TransactionPtr> validTransactions = ValidTransactionFinder::FindValidTransactions(pBlockDB, pTxHashSet, filteredTransactions, pMemPoolAggTx);
-	for (auto& pTransaction : validTransactions)
+	if (pBasePool != nullptr && pBasePool->m_txsByOutput.find(commitment) != pBasePool->m_txsByOutput.end())
 	{
-		const TxPoolEntry& txPoolEntry = filteredEntriesByHash.at(pTransaction->GetHash());
-		m_transactions.push_back(txPoolEntry);
+		return true;
 	}
+
+	return pTxHashSet != nullptr && pTxHashSet->IsUnspent(pBlockDB, input);
 }
 
 void Pool::ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
 {
-	for (auto& txPoolEntry : m_transactions)
+	for (auto& pTransaction : transactions)
 	{
-		for (auto& transaction : transactions)
+		auto iter = m_txsByHash.find(pTransaction->GetHash());
+		if (iter != m_txsByHash.end() && iter->second->GetStatus() != status)
 		{
-			if (txPoolEntry.GetTransaction() == transaction)
+			const EntryIter entryIter = iter->second;
+			m_txsByStatus.erase(std::make_pair(entryIter->GetStatus(), entryIter->GetSequence()));
+			entryIter->SetStatus(status);
+			m_txsByStatus.emplace(std::make_pair(status, entryIter->GetSequence()), entryIter);
+		}
+	}
+}
+
+void Pool::ForEachParent(const TxPoolEntry& entry, const std::function<void(const EntryIter)>& callback) const
+{
+	for (const TransactionInput& input : entry.GetTransaction()->GetInputs())
+	{
+		auto range = m_txsByOutput.equal_range(input.GetCommitment());
+		for (auto iter = range.first; iter != range.second; iter++)
+		{
+			callback(iter->second);
+		}
+	}
+}
+
+void Pool::ForEachChild(const TxPoolEntry& entry, const std::function<void(const EntryIter)>& callback) const
+{
+	for (const TransactionOutput& output : entry.GetTransaction()->GetOutputs())
+	{
+		auto range = m_txsByInput.equal_range(output.GetCommitment());
+		for (auto iter = range.first; iter != range.second; iter++)
+		{
+			callback(iter->second);
+		}
+	}
+}
+
+std::vector<Pool::EntryIter> Pool::GetDescendants(const EntryIter iter) const
+{
+	std::vector<EntryIter> descendants;
+	std::unordered_set<const TxPoolEntry*> visited({ &*iter });
+
+	std::vector<EntryIter> toVisit({ iter });
+	while (!toVisit.empty())
+	{
+		const EntryIter next = toVisit.back();
+		toVisit.pop_back();
+
+		ForEachChild(*next, [&descendants, &visited, &toVisit](const EntryIter child) {
+			if (visited.insert(&*child).second)
 			{
-				txPoolEntry.SetStatus(status);
-				break;
+				descendants.push_back(child);
+				toVisit.push_back(child);
 			}
-		}
+		});
 	}
+
+	return descendants;
 }
 
-bool Pool::ShouldEvict(const Transaction& transaction, const FullBlock& block) const
+// Recalculates the fee and weight of the tx's package, and moves it to its new place in the fee rate index.
+void Pool::UpdatePackage(const EntryIter iter)
 {
-	const std::vector<TransactionInput>& blockInputs = block.GetInputs();
-	for (const TransactionInput& input : transaction.GetInputs())
+	m_txsByFeeRate.erase(FeeRateKey(*iter));
+
+	uint64_t fee = iter->GetFee();
+	uint64_t weight = iter->GetWeight();
+	std::unordered_set<const TxPoolEntry*> visited({ &*iter });
+
+	std::vector<EntryIter> toVisit({ iter });
+	while (!toVisit.empty())
 	{
-		if (std::find(blockInputs.begin(), blockInputs.end(), input) != blockInputs.end())
+		const EntryIter next = toVisit.back();
+		toVisit.pop_back();
+
+		ForEachParent(*next, [&fee, &weight, &visited, &toVisit](const EntryIter parent) {
+			if (visited.insert(&*parent).second)
+			{
+				fee += parent->GetFee();
+				weight += parent->GetWeight();
+				toVisit.push_back(parent);
+			}
+		});
+	}
+
+	iter->SetPackage(fee, weight);
+	m_txsByFeeRate.emplace(FeeRateKey(*iter), iter);
+}
+
+std::vector<TransactionPtr> Pool::GetBlockTemplate(const uint64_t maxWeight) const
+{
+	std::vector<TransactionPtr> transactions;
+	uint64_t totalWeight = 0;
+	std::unordered_set<const TxPoolEntry*> picked;
+	std::unordered_set<Commitment> spentInputs;
+
+	// Once some of a tx's ancestors are picked, the rest of its package has a different fee rate.
+	// Rather than updating every descendant after each pick, packages are rescored when they reach the front.
+	std::map<FeeRateKey, EntryIter> candidates(m_txsByFeeRate);
+	while (!candidates.empty())
+	{
+		const FeeRateKey key = candidates.begin()->first;
+		const EntryIter iter = candidates.begin()->second;
+		candidates.erase(candidates.begin());
+
+		if (picked.count(&*iter) > 0)
+		{
+			continue;
+		}
+
+		std::vector<EntryIter> package({ iter });
+		uint64_t fee = iter->GetFee();
+		uint64_t weight = iter->GetWeight();
+		std::unordered_set<const TxPoolEntry*> visited({ &*iter });
+		for (size_t i = 0; i < package.size(); i++)
+		{
+			ForEachParent(*package[i], [&](const EntryIter parent) {
+				if (picked.count(&*parent) == 0 && visited.insert(&*parent).second)
+				{
+					fee += parent->GetFee();
+					weight += parent->GetWeight();
+					package.push_back(parent);
+				}
+			});
+		}
+
+		const double feeRate = (double)fee / (double)(std::max)(weight, (uint64_t)1);
+		if (feeRate != key.feeRate)
 		{
-			return true;
+			candidates.emplace(FeeRateKey(feeRate, key.sequence), iter);
+			continue;
 		}
+
+		if (totalWeight + weight > maxWeight)
+		{
+			continue;
+		}
+
+		// The pool may contain txs that double-spend each other, but only one of them can go in the block.
+		const bool conflicts = std::any_of(package.cbegin(), package.cend(), [&spentInputs](const EntryIter& entry) {
+			const std::vector<TransactionInput>& inputs = entry->GetTransaction()->GetInputs();
+			return std::any_of(inputs.cbegin(), inputs.cend(), [&spentInputs](const TransactionInput& input) {
+				return spentInputs.count(input.GetCommitment()) > 0;
+			});
+		});
+		if (conflicts)
+		{
+			continue;
+		}
+
+		// Ancestors were added to the pool before their descendants.
+		std::sort(package.begin(), package.end(), [](const EntryIter& lhs, const EntryIter& rhs) {
+			return lhs->GetSequence() < rhs->GetSequence();
+		});
+
+		for (const EntryIter& entry : package)
+		{
+			picked.insert(&*entry);
+			transactions.push_back(entry->GetTransaction());
+			for (const TransactionInput& input : entry->GetTransaction()->GetInputs())
+			{
+				spentInputs.insert(input.GetCommitment());
+			}
+		}
+
+		totalWeight += weight;
 	}
 
-	const std::vector<TransactionKernel>& blockKernels = block.GetKernels();
-	for (const TransactionKernel& kernel : transaction.GetKernels())
+	return transactions;
+}
+
+size_t Pool::EvictLowestFeeRate(const size_t maxSize)
+{
+	size_t numEvicted = 0;
+	while (m_transactions.size() > maxSize)
 	{
-		if (std::find(blockKernels.begin(), blockKernels.end(), kernel) != blockKernels.end())
+		const EntryIter lowest = std::prev(m_txsByFeeRate.end())->second;
+		LOG_DEBUG_F("Evicting transaction {} with fee rate {}", lowest->GetTransaction()->GetHash(), lowest->GetPackageFeeRate());
+
+		// Its descendants can't be mined without it.
+		const std::vector<EntryIter> descendants = GetDescendants(lowest);
+		for (const EntryIter& descendant : descendants)
 		{
-			return true;
+			Erase(descendant);
 		}
+
+		Erase(lowest);
+		numEvicted += descendants.size() + 1;
 	}
 
-	return false;
+	return numEvicted;
 }
 
 TransactionPtr Pool::Aggregate() const
@@ -208,11 +584,36 @@ TransactionPtr Pool::Aggregate() const
 
 	LOG_INFO_F("Aggregating {} transactions", m_transactions.size());
 
-	std::vector<TransactionPtr> transactions;
+	std::vector<TransactionInput> inputs;
+	std::vector<TransactionOutput> outputs;
+	std::vector<TransactionKernel> kernels;
 	for (const TxPoolEntry& entry : m_transactions)
 	{
-		transactions.push_back(entry.GetTransaction());
+		const Transaction& transaction = *entry.GetTransaction();
+
+		std::copy_if(
+			transaction.GetInputs().cbegin(),
+			transaction.GetInputs().cend(),
+			std::back_inserter(inputs),
+			[this](const TransactionInput& input) { return !CreatesOutput(input.GetCommitment()); }
+		);
+
+		std::copy_if(
+			transaction.GetOutputs().cbegin(),
+			transaction.GetOutputs().cend(),
+			std::back_inserter(outputs),
+			[this](const TransactionOutput& output) { return !SpendsOutput(output.GetCommitment()); }
+		);
+
+		kernels.insert(kernels.end(), transaction.GetKernels().cbegin(), transaction.GetKernels().cend());
 	}
 
-	return TransactionUtil::Aggregate(transactions);
+	std::sort(inputs.begin(), inputs.end(), SortInputsByHash);
+	std::sort(outputs.begin(), outputs.end(), SortOutputsByHash);
+	std::sort(kernels.begin(), kernels.end(), SortKernelsByHash);
+
+	return std::make_shared<Transaction>(
+		BlindingFactor(m_totalOffset),
+		TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels))
+	);
 }
\ No newline at end of file
@@ -10,7 +10,13 @@
 #include <Config/Config.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Crypto/Hash.h>
+#include <Crypto/Commitment.h>
+#include <functional>
+#include <list>
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 class Pool
 {
@@ -21,12 +27,25 @@ public:
 	void AddTransaction(TransactionPtr pTransaction, const EDandelionStatus status);
 	bool ContainsTransaction(const Transaction& transaction) const;
 	void RemoveTransaction(const Transaction& transaction);
-	void ReconcileBlock(
+
+	//
+	// Removes the txs that conflict with the block, along with any txs that spent their outputs and no longer can.
+	// Signatures and proofs were verified when the txs were added, so only the inputs of txs that spent a removed output
+	// are rechecked, and only against the UTXO set. If the block doesn't build on the last one reconciled,
+	// a reorg may have removed outputs from the UTXO set, so every tx is rechecked instead.
+	//
+	// pBasePool is a pool whose txs can be spent by this pool's txs (ie. the mempool, for the stempool),
+	// and removedBaseOutputs are the outputs of the txs that were just removed from it.
+	// Returns the outputs of the txs that were removed.
+	//
+	std::unordered_set<Commitment> ReconcileBlock(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet,
 		const FullBlock& block,
-		TransactionPtr pMemPoolAggTx
+		const Pool* pBasePool,
+		const std::unordered_set<Commitment>& removedBaseOutputs
 	);
+	size_t RemoveConflicts(const FullBlock& block);
 	void ChangeStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status);
 
 	std::vector<TransactionPtr> GetTransactionsByShortId(
@@ -36,14 +55,122 @@ public:
 	) const;
 	std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const;
 	TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const;
+	TransactionPtr FindTransactionByHash(const Hash& txHash) const;
+
+	//
+	// Returns the txs with the given status, in the order they were added.
+	//
 	std::vector<TransactionPtr> FindTransactionsByStatus(const EDandelionStatus status) const;
-	std::vector<TransactionPtr> GetExpiredTransactions(const uint16_t embargoSeconds) const;
 
+	//
+	// Greedily picks the txs with the highest package fee rates that fit within the weight.
+	// A tx is only picked along with its ancestors in the pool, which are returned before it.
+	//
+	std::vector<TransactionPtr> GetBlockTemplate(const uint64_t maxWeight) const;
+
+	//
+	// Evicts the txs with the lowest package fee rates, along with their descendants, until at most maxSize txs remain.
+	// Returns the number of txs evicted.
+	//
+	size_t EvictLowestFeeRate(const size_t maxSize);
+
+	//
+	// The pool's indexes double as a running aggregate of every tx in it, so conflicts with the pool
+	// can be checked without building an aggregate tx.
+	//
+	bool SpendsOutput(const Commitment& commitment) const { return m_txsByInput.find(commitment) != m_txsByInput.end(); }
+	bool CreatesOutput(const Commitment& commitment) const { return m_txsByOutput.find(commitment) != m_txsByOutput.end(); }
+	bool ContainsKernel(const Hash& kernelHash) const { return m_txsByKernelHash.find(kernelHash) != m_txsByKernelHash.end(); }
+
+	// The sum of the offsets of every tx in the pool.
+	const BlindingFactor& GetTotalOffset() const noexcept { return m_totalOffset; }
+
+	//
+	// Builds a single tx out of every tx in the pool, with the outputs spent within the pool cut through.
+	//
 	TransactionPtr Aggregate() const;
-	void Clear() { m_transactions.clear(); }
+	size_t Size() const noexcept { return m_transactions.size(); }
+	void Clear();
 
 private:
-	bool ShouldEvict(const Transaction& transaction, const FullBlock& block) const;
+	using EntryIter = std::list<TxPoolEntry>::iterator;
+
+	void Erase(const EntryIter iter);
+	void Erase(const EntryIter iter, std::unordered_set<Commitment>& removedOutputs);
+	void RemoveConflicts(const FullBlock& block, std::unordered_set<Commitment>& removedOutputs);
+	void RemoveConflicts(const Pool& basePool, std::unordered_set<Commitment>& removedOutputs);
+	void RemoveUnspendable(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const Pool* pBasePool,
+		std::unordered_set<Commitment>& removedOutputs
+	);
+	void RemoveDependents(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const Pool* pBasePool,
+		const std::unordered_set<Commitment>& spentOutputs,
+		std::unordered_set<Commitment>& removedOutputs
+	);
+	void ForEachParent(const TxPoolEntry& entry, const std::function<void(const EntryIter)>& callback) const;
+	void ForEachChild(const TxPoolEntry& entry, const std::function<void(const EntryIter)>& callback) const;
+	std::vector<EntryIter> GetDescendants(const EntryIter iter) const;
+	void UpdatePackage(const EntryIter iter);
+
+	bool IsSpendable(
+		std::shared_ptr<const IBlockDB> pBlockDB,
+		ITxHashSetConstPtr pTxHashSet,
+		const Pool* pBasePool,
+		const TransactionInput& input
+	) const;
+
+	template<class KEY>
+	static void EraseFromIndex(std::unordered_multimap<KEY, EntryIter>& index, const KEY& key, const EntryIter iter)
+	{
+		auto range = index.equal_range(key);
+		for (auto indexIter = range.first; indexIter != range.second; indexIter++)
+		{
+			if (indexIter->second == iter)
+			{
+				index.erase(indexIter);
+				return;
+			}
+		}
+	}
+
+	// Kept in the order they were added, since a transaction may spend the outputs of an earlier one.
+	std::list<TxPoolEntry> m_transactions;
+
+	// Nothing stops two transactions in the pool from sharing an input, kernel, or output, so those indexes allow duplicates.
+	std::unordered_map<Hash, EntryIter> m_txsByHash;
+	std::unordered_multimap<Hash, EntryIter> m_txsByKernelHash;
+	std::unordered_multimap<Commitment, EntryIter> m_txsByInput;
+	std::unordered_multimap<Commitment, EntryIter> m_txsByOutput;
+
+	struct FeeRateKey
+	{
+		FeeRateKey(const double feeRate_, const uint64_t sequence_) : feeRate(feeRate_), sequence(sequence_) { }
+		FeeRateKey(const TxPoolEntry& entry) : FeeRateKey(entry.GetPackageFeeRate(), entry.GetSequence()) { }
+
+		// Highest package fee rate first. Ties go to the tx that was added first.
+		bool operator<(const FeeRateKey& other) const
+		{
+			return feeRate != other.feeRate ? feeRate > other.feeRate : sequence < other.sequence;
+		}
+
+		double feeRate;
+		uint64_t sequence;
+	};
+
+	std::map<FeeRateKey, EntryIter> m_txsByFeeRate;
+
+	// Kept up to date as txs are added and removed, so it never needs to be summed from scratch.
+	BlindingFactor m_totalOffset;
+
+	// Ordered by status, and then by sequence.
+	std::map<std::pair<EDandelionStatus, uint64_t>, EntryIter> m_txsByStatus;
+	uint64_t m_nextSequence = 0;
 
-	std::vector<TxPoolEntry> m_transactions;
+	// The hash of the last block reconciled, used to detect reorgs.
+	Hash m_lastBlockHash;
 };
\ No newline at end of file
@@ -4,10 +4,11 @@
 #include <Core/Util/TransactionUtil.h>
 #include <Database/BlockDb.h>
 #include <Consensus/BlockTime.h>
-#include <Crypto/CSPRNG.h>
 #include <Common/Logger.h>
 #include <Core/Util/FeeUtil.h>
 #include <Core/Validation/TransactionValidator.h>
+#include <Common/Util/ThreadUtil.h>
+#include <algorithm>
 
 std::vector<TransactionPtr> TransactionPool::GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const
 {
@@ -23,40 +24,133 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 	const EPoolType poolType,
 	const BlockHeader& lastConfirmedBlock)
 {
+	return AddTransactions(pBlockDB, pTxHashSet, { pTransaction }, poolType, lastConfirmedBlock).front();
+}
+
+std::vector<EAddTransactionStatus> TransactionPool::AddTransactions(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	const std::vector<TransactionPtr>& transactions,
+	const EPoolType poolType,
+	const BlockHeader& lastConfirmedBlock)
+{
+	std::vector<EAddTransactionStatus> statuses(transactions.size(), EAddTransactionStatus::ADDED);
+
+	if (poolType == EPoolType::MEMPOOL)
+	{
+		std::shared_lock<std::shared_mutex> readLock(m_mutex);
+		for (size_t i = 0; i < transactions.size(); i++)
+		{
+			if (m_memPool.ContainsTransaction(*transactions[i]))
+			{
+				LOG_TRACE_F("Duplicate transaction ({})", *transactions[i]);
+				statuses[i] = EAddTransactionStatus::DUPL_TX;
+			}
+		}
+	}
+
+	// Everything that doesn't depend on the UTXO set or the pool contents is checked without holding the lock.
+	std::vector<size_t> indices;
+	std::vector<TransactionPtr> transactionsToValidate;
+	for (size_t i = 0; i < transactions.size(); i++)
+	{
+		if (statuses[i] == EAddTransactionStatus::ADDED)
+		{
+			statuses[i] = CheckPolicy(*transactions[i], lastConfirmedBlock);
+			if (statuses[i] == EAddTransactionStatus::ADDED)
+			{
+				indices.push_back(i);
+				transactionsToValidate.push_back(transactions[i]);
+			}
+		}
+	}
+
+	const std::vector<bool> valid = ValidateTransactions(transactionsToValidate);
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		if (!valid[i])
+		{
+			statuses[indices[i]] = EAddTransactionStatus::TX_INVALID;
+		}
+	}
+
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
-	if (poolType == EPoolType::MEMPOOL && m_memPool.ContainsTransaction(*pTransaction))
+	for (size_t i = 0; i < transactions.size(); i++)
 	{
-		LOG_TRACE_F("Duplicate transaction ({})", *pTransaction);
-		return EAddTransactionStatus::DUPL_TX;
+		if (statuses[i] == EAddTransactionStatus::ADDED)
+		{
+			statuses[i] = AddValidTransaction(pBlockDB, pTxHashSet, transactions[i], poolType);
+		}
 	}
 
+	return statuses;
+}
+
+EAddTransactionStatus TransactionPool::CheckPolicy(const Transaction& transaction, const BlockHeader& lastConfirmedBlock) const
+{
 	// Verify fee meets minimum
 	const uint64_t feeBase = 1000000; // TODO: Read from config.
-	if (FeeUtil::CalculateMinimumFee(feeBase, *pTransaction) > FeeUtil::CalculateActualFee(*pTransaction))
+	if (FeeUtil::CalculateMinimumFee(feeBase, transaction) > FeeUtil::CalculateActualFee(transaction))
 	{
-		LOG_WARNING_F("Fee too low for transaction ({})", *pTransaction);
+		LOG_WARNING_F("Fee too low for transaction ({})", transaction);
 		return EAddTransactionStatus::LOW_FEE;
 	}
-	
+
 	// Verify lock time
-	for (const TransactionKernel& kernel : pTransaction->GetKernels())
+	for (const TransactionKernel& kernel : transaction.GetKernels())
 	{
 		if (kernel.GetLockHeight() > (lastConfirmedBlock.GetHeight() + 1))
 		{
-			LOG_INFO_F("Invalid lock height ({})", *pTransaction);
+			LOG_INFO_F("Invalid lock height ({})", transaction);
 			return EAddTransactionStatus::NOT_ADDED;
 		}
 	}
 
-	try
+	return EAddTransactionStatus::ADDED;
+}
+
+std::vector<bool> TransactionPool::ValidateTransactions(const std::vector<TransactionPtr>& transactions)
+{
+	// Batch verification gets cheaper per proof as the batch grows, so small batches aren't split up.
+	// Chunks write to disjoint ranges, which isn't safe for std::vector<bool>.
+	std::vector<uint8_t> results(transactions.size(), 0);
+	ThreadUtil::ParallelFor(transactions.size(), MIN_TXS_PER_THREAD, [&transactions, &results](const size_t begin, const size_t end)
 	{
-		TransactionValidator().Validate(*pTransaction);
+		const std::vector<TransactionPtr> chunkTransactions(transactions.cbegin() + begin, transactions.cbegin() + end);
+
+		try
+		{
+			const std::vector<bool> chunkResults = TransactionValidator().ValidateBatch(chunkTransactions);
+			std::copy(chunkResults.cbegin(), chunkResults.cend(), results.begin() + begin);
+		}
+		catch (std::exception& e)
+		{
+			LOG_ERROR_F("Exception thrown while validating transactions: {}", e.what());
+		}
+	});
+
+	return std::vector<bool>(results.cbegin(), results.cend());
+}
+
+EAddTransactionStatus TransactionPool::AddValidTransaction(
+	std::shared_ptr<const IBlockDB> pBlockDB,
+	ITxHashSetConstPtr pTxHashSet,
+	TransactionPtr pTransaction,
+	const EPoolType poolType)
+{
+	// Another thread may have added it since the duplicate check.
+	if (poolType == EPoolType::MEMPOOL && m_memPool.ContainsTransaction(*pTransaction))
+	{
+		LOG_TRACE_F("Duplicate transaction ({})", *pTransaction);
+		return EAddTransactionStatus::DUPL_TX;
 	}
-	catch (std::exception& e)
+
+	// Stem txs that are already in the stempool were already relayed, so they mustn't be relayed again.
+	if (poolType == EPoolType::STEMPOOL && m_stemPool.ContainsTransaction(*pTransaction))
 	{
-		LOG_WARNING_F("Invalid transaction ({}). Error: ({})", *pTransaction, e.what());
-		return EAddTransactionStatus::TX_INVALID;
+		LOG_TRACE_F("Duplicate stem transaction ({})", *pTransaction);
+		return EAddTransactionStatus::DUPL_TX;
 	}
 
 	// Check all inputs are in current UTXO set & all outputs unique in current UTXO set
@@ -70,20 +164,18 @@ EAddTransactionStatus TransactionPool::AddTransaction(
 	{
 		m_memPool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
 		m_stemPool.RemoveTransaction(*pTransaction);
+
+		m_memPool.EvictLowestFeeRate(MAX_MEMPOOL_SIZE);
+		if (!m_memPool.ContainsTransaction(*pTransaction))
+		{
+			LOG_INFO_F("Mempool full. Fee rate too low for transaction ({})", *pTransaction);
+			return EAddTransactionStatus::LOW_FEE;
+		}
 	}
 	else if (poolType == EPoolType::STEMPOOL)
 	{
-		const uint8_t random = (uint8_t)CSPRNG::GenerateRandom(0, 100);
-		if (random <= m_config.GetNodeConfig().GetDandelion().GetStemProbability())
-		{
-			LOG_INFO_F("Stemming transaction ({})", *pTransaction);
-			m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_STEM);
-		}
-		else
-		{
-			LOG_INFO_F("Fluffing transaction ({})", *pTransaction);
-			m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_FLUFF);
-		}
+		// Dandelion decides whether to stem or fluff it.
+		m_stemPool.AddTransaction(pTransaction, EDandelionStatus::TO_STEM);
 	}
 
 	return EAddTransactionStatus::ADDED;
@@ -109,46 +201,29 @@ TransactionPtr TransactionPool::FindTransactionByKernelHash(const Hash& kernelHa
 	return pTransaction;
 }
 
+std::vector<TransactionPtr> TransactionPool::GetBlockTemplate(const uint64_t maxWeight) const
+{
+	std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+	return m_memPool.GetBlockTemplate(maxWeight);
+}
+
 void TransactionPool::ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block)
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
 	// First reconcile the txpool.
-	m_memPool.ReconcileBlock(pBlockDB, pTxHashSet, block, nullptr);
+	const std::unordered_set<Commitment> removedOutputs = m_memPool.ReconcileBlock(pBlockDB, pTxHashSet, block, nullptr, {});
 
 	// Now reconcile our stempool, accounting for the updated txpool txs.
-	auto pMemPoolAggTx = m_memPool.Aggregate();
-	m_stemPool.ReconcileBlock(pBlockDB, pTxHashSet, block, pMemPoolAggTx);
+	m_stemPool.ReconcileBlock(pBlockDB, pTxHashSet, block, &m_memPool, removedOutputs);
 }
 
-TransactionPtr TransactionPool::GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet)
+void TransactionPool::ChangeStemStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status)
 {
 	std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
-	const std::vector<TransactionPtr> transactionsToStem = m_stemPool.FindTransactionsByStatus(EDandelionStatus::TO_STEM);
-	if (transactionsToStem.empty())
-	{
-		return nullptr;
-	}
-
-	auto pMemPoolAggTx = m_memPool.Aggregate();
-
-	std::vector<TransactionPtr> validTransactionsToStem = ValidTransactionFinder::FindValidTransactions(
-		pBlockDB,
-		pTxHashSet,
-		transactionsToStem,
-		pMemPoolAggTx
-	);
-	if (validTransactionsToStem.empty())
-	{
-		return nullptr;
-	}
-
-	TransactionPtr pTransactionToStem = TransactionUtil::Aggregate(validTransactionsToStem);
-
-	m_stemPool.ChangeStatus(validTransactionsToStem, EDandelionStatus::STEMMED);
-
-	return pTransactionToStem;
+	m_stemPool.ChangeStatus(transactions, status);
 }
 
 TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet)
@@ -161,13 +236,11 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 		return nullptr;
 	}
 
-	auto pMemPoolAggTx = m_memPool.Aggregate();
-
 	std::vector<TransactionPtr> validTransactionsToFluff = ValidTransactionFinder::FindValidTransactions(
 		pBlockDB,
 		pTxHashSet,
 		transactionsToFluff,
-		pMemPoolAggTx
+		m_memPool
 	);
 	if (validTransactionsToFluff.empty())
 	{
@@ -182,15 +255,16 @@ TransactionPtr TransactionPool::GetTransactionToFluff(std::shared_ptr<const IBlo
 		m_stemPool.RemoveTransaction(*pTransaction);
 	}
 
+	m_memPool.EvictLowestFeeRate(MAX_MEMPOOL_SIZE);
+
 	return pTransactionToFluff;
 }
 
-std::vector<TransactionPtr> TransactionPool::GetExpiredTransactions() const
+TransactionPtr TransactionPool::GetStemTransaction(const Hash& txHash) const
 {
 	std::shared_lock<std::shared_mutex> readLock(m_mutex);
 
-	const uint16_t embargoSeconds = m_config.GetNodeConfig().GetDandelion().GetEmbargoSeconds() + (uint16_t)CSPRNG::GenerateRandom(0, 30);
-	return m_stemPool.GetExpiredTransactions(embargoSeconds);
+	return m_stemPool.FindTransactionByHash(txHash);
 }
 
 namespace TxPoolAPI
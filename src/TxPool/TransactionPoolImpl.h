@@ -18,16 +18,28 @@ public:
 
 	std::vector<TransactionPtr> GetTransactionsByShortId(const Hash& hash, const uint64_t nonce, const std::set<ShortId>& missingShortIds) const final;
 	EAddTransactionStatus AddTransaction(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, TransactionPtr pTransaction, const EPoolType poolType, const BlockHeader& lastConfirmedBlock) final;
+	std::vector<EAddTransactionStatus> AddTransactions(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const std::vector<TransactionPtr>& transactions, const EPoolType poolType, const BlockHeader& lastConfirmedBlock) final;
 	std::vector<TransactionPtr> FindTransactionsByKernel(const std::set<TransactionKernel>& kernels) const final;
 	TransactionPtr FindTransactionByKernelHash(const Hash& kernelHash) const final;
 	void ReconcileBlock(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, const FullBlock& block) final;
+	std::vector<TransactionPtr> GetBlockTemplate(const uint64_t maxWeight) const final;
 
 	// Dandelion
-	TransactionPtr GetTransactionToStem(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) final;
+	void ChangeStemStatus(const std::vector<TransactionPtr>& transactions, const EDandelionStatus status) final;
 	TransactionPtr GetTransactionToFluff(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet) final;
-	std::vector<TransactionPtr> GetExpiredTransactions() const final;
+	TransactionPtr GetStemTransaction(const Hash& txHash) const final;
 
 private:
+	// The minimum number of transactions each validation thread gets.
+	static constexpr size_t MIN_TXS_PER_THREAD = 8;
+
+	// Once the mempool holds more than this many transactions, those with the lowest fee rates are evicted.
+	static constexpr size_t MAX_MEMPOOL_SIZE = 50'000;
+
+	EAddTransactionStatus CheckPolicy(const Transaction& transaction, const BlockHeader& lastConfirmedBlock) const;
+	static std::vector<bool> ValidateTransactions(const std::vector<TransactionPtr>& transactions);
+	EAddTransactionStatus AddValidTransaction(std::shared_ptr<const IBlockDB> pBlockDB, ITxHashSetConstPtr pTxHashSet, TransactionPtr pTransaction, const EPoolType poolType);
+
 	const Config& m_config;
 	mutable std::shared_mutex m_mutex;
 
@@ -2,6 +2,8 @@
 
 #include <Core/Models/Transaction.h>
 #include <TxPool/DandelionStatus.h>
+#include <Core/Util/FeeUtil.h>
+#include <Consensus/BlockWeight.h>
 #include <ctime>
 
 class TxPoolEntry
@@ -10,8 +12,15 @@ public:
 	//
 	// Constructors
 	//
-	TxPoolEntry(TransactionPtr pTransaction, const EDandelionStatus status, const std::time_t timestamp)
-		: m_pTransaction(pTransaction), m_status(status), m_timestamp(timestamp)
+	TxPoolEntry(TransactionPtr pTransaction, const EDandelionStatus status, const std::time_t timestamp, const uint64_t sequence)
+		: m_pTransaction(pTransaction),
+		m_status(status),
+		m_timestamp(timestamp),
+		m_sequence(sequence),
+		m_fee(FeeUtil::CalculateActualFee(*pTransaction)),
+		m_weight(Consensus::CalculateWeight(pTransaction->GetInputs().size(), pTransaction->GetOutputs().size(), pTransaction->GetKernels().size())),
+		m_packageFee(m_fee),
+		m_packageWeight(m_weight)
 	{
 
 	}
@@ -40,14 +49,28 @@ public:
 	inline TransactionPtr GetTransaction() const { return m_pTransaction; }
 	inline EDandelionStatus GetStatus() const { return m_status; }
 	inline std::time_t GetTimestamp() const { return m_timestamp; }
+	inline uint64_t GetSequence() const { return m_sequence; }
+	inline uint64_t GetFee() const { return m_fee; }
+	inline uint64_t GetWeight() const { return m_weight; }
+
+	// The package is the transaction along with its unconfirmed ancestors, which must all be mined together.
+	inline uint64_t GetPackageFee() const { return m_packageFee; }
+	inline uint64_t GetPackageWeight() const { return m_packageWeight; }
+	inline double GetPackageFeeRate() const { return (double)m_packageFee / (double)(std::max)(m_packageWeight, (uint64_t)1); }
 
 	//
 	// Setters
 	//
 	inline void SetStatus(const EDandelionStatus status) { m_status = status; }
+	inline void SetPackage(const uint64_t fee, const uint64_t weight) { m_packageFee = fee; m_packageWeight = weight; }
 
 private:
 	TransactionPtr m_pTransaction;
 	EDandelionStatus m_status;
 	std::time_t m_timestamp;
+	uint64_t m_sequence;
+	uint64_t m_fee;
+	uint64_t m_weight;
+	uint64_t m_packageFee;
+	uint64_t m_packageWeight;
 };
\ No newline at end of file
@@ -1,63 +1,86 @@
 #include "ValidTransactionFinder.h"
 
-#include <Core/Util/TransactionUtil.h>
-#include <Core/Validation/TransactionValidator.h>
-#include <Core/Validation/KernelSumValidator.h>
-#include <Common/Util/FunctionalUtil.h>
 #include <PMMR/TxHashSetManager.h>
 #include <Database/BlockDb.h>
+#include <algorithm>
+#include <unordered_set>
 
 std::vector<TransactionPtr> ValidTransactionFinder::FindValidTransactions(
 	std::shared_ptr<const IBlockDB> pBlockDB,
 	ITxHashSetConstPtr pTxHashSet,
 	const std::vector<TransactionPtr>& transactions,
-	TransactionPtr pExtraTransaction)
+	const Pool& basePool)
 {
+	if (pTxHashSet == nullptr)
+	{
+		return {};
+	}
+
+	// What the valid txs so far spend and create, on top of the base pool.
+	std::unordered_set<Commitment> spentOutputs;
+	std::unordered_set<Commitment> createdOutputs;
+	std::unordered_set<Hash> kernelHashes;
+
 	std::vector<TransactionPtr> validTransactions;
 	for (TransactionPtr pTransaction : transactions)
 	{
-		std::vector<TransactionPtr> candidateTransactions = validTransactions;
-		if (pExtraTransaction != nullptr)
-		{
-			candidateTransactions.push_back(pExtraTransaction);
-		}
+		const bool inputsValid = std::all_of(
+			pTransaction->GetInputs().cbegin(),
+			pTransaction->GetInputs().cend(),
+			[&](const TransactionInput& input) {
+				const Commitment& commitment = input.GetCommitment();
+				if (basePool.SpendsOutput(commitment) || spentOutputs.find(commitment) != spentOutputs.end())
+				{
+					return false;
+				}
 
-		candidateTransactions.push_back(pTransaction);
+				return basePool.CreatesOutput(commitment)
+					|| createdOutputs.find(commitment) != createdOutputs.end()
+					|| pTxHashSet->IsUnspent(pBlockDB, input);
+			}
+		);
 
-		// Build a single aggregate tx from candidate txs.
-		TransactionPtr pAggregatedTransaction = TransactionUtil::Aggregate(candidateTransactions);
+		const bool outputsValid = inputsValid && std::all_of(
+			pTransaction->GetOutputs().cbegin(),
+			pTransaction->GetOutputs().cend(),
+			[&](const TransactionOutput& output) {
+				const Commitment& commitment = output.GetCommitment();
+				return !basePool.CreatesOutput(commitment)
+					&& createdOutputs.find(commitment) == createdOutputs.end()
+					&& pTxHashSet->IsUnique(pBlockDB, output);
+			}
+		);
 
-		// We know the tx is valid if the entire aggregate tx is valid.
-		if (IsValidTransaction(pBlockDB, pTxHashSet, pAggregatedTransaction))
+		const bool kernelsValid = outputsValid && std::none_of(
+			pTransaction->GetKernels().cbegin(),
+			pTransaction->GetKernels().cend(),
+			[&](const TransactionKernel& kernel) {
+				return basePool.ContainsKernel(kernel.GetHash()) || kernelHashes.find(kernel.GetHash()) != kernelHashes.end();
+			}
+		);
+
+		if (!kernelsValid)
 		{
-			validTransactions.push_back(pTransaction);
+			continue;
 		}
-	}
 
-	return validTransactions;
-}
+		for (const TransactionInput& input : pTransaction->GetInputs())
+		{
+			spentOutputs.insert(input.GetCommitment());
+		}
 
-bool ValidTransactionFinder::IsValidTransaction(
-	std::shared_ptr<const IBlockDB> pBlockDB,
-	ITxHashSetConstPtr pTxHashSet,
-	TransactionPtr pTransaction)
-{
-	try
-	{
-		TransactionValidator().Validate(*pTransaction);
+		for (const TransactionOutput& output : pTransaction->GetOutputs())
+		{
+			createdOutputs.insert(output.GetCommitment());
+		}
 
-		// Validate the tx against current chain state.
-		// Check all inputs are in the current UTXO set.
-		// Check all outputs are unique in current UTXO set.
-		if (!pTxHashSet->IsValid(pBlockDB, *pTransaction))
+		for (const TransactionKernel& kernel : pTransaction->GetKernels())
 		{
-			return false;
+			kernelHashes.insert(kernel.GetHash());
 		}
-	}
-	catch (std::exception&)
-	{
-		return false;
+
+		validTransactions.push_back(pTransaction);
 	}
 
-	return true;
+	return validTransactions;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Pool.h"
+
 #include <Core/Models/Transaction.h>
 #include <Core/Models/BlockHeader.h>
 #include <PMMR/TxHashSet.h>
@@ -10,17 +12,16 @@ class IBlockDB;
 class ValidTransactionFinder
 {
 public:
+	//
+	// Returns the txs that can be added on top of the base pool, in order.
+	// The txs were fully validated when they were added to their pool, so only conflicts need to be checked:
+	// each input must spend an output in the UTXO set, the base pool, or an earlier tx, that isn't already spent,
+	// and no output or kernel can already exist.
+	//
 	static std::vector<TransactionPtr> FindValidTransactions(
 		std::shared_ptr<const IBlockDB> pBlockDB,
 		ITxHashSetConstPtr pTxHashSet,
 		const std::vector<TransactionPtr>& transactions,
-		TransactionPtr pExtraTransaction
-	);
-
-private:
-	static bool IsValidTransaction(
-		std::shared_ptr<const IBlockDB> pBlockDB,
-		ITxHashSetConstPtr pTxHashSet,
-		TransactionPtr pTransaction
+		const Pool& basePool
 	);
 };
\ No newline at end of file
@@ -11,7 +11,11 @@
 #include <Common/Util/VectorUtil.h>
 
 KeyChain::KeyChain(const Config& config, PrivateExtKey&& masterKey, SecretKey&& bulletProofNonce)
-	: m_config(config), m_masterKey(std::move(masterKey)), m_bulletProofNonce(std::move(bulletProofNonce))
+	: m_config(config),
+	m_masterKey(std::move(masterKey)),
+	m_bulletProofNonce(std::move(bulletProofNonce)),
+	m_privateNonceHash(Hasher::Blake2b(m_masterKey.GetPrivateKey().GetVec())),
+	m_rewindNonceHash(Hasher::Blake2b(Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey()).GetCompressedVec()))
 {
 
 }
@@ -64,11 +68,7 @@ std::unique_ptr<RewoundProof> KeyChain::RewindRangeProof(const Commitment& commi
 	}
 	else if (bulletproofType == EBulletproofType::ENHANCED)
 	{
-		PublicKey masterPublicKey = Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey());
-
-		const SecretKey rewindNonceHash = Hasher::Blake2b(masterPublicKey.GetCompressedVec());
-
-		return Crypto::RewindRangeProof(commitment, rangeProof, CreateNonce(commitment, rewindNonceHash));
+		return Crypto::RewindRangeProof(commitment, rangeProof, CreateNonce(commitment, m_rewindNonceHash));
 	}
 
 	throw UNIMPLEMENTED_EXCEPTION;
@@ -91,12 +91,7 @@ RangeProof KeyChain::GenerateRangeProof(
 	}
 	else if (bulletproofType == EBulletproofType::ENHANCED)
 	{
-		const SecretKey privateNonceHash = Hasher::Blake2b(m_masterKey.GetPrivateKey().GetVec());
-
-		PublicKey masterPublicKey = Crypto::CalculatePublicKey(m_masterKey.GetPrivateKey());
-		const SecretKey rewindNonceHash = Hasher::Blake2b(masterPublicKey.GetCompressedVec());
-
-		return Crypto::GenerateRangeProof(amount, blindingFactor, CreateNonce(commitment, privateNonceHash), CreateNonce(commitment, rewindNonceHash), proofMessage);
+		return Crypto::GenerateRangeProof(amount, blindingFactor, CreateNonce(commitment, m_privateNonceHash), CreateNonce(commitment, m_rewindNonceHash), proofMessage);
 	}
 	
 	throw UNIMPLEMENTED_EXCEPTION;
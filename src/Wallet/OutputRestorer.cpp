@@ -5,8 +5,11 @@
 #include <Consensus/BlockTime.h>
 #include <Consensus/HardForks.h>
 #include <Common/Logger.h>
+#include <Common/Util/ThreadUtil.h>
+#include <future>
 
 static const uint64_t NUM_OUTPUTS_PER_BATCH = 1000;
+static const size_t MIN_OUTPUTS_PER_THREAD = 50;
 
 std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::shared_ptr<IWalletDB>& pBatch, const bool fromGenesis) const
 {
@@ -15,24 +18,20 @@ std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::sh
 	uint64_t nextLeafIndex = fromGenesis ? 0 : pBatch->GetRestoreLeafIndex() + 1;
 	uint64_t highestIndex = 0;
 
+	auto fetchOutputs = [this](const uint64_t startIndex)
+	{
+		return m_pNodeClient->GetOutputsByLeafIndex(startIndex, NUM_OUTPUTS_PER_BATCH);
+	};
+
 	std::vector<OutputDataEntity> walletOutputs;
+	std::unique_ptr<OutputRange> pOutputRange = fetchOutputs(nextLeafIndex);
 	while (true)
 	{
-		std::unique_ptr<OutputRange> pOutputRange = m_pNodeClient->GetOutputsByLeafIndex(nextLeafIndex, NUM_OUTPUTS_PER_BATCH);
 		if (pOutputRange == nullptr || pOutputRange->GetLastRetrievedIndex() == 0) {
 			// No new outputs since last restore
 			return std::vector<OutputDataEntity>();
 		}
 
-		const std::vector<OutputDTO>& outputs = pOutputRange->GetOutputs();
-		for (const OutputDTO& output : outputs)
-		{
-			std::unique_ptr<OutputDataEntity> pOutputDataEntity = GetWalletOutput(output, chainHeight);
-			if (pOutputDataEntity != nullptr) {
-				walletOutputs.emplace_back(*pOutputDataEntity);
-			}
-		}
-
 		if (highestIndex == 0) {
 			// Cache this, rather than use the new response from pOutputRange.
 			// Otherwise, pOutputRange->GetHighestIndex() could continue to rise slowly during sync, tying up this thread.
@@ -40,9 +39,21 @@ std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::sh
 		}
 
 		nextLeafIndex = pOutputRange->GetLastRetrievedIndex() + 1;
-		if (nextLeafIndex > highestIndex) {
+
+		// Fetch the next page while this one is being rewound.
+		std::future<std::unique_ptr<OutputRange>> nextOutputRange;
+		if (nextLeafIndex <= highestIndex) {
+			nextOutputRange = std::async(std::launch::async, fetchOutputs, nextLeafIndex);
+		}
+
+		std::vector<OutputDataEntity> found = RewindOutputs(pOutputRange->GetOutputs(), chainHeight);
+		walletOutputs.insert(walletOutputs.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+
+		if (!nextOutputRange.valid()) {
 			break;
 		}
+
+		pOutputRange = nextOutputRange.get();
 	}
 
 	pBatch->UpdateRestoreLeafIndex(nextLeafIndex - 1);
@@ -50,6 +61,29 @@ std::vector<OutputDataEntity> OutputRestorer::FindAndRewindOutputs(const std::sh
 	return walletOutputs;
 }
 
+std::vector<OutputDataEntity> OutputRestorer::RewindOutputs(const std::vector<OutputDTO>& outputs, const uint64_t currentBlockHeight) const
+{
+	// Each chunk checks out its own secp256k1 context for every rewind, so they don't contend on one.
+	std::vector<std::unique_ptr<OutputDataEntity>> found(outputs.size());
+	ThreadUtil::ParallelFor(outputs.size(), MIN_OUTPUTS_PER_THREAD, [this, &outputs, &found, currentBlockHeight](const size_t begin, const size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			found[i] = GetWalletOutput(outputs[i], currentBlockHeight);
+		}
+	});
+
+	std::vector<OutputDataEntity> walletOutputs;
+	for (std::unique_ptr<OutputDataEntity>& pOutputDataEntity : found)
+	{
+		if (pOutputDataEntity != nullptr) {
+			walletOutputs.emplace_back(std::move(*pOutputDataEntity));
+		}
+	}
+
+	return walletOutputs;
+}
+
 std::unique_ptr<OutputDataEntity> OutputRestorer::GetWalletOutput(const OutputDTO& output, const uint64_t currentBlockHeight) const
 {
 	EBulletproofType type = EBulletproofType::ORIGINAL;
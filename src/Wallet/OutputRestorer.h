@@ -21,6 +21,14 @@ public:
 	) const;
 
 private:
+	//
+	// Rewinds the outputs' rangeproofs, split into chunks on the shared worker pool, and returns the ones that belong to the wallet.
+	//
+	std::vector<OutputDataEntity> RewindOutputs(
+		const std::vector<OutputDTO>& outputs,
+		const uint64_t currentBlockHeight
+	) const;
+
 	std::unique_ptr<OutputDataEntity> GetWalletOutput(
 		const OutputDTO& output,
 		const uint64_t currentBlockHeight
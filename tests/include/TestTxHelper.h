@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Core/Models/Transaction.h>
+
+//
+// Builds unsigned transactions for tests that never validate them, where only the commitments and kernels need to be unique.
+//
+class TestTxHelper
+{
+public:
+	static Commitment CreateCommitment(const uint64_t id)
+	{
+		std::vector<unsigned char> bytes(33, 0);
+		for (size_t i = 0; i < 8; i++)
+		{
+			bytes[32 - i] = (unsigned char)(id >> (i * 8));
+		}
+
+		return Commitment(CBigInteger<33>(std::move(bytes)));
+	}
+
+	static TransactionKernel CreateKernel(const uint64_t id, const uint64_t fee = 0)
+	{
+		return TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, fee, 0, CreateCommitment(id), Signature());
+	}
+
+	//
+	// Creates a transaction spending the given inputs, and creating 2 new outputs.
+	// With a single input, its weight is 46.
+	//
+	static TransactionPtr CreateTransaction(const std::vector<uint64_t>& inputIds, const uint64_t outputId, const uint64_t fee = 0)
+	{
+		std::vector<TransactionInput> inputs;
+		for (const uint64_t inputId : inputIds)
+		{
+			inputs.push_back(TransactionInput(EOutputFeatures::DEFAULT, CreateCommitment(inputId)));
+		}
+
+		std::vector<TransactionOutput> outputs({
+			TransactionOutput(EOutputFeatures::DEFAULT, CreateCommitment(outputId), RangeProof(std::vector<unsigned char>(8, 0))),
+			TransactionOutput(EOutputFeatures::DEFAULT, CreateCommitment(outputId + 1), RangeProof(std::vector<unsigned char>(8, 0)))
+		});
+		std::vector<TransactionKernel> kernels({ CreateKernel(outputId, fee) });
+
+		return std::make_shared<Transaction>(
+			BlindingFactor(),
+			TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels))
+		);
+	}
+};
@@ -8,8 +8,7 @@ TEST_CASE("Chain Batching")
 {
 	TestServer::Ptr pTestServer = TestServer::Create();
 	auto chain_path = pTestServer->GenerateTempDir() / "candidate.chain";
-	auto pAllocator = std::make_shared<BlockIndexAllocator>();
-	auto pGenesisIndex = pAllocator->GetOrCreateIndex(pTestServer->GetGenesisHeader()->GetHash(), 0);
+	auto pGenesisIndex = std::make_shared<const BlockIndex>(pTestServer->GetGenesisHeader()->GetHash(), 0);
 
 	Hash hash1 = CSPRNG::GenerateRandom32();
 	Hash hash2a = CSPRNG::GenerateRandom32();
@@ -17,7 +16,7 @@ TEST_CASE("Chain Batching")
 	Hash hash3b = CSPRNG::GenerateRandom32();
 	Hash hash4b = CSPRNG::GenerateRandom32();
 
-	Locked<Chain> chain(Chain::Load(pAllocator, EChainType::CANDIDATE, chain_path, pGenesisIndex));
+	Locked<Chain> chain(Chain::Load(EChainType::CANDIDATE, chain_path, pGenesisIndex));
 
 	{
 		auto pBatch = chain.BatchWrite();
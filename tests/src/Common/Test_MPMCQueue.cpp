@@ -0,0 +1,186 @@
+#include <catch.hpp>
+
+#include <Common/MPMCQueue.h>
+#include <Common/ConcurrentQueue.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MPMCQueue")
+{
+	MPMCQueue<std::unique_ptr<int>> queue(3);
+	REQUIRE(queue.capacity() == 4);
+	REQUIRE(queue.empty());
+
+	for (int i = 0; i < 4; i++)
+	{
+		REQUIRE(queue.try_push(std::make_unique<int>(i)));
+	}
+
+	REQUIRE(!queue.try_push(std::make_unique<int>(4)));
+	REQUIRE(queue.size() == 4);
+
+	std::unique_ptr<int> pItem;
+	REQUIRE(queue.try_pop(pItem));
+	REQUIRE(*pItem == 0);
+
+	std::vector<std::unique_ptr<int>> items;
+	REQUIRE(queue.try_pop_batch(items, 2) == 2);
+	REQUIRE(*items[0] == 1);
+	REQUIRE(*items[1] == 2);
+
+	REQUIRE(queue.wait_pop(pItem, std::chrono::milliseconds(0)));
+	REQUIRE(*pItem == 3);
+	REQUIRE(!queue.wait_pop(pItem, std::chrono::milliseconds(1)));
+
+	// Wraps around the end of the buffer.
+	REQUIRE(queue.try_push(std::make_unique<int>(5)));
+	REQUIRE(queue.wait_pop_batch(items, 8, std::chrono::milliseconds(1)) == 1);
+	REQUIRE(*items.back() == 5);
+}
+
+TEST_CASE("MPMCQueue - Waiting consumers")
+{
+	MPMCQueue<int> queue(4);
+
+	// Two consumers race for each item, so the one that loses has to keep waiting rather than return empty.
+	std::atomic<size_t> numPopped(0);
+	auto consume = [&queue, &numPopped]() {
+		std::vector<int> items;
+		while (queue.wait_pop_batch(items, 1, std::chrono::milliseconds(500)) > 0)
+		{
+			numPopped++;
+		}
+	};
+
+	std::thread consumer1(consume);
+	std::thread consumer2(consume);
+	for (int i = 0; i < 20; i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		REQUIRE(queue.try_push(i));
+	}
+
+	consumer1.join();
+	consumer2.join();
+	REQUIRE(numPopped == 20);
+}
+
+TEST_CASE("MPMCQueue - Multiple producers and consumers")
+{
+	const size_t numThreads = 4;
+	const uint64_t itemsPerProducer = 10'000;
+
+	MPMCQueue<uint64_t> queue(64);
+	std::atomic<uint64_t> sum(0);
+	std::atomic<uint64_t> numPopped(0);
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < numThreads; i++)
+	{
+		threads.push_back(std::thread([&queue, itemsPerProducer] {
+			for (uint64_t item = 1; item <= itemsPerProducer; item++)
+			{
+				while (!queue.try_push(item)) { std::this_thread::yield(); }
+			}
+		}));
+
+		threads.push_back(std::thread([&queue, &sum, &numPopped, numThreads, itemsPerProducer] {
+			std::vector<uint64_t> items;
+			while (numPopped < numThreads * itemsPerProducer)
+			{
+				items.clear();
+				const size_t popped = queue.wait_pop_batch(items, 16, std::chrono::milliseconds(1));
+				for (const uint64_t item : items)
+				{
+					sum += item;
+				}
+
+				numPopped += popped;
+			}
+		}));
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	REQUIRE(queue.empty());
+	REQUIRE(numPopped == numThreads * itemsPerProducer);
+	REQUIRE(sum == numThreads * (itemsPerProducer * (itemsPerProducer + 1) / 2));
+}
+
+// Pushes and pops the given number of items per thread with 4 producers and 4 consumers.
+template<typename PUSH, typename POP>
+static void RunContended(const uint64_t itemsPerProducer, const PUSH& push, const POP& pop)
+{
+	const size_t numThreads = 4;
+	std::atomic<uint64_t> numPopped(0);
+
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < numThreads; i++)
+	{
+		threads.push_back(std::thread([&push, itemsPerProducer] {
+			for (uint64_t item = 0; item < itemsPerProducer; item++)
+			{
+				push(item);
+			}
+		}));
+
+		threads.push_back(std::thread([&pop, &numPopped, numThreads, itemsPerProducer] {
+			while (numPopped < numThreads * itemsPerProducer)
+			{
+				if (pop())
+				{
+					++numPopped;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+TEST_CASE("MPMCQueue vs ConcurrentQueue - 4 producers, 4 consumers", "[.benchmark]")
+{
+	const uint64_t itemsPerProducer = 100'000;
+
+	BENCHMARK("MPMCQueue")
+	{
+		MPMCQueue<uint64_t> queue(1024);
+		RunContended(
+			itemsPerProducer,
+			[&queue](const uint64_t item) { while (!queue.try_push(item)) { std::this_thread::yield(); } },
+			[&queue]() { uint64_t item; return queue.try_pop(item); }
+		);
+	}
+
+	BENCHMARK("ConcurrentQueue")
+	{
+		// copy_front() and pop_front() aren't atomic together, so the item popped isn't always the one copied.
+		// It still does the same amount of locking the old consumers did.
+		ConcurrentQueue<uint64_t> queue;
+		RunContended(
+			itemsPerProducer,
+			[&queue](const uint64_t item) { queue.push_back(item); },
+			[&queue]() {
+				if (queue.copy_front() == nullptr)
+				{
+					return false;
+				}
+
+				queue.pop_front(1);
+				return true;
+			}
+		);
+	}
+}
@@ -0,0 +1,50 @@
+#include <catch.hpp>
+
+#include <Common/TimerWheel.h>
+
+using Clock = TimerWheel<int>::Clock;
+
+TEST_CASE("TimerWheel - Fires at deadline")
+{
+	const Clock::time_point start = Clock::now();
+	TimerWheel<int> wheel(8, std::chrono::seconds(1), start);
+
+	wheel.Schedule(start + std::chrono::milliseconds(2500), 3);
+	wheel.Schedule(start + std::chrono::seconds(1), 1);
+	wheel.Schedule(start + std::chrono::seconds(2), 2);
+	REQUIRE(wheel.size() == 3);
+
+	REQUIRE(wheel.Advance(start + std::chrono::milliseconds(999)).empty());
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(1)) == std::vector<int>({ 1 }));
+	REQUIRE(wheel.GetNextTick() == start + std::chrono::seconds(2));
+
+	// Skipping ahead fires everything that passed, in order.
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(5)) == std::vector<int>({ 2, 3 }));
+	REQUIRE(wheel.empty());
+
+	// Deadlines that already passed fire on the next tick.
+	wheel.Schedule(start, 4);
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(5)).empty());
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(6)) == std::vector<int>({ 4 }));
+}
+
+TEST_CASE("TimerWheel - Deadlines beyond one turn")
+{
+	const Clock::time_point start = Clock::now();
+	TimerWheel<int> wheel(4, std::chrono::seconds(1), start);
+
+	// Both land in the same slot, but the second one is a turn later.
+	wheel.Schedule(start + std::chrono::seconds(2), 1);
+	wheel.Schedule(start + std::chrono::seconds(6), 2);
+
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(2)) == std::vector<int>({ 1 }));
+	REQUIRE(wheel.size() == 1);
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(5)).empty());
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(6)) == std::vector<int>({ 2 }));
+
+	// Many turns pass without the wheel advancing.
+	wheel.Schedule(start + std::chrono::seconds(9), 3);
+	wheel.Schedule(start + std::chrono::seconds(30), 4);
+	REQUIRE(wheel.Advance(start + std::chrono::seconds(100)).size() == 2);
+	REQUIRE(wheel.empty());
+}
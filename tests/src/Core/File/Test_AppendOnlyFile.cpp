@@ -30,4 +30,32 @@ TEST_CASE("DataFile")
     pDataFile->Commit();
 
     REQUIRE(pDataFile->GetSize() == 4);
-}
\ No newline at end of file
+}
+
+TEST_CASE("DataFile - Flushed rewinds")
+{
+    auto pFile = TestFileUtil::CreateTempFile();
+
+    CBigInteger<32> first = CSPRNG::GenerateRandom32();
+    CBigInteger<32> second = CSPRNG::GenerateRandom32();
+
+    {
+        auto pDataFile = DataFile<32>::Load(pFile->GetPath());
+
+        pDataFile->AddData(first);
+        pDataFile->AddData(CSPRNG::GenerateRandom32());
+        pDataFile->Commit();
+
+        pDataFile->Rewind(1);
+        pDataFile->AddData(second);
+        pDataFile->Commit();
+
+        REQUIRE(FileUtil::GetFileSize(pFile->GetPath()) == 64);
+        REQUIRE(pDataFile->GetAt(0) == first);
+        REQUIRE(pDataFile->GetAt(1) == second);
+    }
+
+    auto pDataFile = DataFile<32>::Load(pFile->GetPath());
+    REQUIRE(pDataFile->GetSize() == 2);
+    REQUIRE(pDataFile->GetAt(1) == second);
+}
@@ -0,0 +1,54 @@
+#include <catch.hpp>
+
+#include <Core/File/DataFile.h>
+#include <Core/File/WriteAheadLog.h>
+#include <TestFileUtil.h>
+#include <Crypto/CSPRNG.h>
+
+TEST_CASE("WriteAheadLog - Recover unflushed commits")
+{
+    auto pDir = TestFileUtil::CreateTempFile();
+    FileUtil::CreateDirectories(pDir->GetPath());
+    const fs::path dataPath = pDir->GetPath() / "data.bin";
+
+    CBigInteger<32> first = CSPRNG::GenerateRandom32();
+    CBigInteger<32> second = CSPRNG::GenerateRandom32();
+    CBigInteger<32> third = CSPRNG::GenerateRandom32();
+
+    {
+        auto pWAL = WriteAheadLog::Open(pDir->GetPath());
+        auto pDataFile = DataFile<32>::Load(dataPath);
+
+        pDataFile->AddData(first);
+        pDataFile->AddData(CSPRNG::GenerateRandom32());
+
+        std::vector<WriteAheadLog::Entry> entries;
+        pDataFile->Commit(entries);
+        pWAL->Append(entries);
+
+        // Flush the first commit, then commit a rewind that isn't flushed.
+        pWAL->Rotate();
+        pDataFile->BeginFlush();
+        pDataFile->EndFlush(true);
+        pWAL->RemoveSealed();
+
+        pDataFile->Rewind(1);
+        pDataFile->AddData(second);
+        pDataFile->AddData(third);
+
+        entries.clear();
+        pDataFile->Commit(entries);
+        pWAL->Append(entries);
+
+        REQUIRE(pDataFile->GetSize() == 3);
+        REQUIRE(FileUtil::GetFileSize(dataPath) == 64);
+    }
+
+    WriteAheadLog::Recover(pDir->GetPath());
+
+    auto pDataFile = DataFile<32>::Load(dataPath);
+    REQUIRE(pDataFile->GetSize() == 3);
+    REQUIRE(pDataFile->GetAt(0) == first);
+    REQUIRE(pDataFile->GetAt(1) == second);
+    REQUIRE(pDataFile->GetAt(2) == third);
+}
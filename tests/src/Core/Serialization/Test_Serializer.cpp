@@ -0,0 +1,103 @@
+#include <catch.hpp>
+
+#include <Core/Serialization/Serializer.h>
+#include <Core/Serialization/ByteBuffer.h>
+#include <Config/Genesis.h>
+
+#include <chrono>
+
+TEST_CASE("Serializer - Fixed width")
+{
+	Serializer serializer;
+	serializer.Append<uint8_t>(0x01);
+	serializer.Append<uint16_t>(0x0203);
+	serializer.Append<uint32_t>(0x04050607);
+	serializer.Append<uint64_t>(0x08090A0B0C0D0E0Full);
+	serializer.Append<int64_t>(-2);
+	serializer.AppendLittleEndian<uint32_t>(0x10111213);
+	serializer.AppendLittleEndian<uint64_t>(0x1415161718191A1Bull);
+
+	const std::vector<uint8_t> expected = {
+		0x01,
+		0x02, 0x03,
+		0x04, 0x05, 0x06, 0x07,
+		0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+		0x13, 0x12, 0x11, 0x10,
+		0x1B, 0x1A, 0x19, 0x18, 0x17, 0x16, 0x15, 0x14
+	};
+	REQUIRE(serializer.GetBytes() == expected);
+
+	ByteBuffer byteBuffer(serializer.GetBytes());
+	REQUIRE(byteBuffer.ReadU8() == 0x01);
+	REQUIRE(byteBuffer.ReadU16() == 0x0203);
+	REQUIRE(byteBuffer.ReadU32() == 0x04050607);
+	REQUIRE(byteBuffer.ReadU64() == 0x08090A0B0C0D0E0Full);
+	REQUIRE(byteBuffer.Read64() == -2);
+
+	uint32_t littleEndian32 = 0;
+	byteBuffer.ReadLittleEndian(littleEndian32);
+	REQUIRE(littleEndian32 == 0x10111213);
+	REQUIRE(byteBuffer.ReadU64_LE() == 0x1415161718191A1Bull);
+	REQUIRE(byteBuffer.GetRemainingSize() == 0);
+	REQUIRE_THROWS_AS(byteBuffer.ReadU8(), DeserializationException);
+}
+
+TEST_CASE("Serializer - SizeCounter")
+{
+	const FullBlock& genesis = Genesis::MAINNET_GENESIS;
+
+	SizeCounter sizeCounter;
+	genesis.Serialize(sizeCounter);
+	REQUIRE(sizeCounter.GetSize() == genesis.Serialized().size());
+	REQUIRE(sizeCounter.GetBytes().empty());
+}
+
+TEST_CASE("Serializer - Full block throughput", "[.benchmark]")
+{
+	// A block with the same number of inputs, outputs and kernels as a full mainnet block would have roughly.
+	const FullBlock& genesis = Genesis::MAINNET_GENESIS;
+	const TransactionOutput& output = genesis.GetOutputs().front();
+	const TransactionKernel& kernel = genesis.GetKernels().front();
+
+	std::vector<TransactionInput> inputs(500, TransactionInput(output.GetFeatures(), Commitment(output.GetCommitment())));
+	std::vector<TransactionOutput> outputs(500, output);
+	std::vector<TransactionKernel> kernels(250, kernel);
+	const FullBlock block(genesis.GetHeader(), TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels)));
+
+	const size_t iterations = 100;
+	std::vector<uint8_t> serialized;
+
+	auto start = std::chrono::steady_clock::now();
+	BENCHMARK("Serialize full block")
+	{
+		for (size_t i = 0; i < iterations; i++)
+		{
+			serialized = block.Serialized();
+		}
+	}
+	const auto serializeTime = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	BENCHMARK("Deserialize full block")
+	{
+		for (size_t i = 0; i < iterations; i++)
+		{
+			ByteBuffer byteBuffer(serialized);
+			FullBlock::Deserialize(byteBuffer);
+		}
+	}
+	const auto deserializeTime = std::chrono::steady_clock::now() - start;
+
+	const auto toMBps = [&serialized, iterations](const std::chrono::steady_clock::duration& elapsed) {
+		const int64_t micros = (std::max)((int64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(), (int64_t)1);
+		return (double)(serialized.size() * iterations) / micros;
+	};
+
+	WARN("Block size: " << serialized.size() << " bytes");
+	WARN("Serialize: " << toMBps(serializeTime) << " MB/s");
+	WARN("Deserialize: " << toMBps(deserializeTime) << " MB/s");
+
+	ByteBuffer byteBuffer(serialized);
+	REQUIRE(FullBlock::Deserialize(byteBuffer).GetHash() == block.GetHash());
+}
@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include <Core/Util/TransactionUtil.h>
+#include <Consensus/Sorting.h>
+#include <TestTxHelper.h>
+
+TEST_CASE("TransactionUtil::Aggregate")
+{
+	// B spends output 100 of A, and C spends output 201 of B.
+	TransactionPtr pTransactionA = TestTxHelper::CreateTransaction({ 1, 2 }, 100);
+	TransactionPtr pTransactionB = TestTxHelper::CreateTransaction({ 100, 3 }, 200);
+	TransactionPtr pTransactionC = TestTxHelper::CreateTransaction({ 201 }, 300);
+
+	TransactionPtr pAggregate = TransactionUtil::Aggregate({ pTransactionC, pTransactionA, pTransactionB });
+
+	std::vector<Commitment> inputs;
+	for (const TransactionInput& input : pAggregate->GetInputs())
+	{
+		inputs.push_back(input.GetCommitment());
+	}
+
+	std::vector<Commitment> outputs;
+	for (const TransactionOutput& output : pAggregate->GetOutputs())
+	{
+		outputs.push_back(output.GetCommitment());
+	}
+
+	std::sort(inputs.begin(), inputs.end());
+	std::sort(outputs.begin(), outputs.end());
+	REQUIRE(inputs == std::vector<Commitment>({ TestTxHelper::CreateCommitment(1), TestTxHelper::CreateCommitment(2), TestTxHelper::CreateCommitment(3) }));
+	REQUIRE(outputs == std::vector<Commitment>({ TestTxHelper::CreateCommitment(101), TestTxHelper::CreateCommitment(200), TestTxHelper::CreateCommitment(300), TestTxHelper::CreateCommitment(301) }));
+	REQUIRE(pAggregate->GetKernels().size() == 3);
+
+	REQUIRE(Consensus::IsSorted(pAggregate->GetInputs()));
+	REQUIRE(Consensus::IsSorted(pAggregate->GetOutputs()));
+	REQUIRE(Consensus::IsSorted(pAggregate->GetKernels()));
+}
+
+TEST_CASE("TransactionUtil::MergeSorted")
+{
+	TransactionPtr pTransactionA = TestTxHelper::CreateTransaction({ 1 }, 100);
+	TransactionPtr pTransactionB = TestTxHelper::CreateTransaction({ 2 }, 101);
+
+	// Output 101 is in both.
+	std::vector<TransactionOutput> merged = TransactionUtil::MergeSorted<TransactionOutput>({ &pTransactionA->GetOutputs(), &pTransactionB->GetOutputs() });
+	REQUIRE(merged.size() == 4);
+	REQUIRE(Consensus::IsSorted(merged));
+
+	merged = TransactionUtil::MergeSorted<TransactionOutput>({ &pTransactionA->GetOutputs(), &pTransactionB->GetOutputs() }, true);
+	REQUIRE(merged.size() == 3);
+}
+
+TEST_CASE("TransactionUtil::Aggregate - 1000 transactions", "[.benchmark]")
+{
+	// Every other transaction spends an output of the one before it.
+	std::vector<TransactionPtr> transactions;
+	for (uint64_t i = 0; i < 1'000; i++)
+	{
+		const uint64_t outputId = 1'000'000 + (i * 2);
+		if (i % 2 == 0)
+		{
+			transactions.push_back(TestTxHelper::CreateTransaction({ i * 2, (i * 2) + 1 }, outputId));
+		}
+		else
+		{
+			transactions.push_back(TestTxHelper::CreateTransaction({ outputId - 2, i * 2 }, outputId));
+		}
+	}
+
+	TransactionPtr pAggregate = nullptr;
+	BENCHMARK("Aggregate 1000 transactions")
+	{
+		pAggregate = TransactionUtil::Aggregate(transactions);
+	}
+
+	REQUIRE(pAggregate->GetInputs().size() == 1'500);
+	REQUIRE(pAggregate->GetOutputs().size() == 1'500);
+	REQUIRE(pAggregate->GetKernels().size() == 1'000);
+}
@@ -0,0 +1,76 @@
+#include <catch.hpp>
+
+#include <Core/Validation/KernelSignatureBatcher.h>
+#include <Crypto/Crypto.h>
+#include <Crypto/CSPRNG.h>
+
+#include <thread>
+
+static TransactionKernel CreateKernel(const uint64_t fee, const bool valid)
+{
+	const SecretKey excess = CSPRNG::GenerateRandom32();
+	const Commitment commitment = Crypto::CommitBlinded(0, BlindingFactor(excess.GetBytes()));
+	const Hash message = TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, fee, 0, commitment, Signature()).GetSignatureMessage();
+
+	// An invalid kernel is signed with a different key than its excess commits to.
+	const SecretKey signingKey = valid ? excess : CSPRNG::GenerateRandom32();
+	std::unique_ptr<Signature> pSignature = Crypto::BuildCoinbaseSignature(signingKey, Crypto::CommitBlinded(0, BlindingFactor(signingKey.GetBytes())), message);
+
+	return TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, fee, 0, commitment, *pSignature);
+}
+
+TEST_CASE("KernelSignatureBatcher")
+{
+	KernelSignatureBatcher batcher(8, std::chrono::milliseconds(50));
+
+	SECTION("Concurrent callers get their own results")
+	{
+		const size_t numCallers = 6;
+		std::vector<std::vector<TransactionKernel>> requests;
+		for (size_t i = 0; i < numCallers; i++)
+		{
+			requests.push_back({ CreateKernel(i, i != 3) });
+		}
+
+		// Not a vector<bool>, since its elements can't be written from different threads.
+		std::vector<int> results(numCallers, 0);
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < numCallers; i++)
+		{
+			threads.push_back(std::thread([&batcher, &requests, &results, i]() {
+				results[i] = batcher.Verify(requests[i]).get() ? 1 : 0;
+			}));
+		}
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (size_t i = 0; i < numCallers; i++)
+		{
+			REQUIRE(results[i] == (i != 3 ? 1 : 0));
+		}
+	}
+
+	SECTION("Full batches are verified by the caller")
+	{
+		std::vector<TransactionKernel> kernels;
+		for (size_t i = 0; i < 8; i++)
+		{
+			kernels.push_back(CreateKernel(i, true));
+		}
+
+		std::future<bool> future = batcher.Verify(kernels);
+		REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+		REQUIRE(future.get());
+
+		kernels.back() = CreateKernel(100, false);
+		REQUIRE_FALSE(batcher.Verify(kernels).get());
+	}
+
+	SECTION("No kernels")
+	{
+		REQUIRE(batcher.Verify({}).get());
+	}
+}
@@ -0,0 +1,60 @@
+#include <catch.hpp>
+
+#include <Core/Validation/TransactionBodyValidator.h>
+
+static Commitment CreateCommitment(const uint8_t id)
+{
+	std::vector<unsigned char> bytes(33, 0);
+	bytes[32] = id;
+	return Commitment(CBigInteger<33>(std::move(bytes)));
+}
+
+static TransactionInput CreateInput(const EOutputFeatures features, const uint8_t id)
+{
+	return TransactionInput(features, CreateCommitment(id));
+}
+
+static TransactionOutput CreateOutput(const EOutputFeatures features, const uint8_t id)
+{
+	return TransactionOutput(features, CreateCommitment(id), RangeProof(std::vector<unsigned char>(8, 0)));
+}
+
+static TransactionKernel CreateKernel(const uint8_t id)
+{
+	return TransactionKernel(EKernelFeatures::DEFAULT_KERNEL, 0, 0, CreateCommitment(id), Signature());
+}
+
+static bool IsValid(std::vector<TransactionInput>&& inputs, std::vector<TransactionOutput>&& outputs, std::vector<TransactionKernel>&& kernels)
+{
+	try
+	{
+		TransactionBodyValidator().ValidateStructure(TransactionBody(std::move(inputs), std::move(outputs), std::move(kernels)), false);
+		return true;
+	}
+	catch (std::exception&)
+	{
+		return false;
+	}
+}
+
+TEST_CASE("TransactionBodyValidator::ValidateStructure")
+{
+	const EOutputFeatures plain = EOutputFeatures::DEFAULT;
+	const EOutputFeatures coinbase = EOutputFeatures::COINBASE_OUTPUT;
+
+	REQUIRE(IsValid(
+		{ CreateInput(plain, 1), CreateInput(plain, 2), CreateInput(coinbase, 3) },
+		{ CreateOutput(plain, 4), CreateOutput(plain, 5) },
+		{ CreateKernel(6), CreateKernel(7) }
+	));
+
+	// Duplicates
+	REQUIRE_FALSE(IsValid({ CreateInput(plain, 1), CreateInput(plain, 1) }, { CreateOutput(plain, 4) }, { CreateKernel(6) }));
+	REQUIRE_FALSE(IsValid({ CreateInput(plain, 1) }, { CreateOutput(plain, 4), CreateOutput(plain, 4) }, { CreateKernel(6) }));
+	REQUIRE_FALSE(IsValid({ CreateInput(plain, 1) }, { CreateOutput(plain, 4) }, { CreateKernel(6), CreateKernel(6) }));
+
+	// Spending an output from the same body, with the same or different features.
+	REQUIRE_FALSE(IsValid({ CreateInput(plain, 1), CreateInput(plain, 4) }, { CreateOutput(plain, 4) }, { CreateKernel(6) }));
+	REQUIRE_FALSE(IsValid({ CreateInput(coinbase, 4) }, { CreateOutput(plain, 4), CreateOutput(plain, 5) }, { CreateKernel(6) }));
+	REQUIRE_FALSE(IsValid({ CreateInput(plain, 1), CreateInput(plain, 4) }, { CreateOutput(coinbase, 4) }, { CreateKernel(6) }));
+}
\ No newline at end of file
@@ -61,6 +61,48 @@ TEST_CASE("Crypto::AddCommitment")
 	}
 }
 
+TEST_CASE("Crypto::AddCommitments - With value and blinding factor")
+{
+	BlindingFactor blind_a = CSPRNG::GenerateRandom32() / 2;
+	BlindingFactor blind_b = CSPRNG::GenerateRandom32() / 2;
+	BlindingFactor blind_c = Crypto::AddBlindingFactors({ blind_a, blind_b }, {});
+
+	Commitment commit_a = Crypto::CommitBlinded(10, blind_a);
+
+	// Positive value
+	REQUIRE(Crypto::AddCommitments({ commit_a }, {}, 5, blind_b) == Crypto::CommitBlinded(15, blind_c));
+
+	// Negative value, with the blinding factor still added
+	REQUIRE(Crypto::AddCommitments({ commit_a }, {}, -5, blind_b) == Crypto::CommitBlinded(5, blind_c));
+
+	// Transparent
+	REQUIRE(Crypto::AddCommitments({ commit_a }, {}, -3, BlindingFactor(ZERO_HASH)) == Crypto::CommitBlinded(7, blind_a));
+
+	// Nothing extra
+	REQUIRE(Crypto::AddCommitments({ commit_a }, {}, 0, BlindingFactor(ZERO_HASH)) == commit_a);
+}
+
+TEST_CASE("Crypto::AddCommitments - Cached commitments")
+{
+	BlindingFactor blind_a = CSPRNG::GenerateRandom32() / 2;
+	BlindingFactor blind_b = CSPRNG::GenerateRandom32() / 2;
+	BlindingFactor blind_c = Crypto::AddBlindingFactors({ blind_a, blind_b }, {});
+
+	Commitment commit_a = Crypto::CommitBlinded(10, blind_a);
+	Commitment commit_b = Crypto::CommitBlinded(5, blind_b);
+	Commitment zero(CBigInteger<33>::ValueOf(0));
+
+	// The second sum finds both points already parsed, and must come out the same.
+	const Commitment first = Crypto::AddCommitments({ commit_a, zero, commit_b }, {});
+	const Commitment second = Crypto::AddCommitments({ commit_b, commit_a }, { zero });
+	REQUIRE(first == Crypto::CommitBlinded(15, blind_c));
+	REQUIRE(second == first);
+
+	// Only one of these was cached.
+	Commitment commit_d = Crypto::CommitBlinded(7, blind_b);
+	REQUIRE(Crypto::AddCommitments({ commit_a, commit_d }, { commit_b }) == Crypto::CommitBlinded(12, blind_a));
+}
+
 TEST_CASE("Crypto - PublicKey to Commitment")
 {
 	auto commit = Crypto::ToCommitment(PublicKey(CBigInteger<33>::FromHex("02f434a6b929d0aa6ac757bbe387075066d51ee5308d5be91d2fb478a494d38bdf")));
@@ -4,6 +4,9 @@
 #include <Crypto/Crypto.h>
 #include <Crypto/CSPRNG.h>
 
+#include <atomic>
+#include <thread>
+
 TEST_CASE("AggSig Interaction")
 {
 	Hash message = CSPRNG::GenerateRandom32();
@@ -39,4 +42,38 @@ TEST_CASE("AggSig Interaction")
 	Signature aggregateSignature = *Crypto::AggregateSignatures(std::vector<CompactSignature>({ senderPartialSignature, receiverPartialSignature }), sumPubNonces);
 	const bool aggSigValid = Crypto::VerifyAggregateSignature(aggregateSignature, sumPubKeys, message);
 	REQUIRE(aggSigValid == true);
-}
\ No newline at end of file
+}
+
+TEST_CASE("AggSig - Concurrent signing and verification")
+{
+	const size_t numThreads = 4;
+	const size_t iterations = 25;
+
+	// Catch assertions aren't thread-safe, so the threads only count failures.
+	std::atomic<size_t> failures(0);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		threads.push_back(std::thread([&failures, iterations]() {
+			for (size_t i = 0; i < iterations; i++)
+			{
+				const Hash message = CSPRNG::GenerateRandom32();
+				const SecretKey secretKey = CSPRNG::GenerateRandom32();
+				const Commitment commitment = Crypto::CommitBlinded(0, BlindingFactor(secretKey.GetBytes()));
+
+				std::unique_ptr<Signature> pSignature = Crypto::BuildCoinbaseSignature(secretKey, commitment, message);
+				if (pSignature == nullptr || !Crypto::VerifyKernelSignatures({ pSignature.get() }, { &commitment }, { &message }))
+				{
+					failures++;
+				}
+			}
+		}));
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	REQUIRE(failures == 0);
+}
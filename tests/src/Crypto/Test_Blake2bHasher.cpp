@@ -0,0 +1,30 @@
+#include <catch.hpp>
+
+#include <Crypto/Blake2bHasher.h>
+#include <Crypto/Hasher.h>
+#include <Crypto/Commitment.h>
+#include <Crypto/CSPRNG.h>
+
+TEST_CASE("Blake2bHasher - Matches Hasher::Blake2b")
+{
+	const SecureVector randomBytes = CSPRNG::GenerateRandomBytes(333);
+	const Commitment commitment(CBigInteger<33>(randomBytes.data()));
+	const std::vector<uint8_t> bytes(randomBytes.cbegin() + 33, randomBytes.cend());
+
+	Serializer serializer;
+	Blake2bHasher hasher;
+	for (Serializer* pSerializer : std::vector<Serializer*>{ &serializer, &hasher })
+	{
+		pSerializer->Append<uint8_t>(1);
+		pSerializer->Append<uint64_t>(123456789);
+		pSerializer->AppendLittleEndian<uint32_t>(42);
+		commitment.Serialize(*pSerializer);
+		pSerializer->AppendByteVector(bytes, ESerializeLength::U64);
+		pSerializer->AppendVarStr("grin");
+	}
+
+	REQUIRE(hasher.GetBytes().empty());
+	REQUIRE(hasher.Finalize() == Hasher::Blake2b(serializer.GetBytes()));
+	REQUIRE(Blake2bHasher::Compute(commitment) == Hasher::Blake2b(commitment.GetVec()));
+	REQUIRE(Blake2bHasher().Finalize() == Hasher::Blake2b(std::vector<uint8_t>{}));
+}
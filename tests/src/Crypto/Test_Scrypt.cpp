@@ -0,0 +1,87 @@
+#include <catch.hpp>
+
+#include <Crypto/KDF.h>
+#include <Crypto/ScryptParameters.h>
+#include <Common/Util/HexUtil.h>
+#include <scrypt/crypto_scrypt.h>
+#include <scrypt/crypto_scrypt_smix.h>
+
+#include <chrono>
+#include <random>
+
+static std::string Scrypt(const std::string& password, const std::string& salt, const uint64_t N, const uint32_t r, const uint32_t p)
+{
+	std::vector<uint8_t> output(64);
+	REQUIRE(crypto_scrypt(
+		(const uint8_t*)password.data(), password.size(),
+		(const uint8_t*)salt.data(), salt.size(),
+		N, r, p,
+		output.data(), output.size()
+	) == 0);
+
+	return HexUtil::ConvertToHex(output);
+}
+
+TEST_CASE("Scrypt - RFC 7914 test vectors")
+{
+	REQUIRE(Scrypt("", "", 16, 1, 1) == "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+	REQUIRE(Scrypt("password", "NaCl", 1024, 8, 16) == "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640");
+	REQUIRE(Scrypt("pleaseletmein", "SodiumChloride", 16384, 8, 1) == "7023bdcb3afd7348461c06cd81fd38ebfda8fbba904f8e3ea9b543f6545da1f2d5432955613f0fcf62d49705242a9af9e61e85dc0d651e40dfcf017b45575887");
+}
+
+TEST_CASE("Scrypt - SSE2 matches reference SMix")
+{
+	if (!crypto_scrypt_smix_sse2_supported())
+	{
+		WARN("SSE2 not supported");
+		return;
+	}
+
+	const size_t r = 8;
+	const uint64_t N = 1024;
+
+	std::mt19937 rng(12345);
+	std::vector<uint8_t> reference(128 * r);
+	for (uint8_t& byte : reference)
+	{
+		byte = (uint8_t)rng();
+	}
+	std::vector<uint8_t> sse2 = reference;
+
+	std::vector<uint8_t> V(128 * r * N);
+	std::vector<uint8_t> XY(256 * r);
+	crypto_scrypt_smix(reference.data(), r, N, V.data(), XY.data());
+
+	// The SSE2 version needs its temporary storage aligned to 64 bytes.
+	std::vector<uint8_t> V2(128 * r * N + 63);
+	std::vector<uint8_t> XY2(256 * r + 63);
+	const auto align = [](std::vector<uint8_t>& vec) { return (void*)(((uintptr_t)vec.data() + 63) & ~(uintptr_t)63); };
+	crypto_scrypt_smix_sse2(sse2.data(), r, N, align(V2), align(XY2));
+
+	REQUIRE(sse2 == reference);
+}
+
+TEST_CASE("KDF::PBKDF - Wallet parameters")
+{
+	const SecureString password = "correct horse battery staple";
+	const std::vector<uint8_t> salt = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+	const SecretKey key = KDF::PBKDF(password, salt, ScryptParameters(32768, 8, 1));
+	REQUIRE(HexUtil::ConvertToHex(key.GetVec()) == "4947a98972e95ec455386ee638edce85f87d9a4bda202b87835938b6d37e8976");
+}
+
+TEST_CASE("KDF::PBKDF - Login latency", "[.benchmark]")
+{
+	const SecureString password = "correct horse battery staple";
+	const std::vector<uint8_t> salt = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+	std::chrono::steady_clock::duration elapsed;
+	BENCHMARK("PBKDF N=32768, r=8, p=1")
+	{
+		const auto start = std::chrono::steady_clock::now();
+		KDF::PBKDF(password, salt, ScryptParameters(32768, 8, 1));
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	WARN("Login KDF took " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms");
+}
@@ -0,0 +1,119 @@
+#include <catch.hpp>
+
+#include <P2P/Pipeline/TransactionQueue.h>
+#include <TestTxHelper.h>
+
+static TxEntry CreateEntry(const uint64_t connectionId, const uint64_t txId)
+{
+	return TxEntry(connectionId, nullptr, TestTxHelper::CreateTransaction({ txId }, 1'000'000 + (txId * 2)), EPoolType::MEMPOOL);
+}
+
+static std::vector<uint64_t> GetConnectionIds(const std::vector<TxEntry>& batch)
+{
+	std::vector<uint64_t> connectionIds;
+	for (const TxEntry& entry : batch)
+	{
+		connectionIds.push_back(entry.m_connectionId);
+	}
+
+	return connectionIds;
+}
+
+TEST_CASE("TransactionQueue - Round-robin across peers")
+{
+	TransactionQueue queue(100, 100);
+
+	// Peer 1 floods the queue before peer 2 and 3 send anything.
+	for (uint64_t i = 0; i < 5; i++)
+	{
+		REQUIRE(queue.Push(CreateEntry(1, i)));
+	}
+
+	REQUIRE(queue.Push(CreateEntry(2, 10)));
+	REQUIRE(queue.Push(CreateEntry(2, 11)));
+	REQUIRE(queue.Push(CreateEntry(3, 20)));
+
+	std::vector<TxEntry> batch = queue.PopBatch(5, std::chrono::milliseconds(0));
+	REQUIRE(GetConnectionIds(batch) == std::vector<uint64_t>({ 1, 2, 3, 1, 2 }));
+	queue.Complete(batch);
+
+	batch = queue.PopBatch(10, std::chrono::milliseconds(0));
+	REQUIRE(GetConnectionIds(batch) == std::vector<uint64_t>({ 1, 1, 1 }));
+	queue.Complete(batch);
+
+	REQUIRE(queue.GetStats().GetNumProcessed() == 8);
+}
+
+TEST_CASE("TransactionQueue - Per-peer and total limits")
+{
+	TransactionQueue queue(4, 2);
+
+	REQUIRE(queue.Push(CreateEntry(1, 1)));
+	REQUIRE(queue.Push(CreateEntry(1, 2)));
+	REQUIRE_FALSE(queue.Push(CreateEntry(1, 3)));
+
+	// A full lane doesn't stop other peers.
+	REQUIRE(queue.Push(CreateEntry(2, 4)));
+	REQUIRE(queue.Push(CreateEntry(3, 5)));
+
+	// But the queue as a whole is full.
+	REQUIRE_FALSE(queue.Push(CreateEntry(4, 6)));
+
+	const TransactionQueueStats stats = queue.GetStats();
+	REQUIRE(stats.GetDepth() == 4);
+	REQUIRE(stats.GetNumPeers() == 3);
+	REQUIRE(stats.GetNumDropped() == 2);
+
+	// Popping frees up room in the lane.
+	std::vector<TxEntry> batch = queue.PopBatch(1, std::chrono::milliseconds(0));
+	REQUIRE(batch.front().m_connectionId == 1);
+	REQUIRE(queue.Push(CreateEntry(1, 3)));
+}
+
+TEST_CASE("TransactionQueue - Deduplicates queued and in-flight transactions")
+{
+	TransactionQueue queue(100, 100);
+
+	REQUIRE(queue.Push(CreateEntry(1, 1)));
+	REQUIRE_FALSE(queue.Push(CreateEntry(2, 1)));
+
+	// Still a duplicate while it's being processed.
+	std::vector<TxEntry> batch = queue.PopBatch(10, std::chrono::milliseconds(0));
+	REQUIRE(batch.size() == 1);
+	REQUIRE(queue.GetStats().GetInFlight() == 1);
+	REQUIRE_FALSE(queue.Push(CreateEntry(2, 1)));
+
+	// Once it's done, it can be queued again.
+	queue.Complete(batch);
+	REQUIRE(queue.GetStats().GetInFlight() == 0);
+	REQUIRE(queue.Push(CreateEntry(2, 1)));
+
+	REQUIRE(queue.GetStats().GetNumDuplicates() == 2);
+	REQUIRE(queue.GetStats().GetNumDropped() == 0);
+}
+
+TEST_CASE("TransactionQueue - PopBatch bounds")
+{
+	TransactionQueue queue(100, 100);
+	for (uint64_t i = 0; i < 10; i++)
+	{
+		REQUIRE(queue.Push(CreateEntry(i % 3, i)));
+	}
+
+	std::vector<TxEntry> batch = queue.PopBatch(4, std::chrono::milliseconds(0));
+	REQUIRE(batch.size() == 4);
+	REQUIRE(queue.GetStats().GetDepth() == 6);
+	REQUIRE(queue.GetStats().GetInFlight() == 4);
+
+	REQUIRE(queue.PopBatch(100, std::chrono::milliseconds(0)).size() == 6);
+	REQUIRE(queue.GetStats().GetNumPeers() == 0);
+
+	// Empty, so it waits out the timeout.
+	const auto start = std::chrono::steady_clock::now();
+	REQUIRE(queue.PopBatch(4, std::chrono::milliseconds(20)).empty());
+	REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+	// After shutdown, it returns right away.
+	queue.Shutdown();
+	REQUIRE(queue.PopBatch(4, std::chrono::seconds(10)).empty());
+}
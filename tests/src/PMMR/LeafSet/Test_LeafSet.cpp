@@ -1,8 +1,48 @@
 #include <catch.hpp>
 
 #include <PMMR/Common/LeafSet.h>
+#include <TestFileUtil.h>
 
 TEST_CASE("LeafSet")
 {
-    // TODO: Implement
-}
\ No newline at end of file
+    auto pDir = TestFileUtil::CreateTempFile();
+    FileUtil::CreateDirectories(pDir->GetPath());
+    const fs::path path = pDir->GetPath() / "pmmr_leafset.bin";
+
+    {
+        auto pLeafSet = LeafSet::Load(path);
+
+        // Spans multiple words and pages.
+        for (uint64_t i = 0; i < 40000; i += 3)
+        {
+            pLeafSet->Add(i);
+        }
+        pLeafSet->Remove(3);
+        pLeafSet->Commit();
+
+        REQUIRE(pLeafSet->Contains(0));
+        REQUIRE(!pLeafSet->Contains(3));
+        REQUIRE(pLeafSet->Contains(39999));
+
+        // Uncommitted changes are discarded.
+        pLeafSet->Remove(6);
+        pLeafSet->Add(1);
+        pLeafSet->Rollback();
+
+        REQUIRE(pLeafSet->Contains(6));
+        REQUIRE(!pLeafSet->Contains(1));
+
+        pLeafSet->Rewind(33000, { 3 });
+        pLeafSet->Commit();
+
+        REQUIRE(pLeafSet->Contains(3));
+        REQUIRE(pLeafSet->Contains(32997));
+        REQUIRE(!pLeafSet->Contains(33000));
+    }
+
+    auto pLeafSet = LeafSet::Load(path);
+    REQUIRE(pLeafSet->Contains(3));
+    REQUIRE(pLeafSet->Contains(32997));
+    REQUIRE(!pLeafSet->Contains(33000));
+    REQUIRE(!pLeafSet->Contains(39999));
+}
@@ -0,0 +1,68 @@
+#include <catch.hpp>
+
+#include <PMMR/Common/PMMRCompaction.h>
+#include <TestFileUtil.h>
+
+TEST_CASE("PMMRCompaction")
+{
+	auto pDir = TestFileUtil::CreateTempFile();
+	const fs::path dir = pDir->GetPath();
+	FileUtil::CreateDirectories(dir);
+
+	auto pHashFile = HashFile::Load(dir / "pmmr_hash.bin");
+	auto pDataFile = DataFile<4>::Load(dir / "pmmr_data.bin");
+	auto pLeafSet = LeafSet::Load(dir / "pmmr_leafset.bin");
+	auto pPruneList = PruneList::Load(dir / "pmmr_prun.bin");
+
+	// 8 leaves, so 15 positions. Each entry is filled with its index.
+	for (uint8_t i = 0; i < 15; i++)
+	{
+		pHashFile->AddData(std::vector<unsigned char>(32, i));
+	}
+	pHashFile->Commit();
+
+	for (uint8_t i = 0; i < 8; i++)
+	{
+		pDataFile->AddData(std::vector<unsigned char>(4, i));
+		pLeafSet->Add(i);
+	}
+	pDataFile->Commit();
+
+	pLeafSet->Remove(0);
+	pLeafSet->Remove(1);
+	pLeafSet->Remove(2);
+	pLeafSet->Commit();
+
+	// Compact the first 4 leaves. Leaves 0 and 1 get pruned up to their parent (position 2), so their hashes and data are removed.
+	// Leaf 2 is pruned too, but it's still a root since leaf 3 is unspent.
+	{
+		PMMRCompaction<4> compaction(7, pHashFile, pDataFile, pLeafSet, pPruneList);
+
+		const std::atomic_bool terminate(false);
+		uint64_t bytesRead = 0;
+		REQUIRE(compaction.Write([&bytesRead](const uint64_t bytes) { bytesRead += bytes; }, terminate));
+		REQUIRE(bytesRead == compaction.GetTotalBytes());
+		REQUIRE(compaction.Stage());
+		REQUIRE(compaction.GetReclaimedBytes() == (2 * 32) + (2 * 4));
+	}
+
+	pHashFile.reset();
+	pDataFile.reset();
+	pPruneList.reset();
+	CompactionFiles::Swap(dir, { dir / "pmmr_hash.bin", dir / "pmmr_data.bin", dir / "pmmr_prun.bin" });
+
+	pHashFile = HashFile::Load(dir / "pmmr_hash.bin");
+	pDataFile = DataFile<4>::Load(dir / "pmmr_data.bin");
+	pPruneList = PruneList::Load(dir / "pmmr_prun.bin");
+
+	REQUIRE(pHashFile->GetSize() == 13);
+	REQUIRE(pHashFile->GetDataAt(0)[0] == 2);
+	REQUIRE(pHashFile->GetDataAt(12)[0] == 14);
+	REQUIRE(pDataFile->GetSize() == 6);
+	REQUIRE(pDataFile->GetDataAt(0)[0] == 2);
+
+	REQUIRE(pPruneList->IsPrunedRoot(2));
+	REQUIRE(pPruneList->IsPrunedRoot(3));
+	REQUIRE(pPruneList->GetShift(14) == 2);
+	REQUIRE(pPruneList->GetLeafShift(14) == 2);
+}
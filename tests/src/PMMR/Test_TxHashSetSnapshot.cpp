@@ -0,0 +1,49 @@
+#include <catch.hpp>
+
+#include <TestServer.h>
+#include <PMMR/TxHashSetImpl.h>
+#include <Core/File/WriteAheadLog.h>
+
+#include <atomic>
+#include <thread>
+
+TEST_CASE("TxHashSet::FlushAndCopy - While flushing")
+{
+	TestServer::Ptr pTestServer = TestServer::Create();
+	const FullBlock& genesisBlock = pTestServer->GetGenesisBlock();
+
+	auto pTxHashSet = std::dynamic_pointer_cast<TxHashSet>(pTestServer->GetTxHashSetManager()->Write()->GetTxHashSet());
+	REQUIRE(pTxHashSet != nullptr);
+	std::shared_ptr<KernelMMR> pKernelMMR = pTxHashSet->GetKernelMMR();
+
+	// Keeps the flusher busy, so the copies race against it.
+	std::atomic_bool done(false);
+	std::thread flusher([&pTxHashSet, &done]() {
+		while (!done)
+		{
+			pTxHashSet->Flush();
+		}
+	});
+
+	for (size_t i = 0; i < 20; i++)
+	{
+		for (size_t j = 0; j < 50; j++)
+		{
+			pKernelMMR->ApplyKernel(genesisBlock.GetKernels().front());
+		}
+
+		pTxHashSet->Commit();
+		const uint64_t kernelMMRSize = pKernelMMR->GetSize();
+
+		const fs::path snapshotDir = pTestServer->GenerateTempDir();
+		pTxHashSet->FlushAndCopy(snapshotDir);
+		WriteAheadLog::Recover(snapshotDir);
+
+		auto pSnapshotMMR = KernelMMR::Load(snapshotDir, genesisBlock);
+		REQUIRE(pSnapshotMMR->GetSize() == kernelMMRSize);
+		REQUIRE(pSnapshotMMR->Root(kernelMMRSize) == pKernelMMR->Root(kernelMMRSize));
+	}
+
+	done = true;
+	flusher.join();
+}
@@ -0,0 +1,112 @@
+#include <catch.hpp>
+
+#include <PoW/PoWValidator.h>
+#include <PoW/SipHasher.h>
+#include <Config/Genesis.h>
+
+// Copies the header, but with a different proof.
+static BlockHeaderPtr ReplaceProof(const BlockHeader& header, std::vector<uint64_t>&& proofNonces)
+{
+	return std::make_shared<const BlockHeader>(
+		header.GetVersion(),
+		header.GetHeight(),
+		header.GetTimestamp(),
+		Hash(header.GetPreviousHash()),
+		Hash(header.GetPreviousRoot()),
+		Hash(header.GetOutputRoot()),
+		Hash(header.GetRangeProofRoot()),
+		Hash(header.GetKernelRoot()),
+		BlindingFactor(header.GetTotalKernelOffset()),
+		header.GetOutputMMRSize(),
+		header.GetKernelMMRSize(),
+		header.GetTotalDifficulty(),
+		header.GetScalingDifficulty(),
+		header.GetNonce(),
+		ProofOfWork(header.GetProofOfWork().GetEdgeBits(), std::move(proofNonces))
+	);
+}
+
+template <int rotE>
+static void CheckLanes(const size_t count, const size_t length)
+{
+	std::vector<siphash_keys> keys;
+	for (size_t i = 0; i < count; i++)
+	{
+		std::vector<char> keyBytes(32, (char)i);
+		keys.push_back(siphash_keys(keyBytes.data()));
+	}
+
+	std::vector<const siphash_keys*> keyPtrs;
+	std::vector<uint64_t> nonces;
+	for (size_t i = 0; i < count; i++)
+	{
+		keyPtrs.push_back(&keys[i]);
+		nonces.push_back(i * 0x9E3779B97F4A7C15ull);
+	}
+
+	std::vector<uint64_t> results(count * length);
+	SipHasher::Hash24<rotE>(keyPtrs.data(), nonces.data(), results.data(), count, length);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		siphash_state<rotE> state(keys[i]);
+		for (size_t j = 0; j < length; j++)
+		{
+			state.hash24(nonces[i] + j);
+			REQUIRE(results[(i * length) + j] == state.xor_lanes());
+		}
+	}
+}
+
+TEST_CASE("SipHasher::Hash24")
+{
+	// Covers full and partial sets of lanes for every implementation.
+	for (size_t count = 0; count <= 9; count++)
+	{
+		CheckLanes<21>(count, 1);
+		CheckLanes<21>(count, 64);
+		CheckLanes<25>(count, 64);
+	}
+}
+
+TEST_CASE("PoWValidator::AreProofsValid")
+{
+	ConfigPtr pConfig = Config::Default(EEnvironmentType::MAINNET);
+	PoWValidator validator(*pConfig, nullptr);
+
+	const BlockHeaderPtr& pMainnetGenesis = Genesis::MAINNET_GENESIS.GetHeader();
+	const BlockHeaderPtr& pFloonetGenesis = Genesis::FLOONET_GENESIS.GetHeader();
+	REQUIRE(validator.AreProofsValid({ pMainnetGenesis, pFloonetGenesis, pMainnetGenesis }));
+
+	std::vector<uint64_t> proofNonces = pMainnetGenesis->GetProofOfWork().GetProofNonces();
+	proofNonces[20]++;
+	BlockHeaderPtr pInvalidHeader = ReplaceProof(*pMainnetGenesis, std::move(proofNonces));
+	REQUIRE_FALSE(validator.AreProofsValid({ pMainnetGenesis, pInvalidHeader }));
+
+	std::vector<uint64_t> shortProof = pMainnetGenesis->GetProofOfWork().GetProofNonces();
+	shortProof.pop_back();
+	REQUIRE_FALSE(validator.AreProofsValid({ ReplaceProof(*pMainnetGenesis, std::move(shortProof)) }));
+}
+
+TEST_CASE("PoWValidator::AreProofsValid - 512 headers", "[.benchmark]")
+{
+	ConfigPtr pConfig = Config::Default(EEnvironmentType::MAINNET);
+	PoWValidator validator(*pConfig, nullptr);
+
+	std::vector<BlockHeaderPtr> headers(512, Genesis::MAINNET_GENESIS.GetHeader());
+
+	WARN("SipHash implementation: " << SipHasher::GetImplementation());
+
+	bool valid = false;
+	std::chrono::steady_clock::duration elapsed;
+	BENCHMARK("Verify 512 cuckaroo proofs")
+	{
+		const auto start = std::chrono::steady_clock::now();
+		valid = validator.AreProofsValid(headers);
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	const int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+	WARN("Headers verified per second: " << (headers.size() * 1'000'000) / (std::max)(micros, (int64_t)1));
+	REQUIRE(valid);
+}
\ No newline at end of file
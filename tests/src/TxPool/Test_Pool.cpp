@@ -0,0 +1,175 @@
+#include <catch.hpp>
+
+#include <TxPool/Pool.h>
+#include <Core/Models/FullBlock.h>
+#include <TestTxHelper.h>
+
+TEST_CASE("Pool::RemoveConflicts")
+{
+	Pool pool;
+
+	// Spends inputs 1-4, creating outputs 100-107.
+	std::vector<TransactionPtr> transactions;
+	for (uint64_t i = 0; i < 4; i++)
+	{
+		transactions.push_back(TestTxHelper::CreateTransaction({ i + 1 }, 100 + (i * 2)));
+		pool.AddTransaction(transactions.back(), EDandelionStatus::FLUFFED);
+	}
+
+	pool.AddTransaction(transactions.front(), EDandelionStatus::FLUFFED);
+	REQUIRE(pool.Size() == 4);
+	REQUIRE(pool.ContainsTransaction(*transactions[2]));
+	REQUIRE(pool.FindTransactionByKernelHash(TestTxHelper::CreateKernel(102).GetHash()) == transactions[1]);
+
+	// The block includes transactions[0], spends the input of transactions[1], and creates an output of transactions[2].
+	std::vector<TransactionInput> blockInputs({
+		TransactionInput(EOutputFeatures::DEFAULT, TestTxHelper::CreateCommitment(2))
+	});
+	std::vector<TransactionOutput> blockOutputs({
+		TransactionOutput(EOutputFeatures::DEFAULT, TestTxHelper::CreateCommitment(105), RangeProof(std::vector<unsigned char>(8, 0)))
+	});
+	std::vector<TransactionKernel> blockKernels({ TestTxHelper::CreateKernel(100) });
+	FullBlock block(nullptr, TransactionBody(std::move(blockInputs), std::move(blockOutputs), std::move(blockKernels)));
+
+	REQUIRE(pool.RemoveConflicts(block) == 3);
+	REQUIRE(pool.Size() == 1);
+	REQUIRE(pool.ContainsTransaction(*transactions[3]));
+	REQUIRE(!pool.ContainsTransaction(*transactions[0]));
+	REQUIRE(pool.FindTransactionByKernelHash(TestTxHelper::CreateKernel(100).GetHash()) == nullptr);
+	REQUIRE(pool.FindTransactionsByKernel({ TestTxHelper::CreateKernel(106) }) == std::vector<TransactionPtr>({ transactions[3] }));
+}
+
+TEST_CASE("Pool::GetBlockTemplate")
+{
+	Pool pool;
+
+	// B spends an output of A, which has a low fee, but together they pay more per weight than C.
+	// D double-spends the input of C.
+	TransactionPtr pTransactionA = TestTxHelper::CreateTransaction({ 1 }, 100, 10);
+	TransactionPtr pTransactionB = TestTxHelper::CreateTransaction({ 100 }, 200, 1000);
+	TransactionPtr pTransactionC = TestTxHelper::CreateTransaction({ 2 }, 300, 50);
+	TransactionPtr pTransactionD = TestTxHelper::CreateTransaction({ 2 }, 400, 40);
+	pool.AddTransaction(pTransactionA, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pTransactionB, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pTransactionC, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pTransactionD, EDandelionStatus::FLUFFED);
+
+	REQUIRE(pool.GetBlockTemplate(Consensus::MAX_BLOCK_WEIGHT) == std::vector<TransactionPtr>({ pTransactionA, pTransactionB, pTransactionC }));
+	REQUIRE(pool.GetBlockTemplate(92) == std::vector<TransactionPtr>({ pTransactionA, pTransactionB }));
+	REQUIRE(pool.GetBlockTemplate(91) == std::vector<TransactionPtr>({ pTransactionC }));
+
+	// A has the lowest fee rate, and B can't be mined without it.
+	REQUIRE(pool.EvictLowestFeeRate(2) == 2);
+	REQUIRE(pool.Size() == 2);
+	REQUIRE(pool.ContainsTransaction(*pTransactionC));
+	REQUIRE(pool.ContainsTransaction(*pTransactionD));
+}
+
+TEST_CASE("Pool::FindTransactionsByStatus")
+{
+	Pool pool;
+
+	std::vector<TransactionPtr> transactions;
+	for (uint64_t i = 0; i < 4; i++)
+	{
+		transactions.push_back(TestTxHelper::CreateTransaction({ i + 1 }, 100 + (i * 2)));
+		pool.AddTransaction(transactions.back(), EDandelionStatus::TO_STEM);
+	}
+
+	pool.ChangeStatus({ transactions[2], transactions[0] }, EDandelionStatus::TO_FLUFF);
+	REQUIRE(pool.FindTransactionsByStatus(EDandelionStatus::TO_FLUFF) == std::vector<TransactionPtr>({ transactions[0], transactions[2] }));
+	REQUIRE(pool.FindTransactionsByStatus(EDandelionStatus::TO_STEM) == std::vector<TransactionPtr>({ transactions[1], transactions[3] }));
+
+	pool.RemoveTransaction(*transactions[0]);
+	REQUIRE(pool.FindTransactionsByStatus(EDandelionStatus::TO_FLUFF) == std::vector<TransactionPtr>({ transactions[2] }));
+	REQUIRE(pool.FindTransactionByHash(transactions[0]->GetHash()) == nullptr);
+	REQUIRE(pool.FindTransactionByHash(transactions[3]->GetHash()) == transactions[3]);
+	REQUIRE(pool.FindTransactionsByStatus(EDandelionStatus::STEMMED).empty());
+}
+
+TEST_CASE("Pool::Aggregate")
+{
+	Pool pool;
+	REQUIRE(pool.Aggregate() == nullptr);
+
+	// B spends output 100 of A.
+	TransactionPtr pTransactionA = TestTxHelper::CreateTransaction({ 1 }, 100);
+	TransactionPtr pTransactionB = TestTxHelper::CreateTransaction({ 100 }, 200);
+	pool.AddTransaction(pTransactionA, EDandelionStatus::FLUFFED);
+	pool.AddTransaction(pTransactionB, EDandelionStatus::FLUFFED);
+
+	REQUIRE(pool.SpendsOutput(TestTxHelper::CreateCommitment(100)));
+	REQUIRE(pool.CreatesOutput(TestTxHelper::CreateCommitment(201)));
+	REQUIRE(pool.ContainsKernel(TestTxHelper::CreateKernel(200).GetHash()));
+
+	TransactionPtr pAggregate = pool.Aggregate();
+	REQUIRE(pAggregate->GetInputs().size() == 1);
+	REQUIRE(pAggregate->GetInputs().front().GetCommitment() == TestTxHelper::CreateCommitment(1));
+	REQUIRE(pAggregate->GetOutputs().size() == 3);
+	REQUIRE(pAggregate->GetKernels().size() == 2);
+
+	pool.RemoveTransaction(*pTransactionB);
+	REQUIRE(!pool.SpendsOutput(TestTxHelper::CreateCommitment(100)));
+	REQUIRE(!pool.ContainsKernel(TestTxHelper::CreateKernel(200).GetHash()));
+	REQUIRE(pool.Aggregate()->GetOutputs().size() == 2);
+}
+
+TEST_CASE("Pool::ReconcileBlock - 50k transactions", "[.benchmark]")
+{
+	const uint64_t numTransactions = 50'000;
+	const uint64_t numBlockTransactions = 1'000;
+
+	std::vector<TransactionPtr> transactions;
+	for (uint64_t i = 0; i < numTransactions; i++)
+	{
+		transactions.push_back(TestTxHelper::CreateTransaction({ i }, numTransactions + (i * 2)));
+	}
+
+	// A full block's worth of transactions, half of which were in the pool, and half of which double-spend pool transactions.
+	std::vector<TransactionInput> blockInputs;
+	std::vector<TransactionOutput> blockOutputs;
+	std::vector<TransactionKernel> blockKernels;
+	for (uint64_t i = 0; i < numBlockTransactions; i++)
+	{
+		const uint64_t poolIndex = i * (numTransactions / numBlockTransactions);
+		blockInputs.push_back(TransactionInput(EOutputFeatures::DEFAULT, TestTxHelper::CreateCommitment(poolIndex)));
+		blockOutputs.push_back(TransactionOutput(EOutputFeatures::DEFAULT, TestTxHelper::CreateCommitment((numTransactions * 4) + i), RangeProof(std::vector<unsigned char>(8, 0))));
+		blockKernels.push_back(TestTxHelper::CreateKernel(i % 2 == 0 ? numTransactions + (poolIndex * 2) : (numTransactions * 4) + i));
+	}
+
+	// Builds on the empty previous hash that a new pool starts with, so the block isn't treated as a reorg,
+	// and the pool never needs to consult the block db or TxHashSet.
+	auto pHeader = std::make_shared<const BlockHeader>(
+		1, 1, 0, Hash(), Hash(), Hash(), Hash(), Hash(), BlindingFactor(Hash()), 0, 0, 0, 0, 0,
+		ProofOfWork(29, std::vector<uint64_t>(42, 0))
+	);
+	FullBlock block(pHeader, TransactionBody(std::move(blockInputs), std::move(blockOutputs), std::move(blockKernels)));
+
+	// Reconciling removes transactions, so every iteration builds its own pool.
+	// The cost of reconciling is the difference between these two benchmarks.
+	BENCHMARK("Build 50k transaction pool")
+	{
+		Pool pool;
+		for (const TransactionPtr& pTransaction : transactions)
+		{
+			pool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
+		}
+	}
+
+	size_t numRemovedOutputs = 0;
+	size_t poolSize = 0;
+	BENCHMARK("Build 50k transaction pool and reconcile full block")
+	{
+		Pool pool;
+		for (const TransactionPtr& pTransaction : transactions)
+		{
+			pool.AddTransaction(pTransaction, EDandelionStatus::FLUFFED);
+		}
+
+		numRemovedOutputs = pool.ReconcileBlock(nullptr, nullptr, block, nullptr, {}).size();
+		poolSize = pool.Size();
+	}
+
+	REQUIRE(numRemovedOutputs == numBlockTransactions * 2);
+	REQUIRE(poolSize == numTransactions - numBlockTransactions);
+}
@@ -0,0 +1,136 @@
+#include <catch.hpp>
+
+#include <Wallet/OutputRestorer.h>
+#include <Wallet/Keychain/KeyChain.h>
+#include <Crypto/Crypto.h>
+#include <Config/ConfigLoader.h>
+
+// Serves outputs with leaf indices 1..m_outputs.size(), at most PAGE_SIZE per request.
+class PagedNodeClient : public INodeClient
+{
+public:
+	static const uint64_t PAGE_SIZE = 60;
+
+	PagedNodeClient(std::vector<OutputDTO>&& outputs) : m_outputs(std::move(outputs)) { }
+
+	uint64_t GetChainHeight() const final { return 1000; }
+	BlockHeaderPtr GetBlockHeader(const uint64_t) const final { return nullptr; }
+	std::map<Commitment, OutputLocation> GetOutputsByCommitment(const std::vector<Commitment>&) const final { return {}; }
+	std::vector<BlockWithOutputs> GetBlockOutputs(const uint64_t, const uint64_t) const final { return {}; }
+	bool PostTransaction(TransactionPtr, const EPoolType) final { return false; }
+
+	std::unique_ptr<OutputRange> GetOutputsByLeafIndex(const uint64_t startIndex, const uint64_t maxNumOutputs) const final
+	{
+		const uint64_t first = (std::max)(startIndex, (uint64_t)1);
+		const uint64_t last = (std::min)(first + (std::min)(maxNumOutputs, PAGE_SIZE) - 1, (uint64_t)m_outputs.size());
+		if (first > last)
+		{
+			return std::make_unique<OutputRange>(m_outputs.size(), 0, std::vector<OutputDTO>());
+		}
+
+		std::vector<OutputDTO> outputs(m_outputs.cbegin() + (first - 1), m_outputs.cbegin() + last);
+		return std::make_unique<OutputRange>(m_outputs.size(), last, std::move(outputs));
+	}
+
+private:
+	std::vector<OutputDTO> m_outputs;
+};
+
+// Only tracks the restore leaf index.
+class RestoreLeafWalletDB : public IWalletDB
+{
+public:
+	RestoreLeafWalletDB(const uint64_t restoreLeafIndex) : m_restoreLeafIndex(restoreLeafIndex) { }
+
+	void Commit() final { }
+	void Rollback() noexcept final { }
+
+	KeyChainPath GetNextChildPath(const KeyChainPath& parentPath) final { return parentPath.GetFirstChild(); }
+	std::unique_ptr<Slate> LoadSlate(const SecureVector&, const uuids::uuid&, const SlateStage&) const final { return nullptr; }
+	void SaveSlate(const SecureVector&, const Slate&) final { }
+	std::unique_ptr<SlateContextEntity> LoadSlateContext(const SecureVector&, const uuids::uuid&) const final { return nullptr; }
+	void SaveSlateContext(const SecureVector&, const uuids::uuid&, const SlateContextEntity&) final { }
+	void AddOutputs(const SecureVector&, const std::vector<OutputDataEntity>&) final { }
+	std::vector<OutputDataEntity> GetOutputs(const SecureVector&) const final { return {}; }
+	void AddTransaction(const SecureVector&, const WalletTx&) final { }
+	std::vector<WalletTx> GetTransactions(const SecureVector&) const final { return {}; }
+	std::unique_ptr<WalletTx> GetTransactionById(const SecureVector&, const uint32_t) const final { return nullptr; }
+	uint32_t GetNextTransactionId() final { return 0; }
+	uint64_t GetRefreshBlockHeight() const final { return 0; }
+	void UpdateRefreshBlockHeight(const uint64_t) final { }
+
+	uint64_t GetRestoreLeafIndex() const final { return m_restoreLeafIndex; }
+	void UpdateRestoreLeafIndex(const uint64_t lastLeafIndex) final { m_restoreLeafIndex = lastLeafIndex; }
+
+private:
+	uint64_t m_restoreLeafIndex;
+};
+
+static OutputDTO CreateOutput(const KeyChain& keyChain, const uint64_t leafIndex)
+{
+	const KeyChainPath keyId(std::vector<uint32_t>({ 1, 2, (uint32_t)leafIndex }));
+	const SecretKey blindingFactor = keyChain.DerivePrivateKey(keyId, leafIndex);
+	Commitment commitment = Crypto::CommitBlinded(leafIndex, BlindingFactor(blindingFactor.GetBytes()));
+	RangeProof rangeProof = keyChain.GenerateRangeProof(keyId, leafIndex, commitment, blindingFactor, EBulletproofType::ENHANCED);
+
+	return OutputDTO(
+		false,
+		OutputIdentifier(EOutputFeatures::DEFAULT, std::move(commitment)),
+		OutputLocation(leafIndex * 2, leafIndex),
+		std::move(rangeProof)
+	);
+}
+
+TEST_CASE("OutputRestorer::FindAndRewindOutputs - Multiple pages")
+{
+	ConfigPtr pConfig = ConfigLoader().Load(EEnvironmentType::MAINNET);
+	KeyChain keyChain = KeyChain::FromRandom(*pConfig);
+	KeyChain otherKeyChain = KeyChain::FromRandom(*pConfig);
+
+	// Spans 3 pages, with owned outputs on both sides of each page boundary.
+	const uint64_t numOutputs = 150;
+	const std::vector<uint64_t> ownedLeaves({ 5, 59, 60, 61, 100, 150 });
+
+	const OutputDTO otherOutput = CreateOutput(otherKeyChain, 1);
+	std::vector<OutputDTO> outputs(numOutputs, otherOutput);
+	for (const uint64_t leafIndex : ownedLeaves)
+	{
+		outputs[leafIndex - 1] = CreateOutput(keyChain, leafIndex);
+	}
+
+	OutputRestorer restorer(*pConfig, std::make_shared<PagedNodeClient>(std::move(outputs)), keyChain);
+
+	SECTION("From genesis")
+	{
+		auto pWalletDB = std::make_shared<RestoreLeafWalletDB>(0);
+		std::vector<OutputDataEntity> found = restorer.FindAndRewindOutputs(pWalletDB, true);
+
+		REQUIRE(found.size() == ownedLeaves.size());
+		for (size_t i = 0; i < ownedLeaves.size(); i++)
+		{
+			REQUIRE(found[i].GetAmount() == ownedLeaves[i]);
+			REQUIRE(found[i].GetMMRIndex() == std::make_optional(ownedLeaves[i] * 2));
+		}
+
+		REQUIRE(pWalletDB->GetRestoreLeafIndex() == numOutputs);
+	}
+
+	SECTION("From last restore")
+	{
+		auto pWalletDB = std::make_shared<RestoreLeafWalletDB>(PagedNodeClient::PAGE_SIZE);
+		std::vector<OutputDataEntity> found = restorer.FindAndRewindOutputs(pWalletDB, false);
+
+		REQUIRE(found.size() == 3);
+		REQUIRE(found[0].GetAmount() == 61);
+		REQUIRE(found[1].GetAmount() == 100);
+		REQUIRE(found[2].GetAmount() == 150);
+		REQUIRE(pWalletDB->GetRestoreLeafIndex() == numOutputs);
+	}
+
+	SECTION("Nothing new")
+	{
+		auto pWalletDB = std::make_shared<RestoreLeafWalletDB>(numOutputs);
+		REQUIRE(restorer.FindAndRewindOutputs(pWalletDB, false).empty());
+		REQUIRE(pWalletDB->GetRestoreLeafIndex() == numOutputs);
+	}
+}
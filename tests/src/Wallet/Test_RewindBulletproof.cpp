@@ -50,4 +50,30 @@ TEST_CASE("REWIND_BULLETPROOF_ENHANCED")
 	REQUIRE(pRewoundProof != nullptr);
 	REQUIRE(amount == pRewoundProof->GetAmount());
 	REQUIRE(keyId.GetKeyIndices() == pRewoundProof->GetProofMessage().ToKeyIndices(EBulletproofType::ENHANCED));
-}
\ No newline at end of file
+}
+
+TEST_CASE("REWIND_BULLETPROOF_OTHER_WALLET")
+{
+	ConfigPtr pConfig = ConfigLoader().Load(EEnvironmentType::MAINNET);
+
+	const CBigInteger<32> masterSeed = CSPRNG::GenerateRandom32();
+	const SecureVector masterSeedBytes(masterSeed.GetData().begin(), masterSeed.GetData().end());
+	const uint64_t amount = 45;
+	KeyChainPath keyId(std::vector<uint32_t>({ 1, 2, 3 }));
+
+	KeyChain keyChain = KeyChain::FromSeed(*pConfig, masterSeedBytes);
+	KeyChain otherKeyChain = KeyChain::FromRandom(*pConfig);
+	SecretKey blindingFactor = keyChain.DerivePrivateKey(keyId, amount);
+	Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blindingFactor.GetBytes()));
+
+	for (const EBulletproofType type : { EBulletproofType::ORIGINAL, EBulletproofType::ENHANCED })
+	{
+		RangeProof rangeProof = keyChain.GenerateRangeProof(keyId, amount, commitment, blindingFactor, type);
+		REQUIRE(otherKeyChain.RewindRangeProof(commitment, rangeProof, type) == nullptr);
+
+		// Proofs that aren't the size of a single bulletproof are rejected without rewinding.
+		std::vector<unsigned char> truncatedBytes = rangeProof.GetProofBytes();
+		truncatedBytes.pop_back();
+		REQUIRE(keyChain.RewindRangeProof(commitment, RangeProof(std::move(truncatedBytes)), type) == nullptr);
+	}
+}